@@ -27,9 +27,60 @@
 // ========================================================================== //
 
 // Standard headers
+#include <stddef.h>
 #include <string.h>
 #include <memory.h>
 #include <malloc.h>
+#include <stdio.h>
+
+// SSE2 intrinsics for probing hash table control bytes
+#if defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define ALF_COLLECTION_SSE2
+#	include <emmintrin.h>
+#endif
+
+// Prefetch intrinsics
+#if defined(__GNUC__) || defined(__clang__)
+#	define ALF_COLLECTION_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(ALF_COLLECTION_SSE2)
+#	define ALF_COLLECTION_PREFETCH(address) \
+		_mm_prefetch((const char*)(address), _MM_HINT_T0)
+#else
+#	define ALF_COLLECTION_PREFETCH(address) ((void)(address))
+#endif
+
+// Bit scanning intrinsics
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+// Thread library for concurrent collections
+#if defined(ALF_COLLECTION_USE_THREAD)
+#	include "alf_thread.h"
+#endif
+
+// Clock for timing hash table resizes
+#if defined(ALF_COLLECTION_STATISTICS)
+#	include <time.h>
+#endif
+
+// Memory mapping of hash table snapshots and huge page buckets
+#if defined(_WIN32) || defined(_WIN64)
+#	define ALF_COLLECTION_TARGET_WINDOWS
+#	if !defined(WIN32_LEAN_AND_MEAN)
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <Windows.h>
+#else
+#	include <sys/mman.h>
+#	if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#		define MAP_ANONYMOUS MAP_ANON
+#	endif
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
 
 // ========================================================================== //
 // Macro Declarations
@@ -41,1291 +92,8666 @@
 // -------------------------------------------------------------------------- //
 
 /** Macro that returns minimum of two number **/
-#define ALF_COLLECTION_MIN(a, b) a < b ? a : b
+#define ALF_COLLECTION_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// -------------------------------------------------------------------------- //
+
+/** Macro that returns maximum of two number **/
+#define ALF_COLLECTION_MAX(a, b) ((a) > (b) ? (a) : (b))
 
 // ========================================================================== //
-// Private Functions
+// Private Bit Functions
 // ========================================================================== //
 
-/** Default destructor function **/
-void alfDefaultDestructor(void* object) { }
+/** Returns the index of the lowest set bit. The value must not be zero **/
+static uint32_t alfCountTrailingZeros32(uint32_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return (uint32_t)index;
+#else
+	return (uint32_t)__builtin_ctz(value);
+#endif
+}
 
 // -------------------------------------------------------------------------- //
 
-/** Default cleaner function **/
-void alfDefaultCleaner(const void* object) { }
+/** Returns the index of the lowest set bit of a 64-bit value. The value must 
+ * not be zero **/
+static uint32_t alfCountTrailingZeros64(uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return (uint32_t)index;
+#elif defined(_MSC_VER)
+	const uint32_t low = (uint32_t)value;
+	return low ? alfCountTrailingZeros32(low) : 
+		32 + alfCountTrailingZeros32((uint32_t)(value >> 32));
+#else
+	return (uint32_t)__builtin_ctzll(value);
+#endif
+}
 
 // ========================================================================== //
-// List Structures
+// Private Hash Functions
 // ========================================================================== //
 
-typedef struct tag_AlfList
+/** Constants of the built-in hash **/
+#define ALF_HASH_SECRET_0 0xa0761d6478bd642full
+#define ALF_HASH_SECRET_1 0xe7037ed1a0b428dbull
+#define ALF_HASH_SECRET_2 0x8ebc6af09c88c6e3ull
+#define ALF_HASH_SECRET_3 0x589965cc75374cc3ull
+
+// -------------------------------------------------------------------------- //
+
+/** Multiply two 64-bit numbers into a 128-bit product. The low half of the 
+ * product is written to 'a' and the high half to 'b' **/
+static void alfHashMultiply(uint64_t* a, uint64_t* b)
 {
-	/** Capacity **/
-	uint64_t capacity;
-	/** Size **/
-	uint64_t size;
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t product = (__uint128_t)*a * *b;
+	*a = (uint64_t)product;
+	*b = (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	*a = _umul128(*a, *b, b);
+#else
+	const uint64_t aHigh = *a >> 32, aLow = (uint32_t)*a;
+	const uint64_t bHigh = *b >> 32, bLow = (uint32_t)*b;
+	const uint64_t hh = aHigh * bHigh, hl = aHigh * bLow;
+	const uint64_t lh = aLow * bHigh, ll = aLow * bLow;
+	const uint64_t t = ll + (hl << 32);
+	const uint64_t low = t + (lh << 32);
+	const uint64_t carry = (t < ll) + (low < t);
+	*a = low;
+	*b = hh + (hl >> 32) + (lh >> 32) + carry;
+#endif
+}
 
-	/** Data buffer **/
-	void** buffer;
+// -------------------------------------------------------------------------- //
 
-	/** Destructor **/
-	PFN_AlfCollectionDestructor destructor;
-} tag_AlfList;
+/** Multiply two 64-bit numbers and fold the 128-bit product to 64 bits **/
+static uint64_t alfHashMix(uint64_t a, uint64_t b)
+{
+	alfHashMultiply(&a, &b);
+	return a ^ b;
+}
 
-// ========================================================================== //
-// List Functions
-// ========================================================================== //
+// -------------------------------------------------------------------------- //
 
-AlfList* alfCreateList(const AlfListDesc* desc)
+/** Read 8 bytes from unaligned memory **/
+static uint64_t alfHashRead64(const uint8_t* data)
 {
-	AlfList* list = ALF_COLLECTION_ALLOC(sizeof(AlfList));
-	if (!list) { return NULL; }
+	uint64_t value;
+	memcpy(&value, data, sizeof(uint64_t));
+	return value;
+}
 
-	list->capacity =
-		desc->capacity ? desc->capacity : ALF_LIST_DEFAULT_CAPACITY;
-	list->size = 0;
-	list->destructor = 
-		desc->destructor ? desc->destructor : alfDefaultDestructor;
+// -------------------------------------------------------------------------- //
 
-	list->buffer = 
-		(void**)ALF_COLLECTION_ALLOC(sizeof(void*) * list->capacity);
-	if (!list->buffer)
+/** Read 4 bytes from unaligned memory **/
+static uint64_t alfHashRead32(const uint8_t* data)
+{
+	uint32_t value;
+	memcpy(&value, data, sizeof(uint32_t));
+	return value;
+}
+
+// ========================================================================== //
+// Hash Functions
+// ========================================================================== //
+
+uint64_t alfHash64(const void* data, uint64_t size, uint64_t seed)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+	seed ^= alfHashMix(seed ^ ALF_HASH_SECRET_0, ALF_HASH_SECRET_1);
+	uint64_t a, b;
+	if (size <= 16)
 	{
-		ALF_COLLECTION_FREE(list);
-		return NULL;
+		// Small inputs are read as overlapping words
+		if (size >= 4)
+		{
+			const uint64_t offset = (size >> 3) << 2;
+			a = (alfHashRead32(bytes) << 32) | alfHashRead32(bytes + offset);
+			b = (alfHashRead32(bytes + size - 4) << 32) | 
+				alfHashRead32(bytes + size - 4 - offset);
+		}
+		else if (size > 0)
+		{
+			a = ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[size >> 1] << 8) |
+				bytes[size - 1];
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+	else
+	{
+		// Large inputs are processed 48 bytes at a time in three independent
+		// lanes, and then 16 bytes at a time
+		uint64_t left = size;
+		if (left > 48)
+		{
+			uint64_t seed1 = seed, seed2 = seed;
+			do
+			{
+				seed = alfHashMix(alfHashRead64(bytes) ^ ALF_HASH_SECRET_1, 
+					alfHashRead64(bytes + 8) ^ seed);
+				seed1 = alfHashMix(alfHashRead64(bytes + 16) ^ ALF_HASH_SECRET_2,
+					alfHashRead64(bytes + 24) ^ seed1);
+				seed2 = alfHashMix(alfHashRead64(bytes + 32) ^ ALF_HASH_SECRET_3,
+					alfHashRead64(bytes + 40) ^ seed2);
+				bytes += 48;
+				left -= 48;
+			} while (left > 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while (left > 16)
+		{
+			seed = alfHashMix(alfHashRead64(bytes) ^ ALF_HASH_SECRET_1, 
+				alfHashRead64(bytes + 8) ^ seed);
+			bytes += 16;
+			left -= 16;
+		}
+		a = alfHashRead64(bytes + left - 16);
+		b = alfHashRead64(bytes + left - 8);
 	}
 
-	return list;
+	// Finalize
+	a ^= ALF_HASH_SECRET_1;
+	b ^= seed;
+	alfHashMultiply(&a, &b);
+	return alfHashMix(a ^ ALF_HASH_SECRET_0 ^ size, b ^ ALF_HASH_SECRET_1);
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfList* alfCreateListSimple()
+uint32_t alfHash32(const void* data, uint64_t size, uint64_t seed)
 {
-	AlfListDesc desc = { 0 };
-	return alfCreateList(&desc);
+	const uint64_t hash = alfHash64(data, size, seed);
+	return (uint32_t)(hash ^ (hash >> 32));
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfDestroyList(AlfList* list)
+uint64_t alfHashString64(const void* string)
 {
-	for (uint64_t i = 0; i < list->size; i++)
-	{
-		list->destructor(list->buffer[i]);
-	}
+	return alfHash64(string, strlen((const char*)string), 0);
+}
 
-	ALF_COLLECTION_FREE(list->buffer);
-	ALF_COLLECTION_FREE(list);
+// -------------------------------------------------------------------------- //
+
+uint32_t alfHashString(const void* string)
+{
+	return alfHash32(string, strlen((const char*)string), 0);
 }
 
+// ========================================================================== //
+// Private Functions
+// ========================================================================== //
+
+/** Default destructor function **/
+void alfDefaultDestructor(void* object) { }
+
 // -------------------------------------------------------------------------- //
 
-void alfListAdd(AlfList* list, void* object)
+/** Default cleaner function **/
+void alfDefaultCleaner(const void* object) { }
+
+// ========================================================================== //
+// Allocator Structures
+// ========================================================================== //
+
+/** Alignment of the memory that the built-in allocators return **/
+#define ALF_ALLOCATOR_ALIGNMENT 16ull
+
+// -------------------------------------------------------------------------- //
+
+/** Round a size up to the alignment of the built-in allocators **/
+#define ALF_ALLOCATOR_ALIGN(size) \
+	(((size) + (ALF_ALLOCATOR_ALIGNMENT - 1)) & ~(ALF_ALLOCATOR_ALIGNMENT - 1))
+
+// -------------------------------------------------------------------------- //
+
+/** Default size of the blocks of an arena allocator **/
+#define ALF_ARENA_ALLOCATOR_DEFAULT_BLOCK_SIZE (64ull << 10)
+
+// -------------------------------------------------------------------------- //
+
+/** Default number of objects in each block of a pool allocator **/
+#define ALF_POOL_ALLOCATOR_DEFAULT_OBJECTS_PER_BLOCK 64
+
+// -------------------------------------------------------------------------- //
+
+/** Block of an arena allocator. The memory of the block follows directly after
+ * the header, which is sized to keep the memory aligned **/
+typedef struct AlfArenaAllocatorBlock
 {
-	if (list->size >= list->capacity)
-	{
-		alfListReserve(list, list->capacity * 2);
-	}
-	list->buffer[list->size++] = object;
+	/** Block that was allocated before this one **/
+	struct AlfArenaAllocatorBlock* previous;
+	/** Size of the memory in bytes **/
+	uint64_t capacity;
+	/** Number of bytes that have been handed out **/
+	uint64_t offset;
+	/** Padding up to the alignment **/
+	uint64_t padding;
+} AlfArenaAllocatorBlock;
+
+// -------------------------------------------------------------------------- //
+
+typedef struct tag_AlfArenaAllocator
+{
+	/** Allocator of blocks **/
+	AlfAllocator parent;
+	/** Size of each block **/
+	uint64_t blockSize;
+	/** Block that is allocated from **/
+	AlfArenaAllocatorBlock* block;
+	/** Latest allocation, which can be grown and freed in place **/
+	uint8_t* last;
+} tag_AlfArenaAllocator;
+
+// -------------------------------------------------------------------------- //
+
+typedef struct tag_AlfPoolAllocator
+{
+	/** Allocator of blocks and large allocations **/
+	AlfAllocator parent;
+	/** Size of each object, rounded up to the alignment **/
+	uint64_t objectSize;
+	/** Number of objects in each block **/
+	uint32_t objectsPerBlock;
+	/** Free objects, linked through their first bytes **/
+	void* freeList;
+	/** Blocks of objects, linked through their first bytes **/
+	void* blocks;
+} tag_AlfPoolAllocator;
+
+// -------------------------------------------------------------------------- //
+
+typedef struct tag_AlfCountingAllocator
+{
+	/** Allocator that calls are passed on to **/
+	AlfAllocator parent;
+	/** Counters **/
+	AlfAllocatorStatistics statistics;
+} tag_AlfCountingAllocator;
+
+// ========================================================================== //
+// Allocator Private Functions
+// ========================================================================== //
+
+/** Returns a copy of an allocator, or the default allocator if NULL **/
+static AlfAllocator alfAllocatorOrDefault(const AlfAllocator* allocator)
+{
+	if (allocator) { return *allocator; }
+	const AlfAllocator defaultAllocator = { NULL, NULL, NULL, NULL };
+	return defaultAllocator;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfListPrepend(AlfList* list, void* object)
+/** Allocate memory with an allocator **/
+static void* alfAllocatorAlloc(const AlfAllocator* allocator, uint64_t size)
 {
-	if (list->size >= list->capacity)
-	{
-		alfListReserve(list, list->capacity * 2);
-	}
-	memmove(list->buffer + 1, list->buffer, sizeof(void*) * list->size);
-	list->buffer[0] = object;
-	list->size++;
+	if (!allocator->alloc) { return ALF_COLLECTION_ALLOC((size_t)size); }
+	return allocator->alloc(allocator->user, size);
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfListInsert(AlfList* list, void* object, uint64_t index)
+/** Free memory of an allocator. The size must be the size that the memory was
+ * allocated with **/
+static void alfAllocatorFree(
+	const AlfAllocator* allocator, 
+	void* memory, 
+	uint64_t size)
 {
-	if (index == 0)
+	if (!memory) { return; }
+	if (!allocator->alloc)
 	{
-		alfListPrepend(list, object);
-		return;
+		ALF_COLLECTION_FREE(memory);
 	}
-
-	if (index >= list->size)
+	else if (allocator->free)
 	{
-		alfListAdd(list, object);
+		allocator->free(allocator->user, memory, size);
 	}
+}
 
-	if (list->size >= list->capacity)
+// -------------------------------------------------------------------------- //
+
+/** Resize memory of an allocator. Allocators without a reallocation function
+ * allocate new memory, copy the contents and free the old memory. Returns NULL
+ * on failure, in which case the memory is left unchanged **/
+static void* alfAllocatorRealloc(
+	const AlfAllocator* allocator, 
+	void* memory, 
+	uint64_t oldSize, 
+	uint64_t size)
+{
+	if (!memory) { return alfAllocatorAlloc(allocator, size); }
+	if (allocator->alloc && allocator->realloc)
 	{
-		alfListReserve(list, list->capacity * 2);
+		return allocator->realloc(allocator->user, memory, oldSize, size);
+	}
+#if defined(ALF_COLLECTION_REALLOC)
+	if (!allocator->alloc) 
+	{ 
+		return ALF_COLLECTION_REALLOC(memory, (size_t)size); 
 	}
+#endif
 
-	memmove(
-		list->buffer + index + 1, 
-		list->buffer + index, 
-		sizeof(void*) * (list->size - index)
-	);
-	list->buffer[index] = object;
-	list->size++;
+	void* resized = alfAllocatorAlloc(allocator, size);
+	if (!resized) { return NULL; }
+	memcpy(resized, memory, (size_t)ALF_COLLECTION_MIN(oldSize, size));
+	alfAllocatorFree(allocator, memory, oldSize);
+	return resized;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfListRemove(AlfList* list, uint64_t index)
+/** Returns the memory of an arena allocator block **/
+static uint8_t* alfArenaAllocatorGetBlockData(AlfArenaAllocatorBlock* block)
 {
-	if (index >= list->size) { return NULL; }
-	void* object = alfListGet(list, index);
+	return (uint8_t*)(block + 1);
+}
 
-	memmove(
-		list->buffer + index, 
-		list->buffer + index + 1, 
-		sizeof(void*) * (list->size - index - 1)
-	);
-	list->size--;
-	return object;
+// -------------------------------------------------------------------------- //
+
+/** Arena allocator allocation function **/
+static void* alfArenaAllocatorAlloc(void* user, uint64_t size)
+{
+	AlfArenaAllocator* arena = (AlfArenaAllocator*)user;
+	size = ALF_ALLOCATOR_ALIGN(size);
+
+	// Allocate a new block when the current one is full
+	AlfArenaAllocatorBlock* block = arena->block;
+	if (!block || block->capacity - block->offset < size)
+	{
+		const uint64_t capacity = 
+			size > arena->blockSize ? size : arena->blockSize;
+		block = alfAllocatorAlloc(
+			&arena->parent, sizeof(AlfArenaAllocatorBlock) + capacity);
+		if (!block) { return NULL; }
+		block->previous = arena->block;
+		block->capacity = capacity;
+		block->offset = 0;
+		arena->block = block;
+	}
+
+	uint8_t* memory = alfArenaAllocatorGetBlockData(block) + block->offset;
+	block->offset += size;
+	arena->last = memory;
+	return memory;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfListRemoveObject(AlfList* list, const void* object)
+/** Arena allocator reallocation function. The latest allocation is resized in
+ * place while it fits in its block **/
+static void* alfArenaAllocatorRealloc(
+	void* user, 
+	void* memory, 
+	uint64_t oldSize, 
+	uint64_t size)
 {
-	for (uint64_t i = 0; i < list->size; i++)
+	AlfArenaAllocator* arena = (AlfArenaAllocator*)user;
+	if (memory == arena->last)
 	{
-		void* listObject = list->buffer[i];
-		if (listObject == object)
+		AlfArenaAllocatorBlock* block = arena->block;
+		const uint64_t start = 
+			(uint64_t)(arena->last - alfArenaAllocatorGetBlockData(block));
+		if (ALF_ALLOCATOR_ALIGN(size) <= block->capacity - start)
 		{
-			return alfListRemove(list, i);
+			block->offset = start + ALF_ALLOCATOR_ALIGN(size);
+			return memory;
 		}
 	}
-	return NULL;
+	else if (size <= oldSize)
+	{
+		return memory;
+	}
+
+	void* resized = alfArenaAllocatorAlloc(user, size);
+	if (!resized) { return NULL; }
+	memcpy(resized, memory, (size_t)ALF_COLLECTION_MIN(oldSize, size));
+	return resized;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfListRemoveObjectEqual(AlfList* list, const void* object, PFN_AlfCollectionEqual equalsFunction)
+/** Arena allocator free function. Only the latest allocation is returned to 
+ * the arena **/
+static void alfArenaAllocatorFree(void* user, void* memory, uint64_t size)
 {
-	for (uint64_t i = 0; i < list->size; i++)
+	(void)size;
+	AlfArenaAllocator* arena = (AlfArenaAllocator*)user;
+	if (memory == arena->last)
 	{
-		void* listObject = list->buffer[i];
-		if (equalsFunction(listObject, object))
-		{
-			return alfListRemove(list, i);
-		}
+		arena->block->offset = (uint64_t)(
+			arena->last - alfArenaAllocatorGetBlockData(arena->block));
+		arena->last = NULL;
 	}
-	return NULL;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfListGet(AlfList* list, uint64_t index)
+/** Returns the size in bytes of a block of a pool allocator **/
+static uint64_t alfPoolAllocatorBlockSize(const AlfPoolAllocator* pool)
 {
-	ALF_COLLECTION_ASSERT(
-		index >= 0 && index < list->size,
-		"Index out of bounds: %u (0 - %u)", 
-		index, list->size
-	);
-	return list->buffer[index];
+	return ALF_ALLOCATOR_ALIGNMENT + pool->objectSize * pool->objectsPerBlock;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfListGetObject(
-	AlfList* list, 
-	void* object, 
-	PFN_AlfCollectionEqual equalsFunction)
+/** Pool allocator allocation function **/
+static void* alfPoolAllocatorAlloc(void* user, uint64_t size)
 {
-	for (uint64_t i = 0; i < list->size; i++)
+	AlfPoolAllocator* pool = (AlfPoolAllocator*)user;
+	if (size > pool->objectSize)
 	{
-		void* listObject = list->buffer[i];
-		if (equalsFunction(listObject, object))
+		return alfAllocatorAlloc(&pool->parent, size);
+	}
+
+	// Allocate a new block and add its objects to the free list
+	if (!pool->freeList)
+	{
+		uint8_t* block = 
+			alfAllocatorAlloc(&pool->parent, alfPoolAllocatorBlockSize(pool));
+		if (!block) { return NULL; }
+		*(void**)block = pool->blocks;
+		pool->blocks = block;
+		for (uint32_t i = pool->objectsPerBlock; i > 0; i--)
 		{
-			return alfListGet(list, i);
+			void* object = 
+				block + ALF_ALLOCATOR_ALIGNMENT + pool->objectSize * (i - 1);
+			*(void**)object = pool->freeList;
+			pool->freeList = object;
 		}
 	}
-	return NULL;
+
+	void* object = pool->freeList;
+	pool->freeList = *(void**)object;
+	return object;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfListResize(AlfList* list, uint64_t size)
+/** Pool allocator free function **/
+static void alfPoolAllocatorFree(void* user, void* memory, uint64_t size)
 {
-	if (size > list->capacity)
+	AlfPoolAllocator* pool = (AlfPoolAllocator*)user;
+	if (size > pool->objectSize)
 	{
-		alfListReserve(list, size);
+		alfAllocatorFree(&pool->parent, memory, size);
+		return;
 	}
-	list->size = size;
+	*(void**)memory = pool->freeList;
+	pool->freeList = memory;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfListReserve(AlfList* list, uint64_t capacity)
+/** Pool allocator reallocation function. Objects are resized in place while 
+ * they fit in the object size **/
+static void* alfPoolAllocatorRealloc(
+	void* user, 
+	void* memory, 
+	uint64_t oldSize, 
+	uint64_t size)
 {
-	if (capacity < list->capacity) { return; }
+	AlfPoolAllocator* pool = (AlfPoolAllocator*)user;
+	if (oldSize <= pool->objectSize && size <= pool->objectSize)
+	{
+		return memory;
+	}
+	if (oldSize > pool->objectSize && size > pool->objectSize)
+	{
+		return alfAllocatorRealloc(&pool->parent, memory, oldSize, size);
+	}
 
-	void** buffer = (void**)ALF_COLLECTION_ALLOC(
-		sizeof(void*) * capacity
-	);
-	memcpy(buffer, list->buffer, sizeof(void*) * list->capacity);
-	ALF_COLLECTION_FREE(list->buffer);
-	list->capacity = capacity;
-	list->buffer = buffer;
+	void* resized = alfPoolAllocatorAlloc(user, size);
+	if (!resized) { return NULL; }
+	memcpy(resized, memory, (size_t)ALF_COLLECTION_MIN(oldSize, size));
+	alfPoolAllocatorFree(user, memory, oldSize);
+	return resized;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfListShrink(AlfList* list, uint64_t capacity)
+/** Update the byte counters of a counting allocator **/
+static void alfCountingAllocatorCount(
+	AlfCountingAllocator* counting, 
+	uint64_t freedSize, 
+	uint64_t allocatedSize)
 {
-	if (capacity > list->capacity) { return; }
-
-	void** buffer = (void**)ALF_COLLECTION_ALLOC(
-		sizeof(void*) * capacity
-	);
-	memcpy(buffer, list->buffer, sizeof(void*) * capacity);
-	for (uint64_t i = capacity; i < list->size; i++)
+	AlfAllocatorStatistics* statistics = &counting->statistics;
+	statistics->currentBytes += allocatedSize - freedSize;
+	statistics->totalBytes += allocatedSize;
+	if (statistics->currentBytes > statistics->peakBytes)
 	{
-		list->destructor(list->buffer[i]);
+		statistics->peakBytes = statistics->currentBytes;
 	}
-	ALF_COLLECTION_FREE(list->buffer);
-	list->capacity = capacity;
-	list->buffer = buffer;
-	list->size = ALF_COLLECTION_MIN(list->capacity, list->size);
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfListShrinkToFit(AlfList* list)
+/** Counting allocator allocation function **/
+static void* alfCountingAllocatorAlloc(void* user, uint64_t size)
 {
-	alfListShrink(list, list->size);
+	AlfCountingAllocator* counting = (AlfCountingAllocator*)user;
+	void* memory = alfAllocatorAlloc(&counting->parent, size);
+	if (memory)
+	{
+		counting->statistics.allocationCount++;
+		alfCountingAllocatorCount(counting, 0, size);
+	}
+	return memory;
 }
 
 // -------------------------------------------------------------------------- //
 
-uint64_t alfGetListSize(AlfList* list)
+/** Counting allocator reallocation function **/
+static void* alfCountingAllocatorRealloc(
+	void* user, 
+	void* memory, 
+	uint64_t oldSize, 
+	uint64_t size)
 {
-	return list->size;
+	AlfCountingAllocator* counting = (AlfCountingAllocator*)user;
+	void* resized = 
+		alfAllocatorRealloc(&counting->parent, memory, oldSize, size);
+	if (resized)
+	{
+		counting->statistics.reallocationCount++;
+		alfCountingAllocatorCount(counting, oldSize, size);
+	}
+	return resized;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfGetListData(AlfList* list)
+/** Counting allocator free function **/
+static void alfCountingAllocatorFree(void* user, void* memory, uint64_t size)
 {
-	return list->buffer;
+	AlfCountingAllocator* counting = (AlfCountingAllocator*)user;
+	alfAllocatorFree(&counting->parent, memory, size);
+	counting->statistics.freeCount++;
+	alfCountingAllocatorCount(counting, size, 0);
 }
 
 // ========================================================================== //
-// ArrayList Structures
+// Allocator Functions
 // ========================================================================== //
 
-typedef struct tag_AlfArrayList
+AlfArenaAllocator* alfCreateArenaAllocator(
+	const AlfAllocator* parent, 
+	uint64_t blockSize)
 {
-	/** Size of each object in list **/
-	uint32_t objectSize;
-	/** Initial capacity **/
-	uint64_t capacity;
-	/** List size **/
-	uint64_t size;
+	const AlfAllocator parentAllocator = alfAllocatorOrDefault(parent);
+	AlfArenaAllocator* arena = 
+		alfAllocatorAlloc(&parentAllocator, sizeof(AlfArenaAllocator));
+	if (!arena) { return NULL; }
+
+	arena->parent = parentAllocator;
+	arena->blockSize = blockSize ? 
+		ALF_ALLOCATOR_ALIGN(blockSize) : ALF_ARENA_ALLOCATOR_DEFAULT_BLOCK_SIZE;
+	arena->block = NULL;
+	arena->last = NULL;
+	return arena;
+}
 
-	/** Buffer **/
-	uint8_t* buffer;
+// -------------------------------------------------------------------------- //
 
-	/** Destructor function **/
-	PFN_AlfCollectionCleaner cleaner;
-} tag_AlfArrayList;
+void alfDestroyArenaAllocator(AlfArenaAllocator* arena)
+{
+	const AlfAllocator parent = arena->parent;
+	alfArenaAllocatorReset(arena);
+	if (arena->block)
+	{
+		alfAllocatorFree(&parent, arena->block, 
+			sizeof(AlfArenaAllocatorBlock) + arena->block->capacity);
+	}
+	alfAllocatorFree(&parent, arena, sizeof(AlfArenaAllocator));
+}
 
-// ========================================================================== //
-// ArrayList Private Functions
-// ========================================================================== //
+// -------------------------------------------------------------------------- //
 
-AlfBool alfSetupArrayList(AlfArrayList* list, const AlfArrayListDesc* desc)
+void alfArenaAllocatorReset(AlfArenaAllocator* arena)
 {
-	list->objectSize = desc->objectSize;
-	list->capacity =
-		desc->capacity ? desc->capacity : ALF_LIST_DEFAULT_CAPACITY;
-	list->size = 0;
-	list->cleaner = desc->cleaner ? desc->cleaner : alfDefaultCleaner;
-
-	list->buffer = ALF_COLLECTION_ALLOC(list->capacity * list->objectSize);
-	if (!list->buffer)
+	AlfArenaAllocatorBlock* block = arena->block;
+	while (block && block->previous)
 	{
-		ALF_COLLECTION_FREE(list);
-		return ALF_FALSE;
+		AlfArenaAllocatorBlock* previous = block->previous;
+		alfAllocatorFree(&arena->parent, block, 
+			sizeof(AlfArenaAllocatorBlock) + block->capacity);
+		block = previous;
 	}
-	return ALF_TRUE;
+	if (block) { block->offset = 0; }
+	arena->block = block;
+	arena->last = NULL;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfCleanupArrayList(AlfArrayList* list)
+AlfAllocator alfArenaAllocatorGetAllocator(AlfArenaAllocator* arena)
 {
-	for (uint64_t i = 0; i < list->size; i++)
+	AlfAllocator allocator;
+	allocator.alloc = alfArenaAllocatorAlloc;
+	allocator.realloc = alfArenaAllocatorRealloc;
+	allocator.free = alfArenaAllocatorFree;
+	allocator.user = arena;
+	return allocator;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfPoolAllocator* alfCreatePoolAllocator(
+	const AlfAllocator* parent, 
+	uint64_t objectSize,
+	uint32_t objectsPerBlock)
+{
+	ALF_COLLECTION_ASSERT(
+		objectSize != 0, 
+		"Size of objects in pool allocator must be greater than zero"
+	);
+
+	const AlfAllocator parentAllocator = alfAllocatorOrDefault(parent);
+	AlfPoolAllocator* pool = 
+		alfAllocatorAlloc(&parentAllocator, sizeof(AlfPoolAllocator));
+	if (!pool) { return NULL; }
+
+	// Free objects must be able to hold the link to the next object
+	pool->parent = parentAllocator;
+	pool->objectSize = ALF_ALLOCATOR_ALIGN(
+		objectSize > sizeof(void*) ? objectSize : sizeof(void*));
+	pool->objectsPerBlock = objectsPerBlock ? 
+		objectsPerBlock : ALF_POOL_ALLOCATOR_DEFAULT_OBJECTS_PER_BLOCK;
+	pool->freeList = NULL;
+	pool->blocks = NULL;
+	return pool;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfDestroyPoolAllocator(AlfPoolAllocator* pool)
+{
+	const AlfAllocator parent = pool->parent;
+	void* block = pool->blocks;
+	while (block)
 	{
-		list->cleaner(alfArrayListGet(list, i));
+		void* next = *(void**)block;
+		alfAllocatorFree(&parent, block, alfPoolAllocatorBlockSize(pool));
+		block = next;
 	}
-	ALF_COLLECTION_FREE(list->buffer);
+	alfAllocatorFree(&parent, pool, sizeof(AlfPoolAllocator));
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Swap the two objects at the specified indices **/
-void alfArrayListSwapIndices(
-	AlfArrayList* list, 
-	uint32_t index0, 
-	uint32_t index1)
+AlfAllocator alfPoolAllocatorGetAllocator(AlfPoolAllocator* pool)
 {
-	if (index0 >= list->size || index1 >= list->size) { return; }
+	AlfAllocator allocator;
+	allocator.alloc = alfPoolAllocatorAlloc;
+	allocator.realloc = alfPoolAllocatorRealloc;
+	allocator.free = alfPoolAllocatorFree;
+	allocator.user = pool;
+	return allocator;
+}
+
+// -------------------------------------------------------------------------- //
 
-	void* object0 = alfArrayListGet(list, index0);
-	void* object1 = alfArrayListGet(list, index1);
-	void* temp = alloca(list->objectSize);
-	memcpy(temp, object0, list->objectSize);
-	memcpy(object0, object1, list->objectSize);
-	memcpy(object1, temp, list->objectSize);
+AlfCountingAllocator* alfCreateCountingAllocator(const AlfAllocator* parent)
+{
+	const AlfAllocator parentAllocator = alfAllocatorOrDefault(parent);
+	AlfCountingAllocator* counting = 
+		alfAllocatorAlloc(&parentAllocator, sizeof(AlfCountingAllocator));
+	if (!counting) { return NULL; }
+
+	counting->parent = parentAllocator;
+	memset(&counting->statistics, 0, sizeof(AlfAllocatorStatistics));
+	return counting;
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Perform quicksort from 'low' to 'high' index **/
-void alfArrayListQuickSort(
-	AlfArrayList* list,
-	PFN_AlfCollectionCompare compareFunction,
-	uint32_t low,
-	uint32_t high)
+void alfDestroyCountingAllocator(AlfCountingAllocator* counting)
 {
-	if (low < high)
-	{
-		void* pivot = alfArrayListGet(list, high);
-		uint32_t i = low;
-		for (uint32_t j = low; j < high; j++)
-		{
-			void* object = alfArrayListGet(list, j);
-			if (compareFunction(object, pivot) < 0)
-			{
-				alfArrayListSwapIndices(list, i, j);
-				i++;
-			}
-		}
-		alfArrayListSwapIndices(list, i, high);
+	const AlfAllocator parent = counting->parent;
+	alfAllocatorFree(&parent, counting, sizeof(AlfCountingAllocator));
+}
 
-		alfArrayListQuickSort(list, compareFunction, low, i - 1);
-		alfArrayListQuickSort(list, compareFunction, i + 1, high);
-	}
+// -------------------------------------------------------------------------- //
+
+AlfAllocator alfCountingAllocatorGetAllocator(AlfCountingAllocator* counting)
+{
+	AlfAllocator allocator;
+	allocator.alloc = alfCountingAllocatorAlloc;
+	allocator.realloc = alfCountingAllocatorRealloc;
+	allocator.free = alfCountingAllocatorFree;
+	allocator.user = counting;
+	return allocator;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfCountingAllocatorGetStatistics(
+	AlfCountingAllocator* counting,
+	AlfAllocatorStatistics* statisticsOut)
+{
+	*statisticsOut = counting->statistics;
 }
 
 // ========================================================================== //
-// ArrayList Functions
+// List Structures
 // ========================================================================== //
 
-AlfArrayList* alfCreateArrayList(const AlfArrayListDesc* desc)
+typedef struct tag_AlfList
 {
-	ALF_COLLECTION_ASSERT(
-		desc->objectSize != 0, 
-		"Size of objects in array-list must be greater than zero"
-	);
+	/** Capacity **/
+	uint64_t capacity;
+	/** Size **/
+	uint64_t size;
+
+	/** Data buffer **/
+	void** buffer;
+
+	/** Destructor **/
+	PFN_AlfCollectionDestructor destructor;
+
+	/** Allocator **/
+	AlfAllocator allocator;
+} tag_AlfList;
+
+// ========================================================================== //
+// List Functions
+// ========================================================================== //
 
-	AlfArrayList* list = ALF_COLLECTION_ALLOC(sizeof(AlfArrayList));
+AlfList* alfCreateList(const AlfListDesc* desc)
+{
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfList* list = alfAllocatorAlloc(&allocator, sizeof(AlfList));
 	if (!list) { return NULL; }
-	if (!alfSetupArrayList(list, desc))
+
+	list->allocator = allocator;
+	list->capacity =
+		desc->capacity ? desc->capacity : ALF_LIST_DEFAULT_CAPACITY;
+	list->size = 0;
+	list->destructor = 
+		desc->destructor ? desc->destructor : alfDefaultDestructor;
+
+	list->buffer = 
+		(void**)alfAllocatorAlloc(&allocator, sizeof(void*) * list->capacity);
+	if (!list->buffer)
 	{
+		alfAllocatorFree(&allocator, list, sizeof(AlfList));
 		return NULL;
 	}
+
 	return list;
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfArrayList* alfCreateArrayListForObjectSize(uint32_t objectSize, PFN_AlfCollectionCleaner cleaner)
+AlfList* alfCreateListSimple()
 {
-	AlfArrayListDesc desc = { 0 };
-	desc.objectSize = objectSize;
-	desc.cleaner = cleaner;
-	desc.capacity = ALF_LIST_DEFAULT_CAPACITY;
-	return alfCreateArrayList(&desc);
+	AlfListDesc desc = { 0 };
+	return alfCreateList(&desc);
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfDestroyArrayList(AlfArrayList* list)
+void alfDestroyList(AlfList* list)
 {
-	alfCleanupArrayList(list);
-	ALF_COLLECTION_FREE(list);
+	for (uint64_t i = 0; i < list->size; i++)
+	{
+		list->destructor(list->buffer[i]);
+	}
+
+	const AlfAllocator allocator = list->allocator;
+	alfAllocatorFree(&allocator, list->buffer, sizeof(void*) * list->capacity);
+	alfAllocatorFree(&allocator, list, sizeof(AlfList));
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListAdd(AlfArrayList* list, const void* object)
+void alfListAdd(AlfList* list, void* object)
 {
 	if (list->size >= list->capacity)
 	{
-		alfArrayListReserve(list, list->capacity * 2);
+		alfListReserve(list, list->capacity * 2);
 	}
-
-	memcpy(
-		list->buffer + (list->size++ * list->objectSize), 
-		object, 
-		list->objectSize
-	);
+	list->buffer[list->size++] = object;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListPrepend(AlfArrayList* list, const void* object)
+void alfListPrepend(AlfList* list, void* object)
 {
 	if (list->size >= list->capacity)
 	{
-		alfArrayListReserve(list, list->capacity * 2);
+		alfListReserve(list, list->capacity * 2);
 	}
-
-	memmove(
-		list->buffer + list->objectSize, 
-		list->buffer, 
-		list->size * list->objectSize
-	);
-	memcpy(list->buffer, object, list->objectSize);
+	memmove(list->buffer + 1, list->buffer, sizeof(void*) * list->size);
+	list->buffer[0] = object;
 	list->size++;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListInsert(AlfArrayList* list, const void* object, uint64_t index)
+void alfListInsert(AlfList* list, void* object, uint64_t index)
 {
 	if (index == 0)
 	{
-		alfArrayListPrepend(list, object);
+		alfListPrepend(list, object);
 		return;
 	}
 
 	if (index >= list->size)
 	{
-		alfArrayListAdd(list, object);
+		alfListAdd(list, object);
+		return;
 	}
 
 	if (list->size >= list->capacity)
 	{
-		alfArrayListReserve(list, list->capacity * 2);
+		alfListReserve(list, list->capacity * 2);
 	}
 
 	memmove(
-		list->buffer + (index + 1) * list->objectSize, 
-		list->buffer + index * list->objectSize, 
-		(list->size - index) * list->objectSize
+		list->buffer + index + 1, 
+		list->buffer + index, 
+		sizeof(void*) * (list->size - index)
 	);
-	memcpy(list->buffer + (index * list->objectSize), object, list->objectSize);
+	list->buffer[index] = object;
 	list->size++;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListRemove(AlfArrayList* list, uint64_t index)
+void* alfListRemove(AlfList* list, uint64_t index)
 {
-	if (index >= list->size) { return; }
+	if (index >= list->size) { return NULL; }
+	void* object = alfListGet(list, index);
 
 	memmove(
-		list->buffer + index * list->objectSize,
-		list->buffer + (index + 1) * list->objectSize,
-		(list->size - index - 1) * list->objectSize
+		list->buffer + index, 
+		list->buffer + index + 1, 
+		sizeof(void*) * (list->size - index - 1)
 	);
 	list->size--;
+	return object;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListRemoveGet(AlfArrayList* list, uint64_t index, void* object)
+void* alfListRemoveObject(AlfList* list, const void* object)
 {
-	if (index >= list->size) { return; }
-
-	if (object)
+	for (uint64_t i = 0; i < list->size; i++)
 	{
-		memcpy(
-			object, 
-			list->buffer + index * list->objectSize, 
-			list->objectSize
-		);
+		void* listObject = list->buffer[i];
+		if (listObject == object)
+		{
+			return alfListRemove(list, i);
+		}
 	}
-	memmove(
-		list->buffer + index * list->objectSize,
-		list->buffer + (index + 1) * list->objectSize,
-		(list->size - index - 1) * list->objectSize
-	);
-	list->size--;
+	return NULL;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListRemoveObject(AlfArrayList* list, void* object, PFN_AlfCollectionEqual equalsFunction)
+void* alfListRemoveObjectEqual(AlfList* list, const void* object, PFN_AlfCollectionEqual equalsFunction)
 {
 	for (uint64_t i = 0; i < list->size; i++)
 	{
-		void* listObject = alfArrayListGet(list, i);
+		void* listObject = list->buffer[i];
 		if (equalsFunction(listObject, object))
 		{
-			alfArrayListRemove(list, i);
+			return alfListRemove(list, i);
 		}
 	}
+	return NULL;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfArrayListGet(const AlfArrayList* list, uint64_t index)
+void alfListAddRange(AlfList* list, void* const* objects, uint64_t count)
 {
-	ALF_COLLECTION_ASSERT(
-		index >= 0 && index < list->size, 
-		"Index out of bounds: %u (0 - %u)", 
-		index, list->size
-	);
-
-	return list->buffer + (index * list->objectSize);
+	alfListInsertRange(list, objects, count, list->size);
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListResize(AlfArrayList* list, uint64_t size)
+void alfListInsertRange(
+	AlfList* list, 
+	void* const* objects, 
+	uint64_t count, 
+	uint64_t index)
 {
-	if (size > list->capacity)
+	if (count == 0) { return; }
+
+	// Grow once to fit all objects
+	if (list->size + count > list->capacity)
 	{
-		alfArrayListReserve(list, size);
+		alfListReserve(list, 
+			ALF_COLLECTION_MAX(list->capacity * 2, list->size + count));
+		if (list->size + count > list->capacity) { return; }
 	}
-	list->size = size;
-}
-
-// -------------------------------------------------------------------------- //
 
-void alfArrayListReserve(AlfArrayList* list, uint64_t capacity)
-{
-	if (capacity < list->capacity) { return; }
-
-	uint8_t* buffer = ALF_COLLECTION_ALLOC(capacity * list->objectSize);
-	memcpy(buffer, list->buffer, list->size * list->objectSize);
-	ALF_COLLECTION_FREE(list->buffer);
-	list->capacity = capacity;
-	list->buffer = buffer;
+	index = ALF_COLLECTION_MIN(index, list->size);
+	memmove(
+		list->buffer + index + count, 
+		list->buffer + index, 
+		sizeof(void*) * (list->size - index)
+	);
+	memcpy(list->buffer + index, objects, sizeof(void*) * count);
+	list->size += count;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListShrink(AlfArrayList* list, uint64_t capacity)
+void alfListRemoveRange(
+	AlfList* list, 
+	uint64_t index, 
+	uint64_t count, 
+	void** objectsOut)
 {
-	if (capacity > list->capacity) { return; }
+	if (index >= list->size) { return; }
+	count = ALF_COLLECTION_MIN(count, list->size - index);
 
-	uint8_t* buffer = ALF_COLLECTION_ALLOC(capacity * list->objectSize);
-	memcpy(buffer, list->buffer, capacity * list->objectSize);
-	for (uint64_t i = capacity; i < list->size; i++)
+	for (uint64_t i = 0; i < count; i++)
 	{
-		list->cleaner(alfArrayListGet(list, i));
+		if (objectsOut) { objectsOut[i] = list->buffer[index + i]; }
+		else { list->destructor(list->buffer[index + i]); }
 	}
-	ALF_COLLECTION_FREE(list->buffer);
-	list->capacity = capacity;
-	list->buffer = buffer;
-	list->size = ALF_COLLECTION_MIN(list->capacity, list->size);
+	memmove(
+		list->buffer + index, 
+		list->buffer + index + count, 
+		sizeof(void*) * (list->size - index - count)
+	);
+	list->size -= count;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListShrinkToFit(AlfArrayList* list)
+uint64_t alfListRemoveIf(
+	AlfList* list, 
+	PFN_AlfCollectionPredicate predicate, 
+	void* user)
 {
-	alfArrayListShrink(list, list->size);
+	// Move each object that is kept down over the removed objects
+	uint64_t size = 0;
+	for (uint64_t i = 0; i < list->size; i++)
+	{
+		void* object = list->buffer[i];
+		if (predicate(object, user))
+		{
+			list->destructor(object);
+		}
+		else
+		{
+			list->buffer[size++] = object;
+		}
+	}
+
+	const uint64_t removedCount = list->size - size;
+	list->size = size;
+	return removedCount;
 }
 
 // -------------------------------------------------------------------------- //
 
-uint64_t alfGetArrayListSize(const AlfArrayList* list)
+void* alfListGet(AlfList* list, uint64_t index)
 {
-	return list->size;
+	ALF_COLLECTION_ASSERT(
+		index >= 0 && index < list->size,
+		"Index out of bounds: %u (0 - %u)", 
+		index, list->size
+	);
+	return list->buffer[index];
 }
 
 // -------------------------------------------------------------------------- //
 
-const uint8_t* alfArrayListGetData(const AlfArrayList* list)
-{
-	return list->buffer;
-}
+void* alfListGetObject(
+	AlfList* list, 
+	void* object, 
+	PFN_AlfCollectionEqual equalsFunction)
+{
+	for (uint64_t i = 0; i < list->size; i++)
+	{
+		void* listObject = list->buffer[i];
+		if (equalsFunction(listObject, object))
+		{
+			return alfListGet(list, i);
+		}
+	}
+	return NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfListResize(AlfList* list, uint64_t size)
+{
+	if (size > list->capacity)
+	{
+		alfListReserve(list, size);
+	}
+	list->size = size;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfListReserve(AlfList* list, uint64_t capacity)
+{
+	if (capacity <= list->capacity) { return; }
+
+	void** buffer = (void**)alfAllocatorRealloc(&list->allocator, 
+		list->buffer, sizeof(void*) * list->capacity, sizeof(void*) * capacity);
+	if (!buffer) { return; }
+	list->capacity = capacity;
+	list->buffer = buffer;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfListShrink(AlfList* list, uint64_t capacity)
+{
+	if (capacity >= list->capacity) { return; }
+
+	for (uint64_t i = capacity; i < list->size; i++)
+	{
+		list->destructor(list->buffer[i]);
+	}
+	list->size = ALF_COLLECTION_MIN(capacity, list->size);
+
+	// The buffer always holds at least one object so that it can grow again
+	capacity = capacity ? capacity : 1;
+	void** buffer = (void**)alfAllocatorRealloc(&list->allocator, 
+		list->buffer, sizeof(void*) * list->capacity, sizeof(void*) * capacity);
+	if (!buffer) { return; }
+	list->capacity = capacity;
+	list->buffer = buffer;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfListShrinkToFit(AlfList* list)
+{
+	alfListShrink(list, list->size);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfGetListSize(AlfList* list)
+{
+	return list->size;
+}
+
+// -------------------------------------------------------------------------- //
+
+void* alfGetListData(AlfList* list)
+{
+	return list->buffer;
+}
+
+// ========================================================================== //
+// ArrayList Structures
+// ========================================================================== //
+
+/** Ranges with fewer objects than this are sorted with insertion sort **/
+#define ALF_ARRAY_LIST_SORT_INSERTION_THRESHOLD 24
+
+// -------------------------------------------------------------------------- //
+
+/** Ranges with more objects than this choose the pivot as the pseudo-median 
+ * of nine objects in place of the median of three **/
+#define ALF_ARRAY_LIST_SORT_NINTHER_THRESHOLD 128
+
+// -------------------------------------------------------------------------- //
+
+/** Number of objects that a partial insertion sort may move before it gives 
+ * up on a range that looked sorted **/
+#define ALF_ARRAY_LIST_SORT_PARTIAL_INSERTION_LIMIT 8
+
+// -------------------------------------------------------------------------- //
+
+/** Size of the pieces that objects of uncommon sizes are swapped in **/
+#define ALF_ARRAY_LIST_SORT_SWAP_SIZE 32
+
+// -------------------------------------------------------------------------- //
+
+/** Largest object size that the temporary object of a sort is placed on the
+ * stack for **/
+#define ALF_ARRAY_LIST_SORT_STACK_OBJECT_SIZE 64
+
+// -------------------------------------------------------------------------- //
+
+/** Largest key width of a radix sort in bytes **/
+#define ALF_ARRAY_LIST_RADIX_MAX_KEY_WIDTH 8
+
+// -------------------------------------------------------------------------- //
+
+typedef struct tag_AlfArrayList
+{
+	/** Size of each object in list **/
+	uint32_t objectSize;
+	/** Initial capacity **/
+	uint64_t capacity;
+	/** List size **/
+	uint64_t size;
+
+	/** Buffer **/
+	uint8_t* buffer;
+
+	/** Destructor function **/
+	PFN_AlfCollectionCleaner cleaner;
+
+	/** Allocator **/
+	AlfAllocator allocator;
+} tag_AlfArrayList;
+
+// -------------------------------------------------------------------------- //
+
+/** State of an array-list sort **/
+typedef struct AlfArrayListSortContext
+{
+	/** Size of each object **/
+	uint32_t objectSize;
+	/** Comparison function **/
+	PFN_AlfCollectionCompare compare;
+	/** Memory for one object, which objects are moved through **/
+	uint8_t* temp;
+} AlfArrayListSortContext;
+
+// -------------------------------------------------------------------------- //
+
+/** State of a k-way merge of sorted array-lists **/
+typedef struct AlfArrayListMergeContext
+{
+	/** Lists to merge **/
+	const AlfArrayList* const* lists;
+	/** Index of the next object of each list **/
+	uint64_t* positions;
+	/** Comparison function **/
+	PFN_AlfCollectionCompare compare;
+	/** Heap of the indices of the lists that have objects left, ordered by 
+	 * their next object **/
+	uint32_t* heap;
+	/** Number of lists in the heap **/
+	uint32_t heapSize;
+} AlfArrayListMergeContext;
+
+// ========================================================================== //
+// ArrayList Private Functions
+// ========================================================================== //
+
+AlfBool alfSetupArrayList(AlfArrayList* list, const AlfArrayListDesc* desc)
+{
+	list->allocator = alfAllocatorOrDefault(desc->allocator);
+	list->objectSize = desc->objectSize;
+	list->capacity =
+		desc->capacity ? desc->capacity : ALF_LIST_DEFAULT_CAPACITY;
+	list->size = 0;
+	list->cleaner = desc->cleaner ? desc->cleaner : alfDefaultCleaner;
+
+	list->buffer = alfAllocatorAlloc(
+		&list->allocator, list->capacity * list->objectSize);
+	return list->buffer != NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfCleanupArrayList(AlfArrayList* list)
+{
+	for (uint64_t i = 0; i < list->size; i++)
+	{
+		list->cleaner(alfArrayListGet(list, i));
+	}
+	alfAllocatorFree(
+		&list->allocator, list->buffer, list->capacity * list->objectSize);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Swap two objects. Common object sizes are swapped with fixed-size copies,
+ * which compile to plain loads and stores **/
+static void alfArrayListSwapObjects(
+	uint8_t* object0, 
+	uint8_t* object1, 
+	uint32_t size)
+{
+	uint8_t temp[ALF_ARRAY_LIST_SORT_SWAP_SIZE];
+	switch (size)
+	{
+		case 4:
+			memcpy(temp, object0, 4);
+			memcpy(object0, object1, 4);
+			memcpy(object1, temp, 4);
+			return;
+		case 8:
+			memcpy(temp, object0, 8);
+			memcpy(object0, object1, 8);
+			memcpy(object1, temp, 8);
+			return;
+		case 16:
+			memcpy(temp, object0, 16);
+			memcpy(object0, object1, 16);
+			memcpy(object1, temp, 16);
+			return;
+		case 32:
+			memcpy(temp, object0, 32);
+			memcpy(object0, object1, 32);
+			memcpy(object1, temp, 32);
+			return;
+		default:
+			break;
+	}
+
+	// Other sizes are swapped in pieces
+	while (size > 0)
+	{
+		const uint32_t count = size < ALF_ARRAY_LIST_SORT_SWAP_SIZE ? 
+			size : ALF_ARRAY_LIST_SORT_SWAP_SIZE;
+		memcpy(temp, object0, count);
+		memcpy(object0, object1, count);
+		memcpy(object1, temp, count);
+		object0 += count;
+		object1 += count;
+		size -= count;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether an object is ordered before another **/
+static AlfBool alfArrayListSortLess(
+	const AlfArrayListSortContext* context,
+	const uint8_t* object0,
+	const uint8_t* object1)
+{
+	return context->compare(object0, object1) < 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Sort three objects **/
+static void alfArrayListSort3(
+	const AlfArrayListSortContext* context,
+	uint8_t* object0,
+	uint8_t* object1,
+	uint8_t* object2)
+{
+	if (alfArrayListSortLess(context, object1, object0))
+	{
+		alfArrayListSwapObjects(object0, object1, context->objectSize);
+	}
+	if (alfArrayListSortLess(context, object2, object1))
+	{
+		alfArrayListSwapObjects(object1, object2, context->objectSize);
+		if (alfArrayListSortLess(context, object1, object0))
+		{
+			alfArrayListSwapObjects(object0, object1, context->objectSize);
+		}
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Insertion sort of the objects from 'begin' to 'end'. Each object is moved 
+ * through the temporary object into its place, which shifts the objects 
+ * between by one. Returns false if more than 'limit' objects were shifted, in
+ * which case the range is left partially sorted **/
+static AlfBool alfArrayListInsertionSort(
+	const AlfArrayListSortContext* context,
+	uint8_t* begin,
+	uint8_t* end,
+	uint64_t limit)
+{
+	const uint32_t size = context->objectSize;
+	uint64_t shiftCount = 0;
+	for (uint8_t* object = begin + size; object < end; object += size)
+	{
+		if (!alfArrayListSortLess(context, object, object - size)) { continue; }
+		memcpy(context->temp, object, size);
+		uint8_t* hole = object;
+		do
+		{
+			memcpy(hole, hole - size, size);
+			hole -= size;
+		} while (hole > begin && 
+			alfArrayListSortLess(context, context->temp, hole - size));
+		memcpy(hole, context->temp, size);
+
+		shiftCount += (uint64_t)(object - hole) / size;
+		if (shiftCount > limit) { return ALF_FALSE; }
+	}
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Move an object down a heap of 'count' objects until it is not less than 
+ * either of its children **/
+static void alfArrayListSiftDown(
+	const AlfArrayListSortContext* context,
+	uint8_t* heap,
+	uint64_t index,
+	uint64_t count)
+{
+	const uint32_t size = context->objectSize;
+	for (;;)
+	{
+		uint64_t child = index * 2 + 1;
+		if (child >= count) { return; }
+		if (child + 1 < count && alfArrayListSortLess(
+			context, heap + child * size, heap + (child + 1) * size))
+		{
+			child++;
+		}
+		if (!alfArrayListSortLess(
+			context, heap + index * size, heap + child * size))
+		{
+			return;
+		}
+		alfArrayListSwapObjects(heap + index * size, heap + child * size, size);
+		index = child;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Heapsort of the objects from 'begin' to 'end', which is used for ranges 
+ * that keep being partitioned badly **/
+static void alfArrayListHeapSort(
+	const AlfArrayListSortContext* context,
+	uint8_t* begin,
+	uint8_t* end)
+{
+	const uint32_t size = context->objectSize;
+	const uint64_t count = (uint64_t)(end - begin) / size;
+	for (uint64_t i = count / 2; i-- > 0;)
+	{
+		alfArrayListSiftDown(context, begin, i, count);
+	}
+	for (uint64_t i = count; i-- > 1;)
+	{
+		alfArrayListSwapObjects(begin, begin + i * size, size);
+		alfArrayListSiftDown(context, begin, 0, i);
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Partition the objects from 'begin' to 'end' around the pivot at 'begin'. 
+ * Objects that are less than the pivot are placed to the left of it and the 
+ * rest to the right. The scans need no bounds checks since the pivot was 
+ * chosen as a median, with an object that is not less than it at the end. 
+ * Returns the position of the pivot and whether the range was already 
+ * partitioned **/
+static uint8_t* alfArrayListPartitionRight(
+	const AlfArrayListSortContext* context,
+	uint8_t* begin,
+	uint8_t* end,
+	AlfBool* alreadyPartitionedOut)
+{
+	const uint32_t size = context->objectSize;
+	uint8_t* first = begin;
+	uint8_t* last = end;
+	do { first += size; } while (alfArrayListSortLess(context, first, begin));
+	if (first - size == begin)
+	{
+		while (first < last)
+		{
+			last -= size;
+			if (alfArrayListSortLess(context, last, begin)) { break; }
+		}
+	}
+	else
+	{
+		do { last -= size; } while (!alfArrayListSortLess(context, last, begin));
+	}
+
+	// Swap objects that are on the wrong side
+	*alreadyPartitionedOut = first >= last;
+	while (first < last)
+	{
+		alfArrayListSwapObjects(first, last, size);
+		do { first += size; } while (alfArrayListSortLess(context, first, begin));
+		do { last -= size; } while (!alfArrayListSortLess(context, last, begin));
+	}
+
+	// Move the pivot between the sides
+	uint8_t* pivot = first - size;
+	if (pivot != begin)
+	{
+		alfArrayListSwapObjects(begin, pivot, size);
+	}
+	return pivot;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Partition the objects from 'begin' to 'end' around the pivot at 'begin', 
+ * with objects that are equal to the pivot placed to the left of it. This is
+ * used when the pivot equals the pivot of the parent partition, as all of 
+ * the objects that are equal to it are then in place. Returns the position of
+ * the pivot **/
+static uint8_t* alfArrayListPartitionLeft(
+	const AlfArrayListSortContext* context,
+	uint8_t* begin,
+	uint8_t* end)
+{
+	const uint32_t size = context->objectSize;
+	uint8_t* first = begin;
+	uint8_t* last = end;
+	do { last -= size; } while (alfArrayListSortLess(context, begin, last));
+	if (last + size == end)
+	{
+		while (first < last)
+		{
+			first += size;
+			if (alfArrayListSortLess(context, begin, first)) { break; }
+		}
+	}
+	else
+	{
+		do { first += size; } while (!alfArrayListSortLess(context, begin, first));
+	}
+
+	// Swap objects that are on the wrong side
+	while (first < last)
+	{
+		alfArrayListSwapObjects(first, last, size);
+		do { last -= size; } while (alfArrayListSortLess(context, begin, last));
+		do { first += size; } while (!alfArrayListSortLess(context, begin, first));
+	}
+
+	// Move the pivot between the sides
+	if (last != begin)
+	{
+		alfArrayListSwapObjects(begin, last, size);
+	}
+	return last;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Swap objects at fixed offsets into a side of a bad partition, which breaks
+ * up the patterns that made the partition bad. The side is given by its 
+ * first and last object and the number of objects **/
+static void alfArrayListBreakPatterns(
+	const AlfArrayListSortContext* context,
+	uint8_t* first,
+	uint8_t* last,
+	uint64_t count)
+{
+	const uint32_t size = context->objectSize;
+	const uint64_t offset = count / 4;
+	alfArrayListSwapObjects(first, first + offset * size, size);
+	alfArrayListSwapObjects(last, last - offset * size, size);
+	if (count > ALF_ARRAY_LIST_SORT_NINTHER_THRESHOLD)
+	{
+		alfArrayListSwapObjects(
+			first + size, first + (offset + 1) * size, size);
+		alfArrayListSwapObjects(
+			first + 2 * size, first + (offset + 2) * size, size);
+		alfArrayListSwapObjects(
+			last - size, last - (offset + 1) * size, size);
+		alfArrayListSwapObjects(
+			last - 2 * size, last - (offset + 2) * size, size);
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Sort the objects from 'begin' to 'end' with pattern-defeating quicksort 
+ * (pdqsort). Small ranges are insertion sorted and ranges that are already 
+ * sorted are detected in linear time. Each partition that is badly balanced 
+ * uses up one of 'badAllowed', after which the range is heapsorted, so the 
+ * sort never degrades to quadratic time. Only the smaller side is sorted 
+ * recursively, which bounds the recursion depth by the logarithm of the size.
+ * 'leftmost' is false for ranges that have an object before them that is not
+ * greater than any of their objects **/
+static void alfArrayListIntroSort(
+	const AlfArrayListSortContext* context,
+	uint8_t* begin,
+	uint8_t* end,
+	uint32_t badAllowed,
+	AlfBool leftmost)
+{
+	const uint32_t size = context->objectSize;
+	for (;;)
+	{
+		const uint64_t count = (uint64_t)(end - begin) / size;
+		if (count < ALF_ARRAY_LIST_SORT_INSERTION_THRESHOLD)
+		{
+			alfArrayListInsertionSort(context, begin, end, UINT64_MAX);
+			return;
+		}
+
+		// Choose the pivot and move it to the beginning
+		uint8_t* middle = begin + (count / 2) * size;
+		if (count > ALF_ARRAY_LIST_SORT_NINTHER_THRESHOLD)
+		{
+			alfArrayListSort3(context, begin, middle, end - size);
+			alfArrayListSort3(
+				context, begin + size, middle - size, end - 2 * size);
+			alfArrayListSort3(
+				context, begin + 2 * size, middle + size, end - 3 * size);
+			alfArrayListSort3(context, middle - size, middle, middle + size);
+			alfArrayListSwapObjects(begin, middle, size);
+		}
+		else
+		{
+			alfArrayListSort3(context, middle, begin, end - size);
+		}
+
+		// A pivot that equals the object before the range is the smallest 
+		// object, so the objects that equal it need no further sorting
+		if (!leftmost && 
+			!alfArrayListSortLess(context, begin - size, begin))
+		{
+			begin = alfArrayListPartitionLeft(context, begin, end) + size;
+			continue;
+		}
+
+		// Partition
+		AlfBool alreadyPartitioned;
+		uint8_t* pivot = 
+			alfArrayListPartitionRight(context, begin, end, &alreadyPartitioned);
+		const uint64_t leftCount = (uint64_t)(pivot - begin) / size;
+		const uint64_t rightCount = (uint64_t)(end - pivot) / size - 1;
+		if (leftCount < count / 8 || rightCount < count / 8)
+		{
+			if (--badAllowed == 0)
+			{
+				alfArrayListHeapSort(context, begin, end);
+				return;
+			}
+			if (leftCount >= ALF_ARRAY_LIST_SORT_INSERTION_THRESHOLD)
+			{
+				alfArrayListBreakPatterns(
+					context, begin, pivot - size, leftCount);
+			}
+			if (rightCount >= ALF_ARRAY_LIST_SORT_INSERTION_THRESHOLD)
+			{
+				alfArrayListBreakPatterns(
+					context, pivot + size, end - size, rightCount);
+			}
+		}
+		else if (alreadyPartitioned && 
+			alfArrayListInsertionSort(context, begin, pivot, 
+				ALF_ARRAY_LIST_SORT_PARTIAL_INSERTION_LIMIT) &&
+			alfArrayListInsertionSort(context, pivot + size, end, 
+				ALF_ARRAY_LIST_SORT_PARTIAL_INSERTION_LIMIT))
+		{
+			return;
+		}
+
+		// Sort the smaller side and continue with the larger
+		if (leftCount < rightCount)
+		{
+			alfArrayListIntroSort(context, begin, pivot, badAllowed, leftmost);
+			begin = pivot + size;
+			leftmost = ALF_FALSE;
+		}
+		else
+		{
+			alfArrayListIntroSort(
+				context, pivot + size, end, badAllowed, ALF_FALSE);
+			end = pivot;
+		}
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the key of an object as an unsigned integer that orders the same 
+ * way as the key. Signed integers have their sign bit flipped, while negative
+ * floating-point numbers have all bits flipped and positive ones have their 
+ * sign bit set **/
+static uint64_t alfArrayListGetRadixKey(
+	const uint8_t* key, 
+	uint32_t keyWidth, 
+	AlfArrayListKeyType keyType)
+{
+	uint64_t value;
+	switch (keyWidth)
+	{
+		case 1:
+		{
+			uint8_t narrow;
+			memcpy(&narrow, key, sizeof(narrow));
+			value = narrow;
+			break;
+		}
+		case 2:
+		{
+			uint16_t narrow;
+			memcpy(&narrow, key, sizeof(narrow));
+			value = narrow;
+			break;
+		}
+		case 4:
+		{
+			uint32_t narrow;
+			memcpy(&narrow, key, sizeof(narrow));
+			value = narrow;
+			break;
+		}
+		default:
+		{
+			memcpy(&value, key, sizeof(value));
+			break;
+		}
+	}
+
+	const uint64_t signBit = 1ull << (keyWidth * 8 - 1);
+	switch (keyType)
+	{
+		case ALF_ARRAY_LIST_KEY_TYPE_SIGNED:
+			return value ^ signBit;
+		case ALF_ARRAY_LIST_KEY_TYPE_FLOAT:
+			return value & signBit ? 
+				~value & (signBit | (signBit - 1)) : value | signBit;
+		default:
+			return value;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the index of the first object in a sorted array-list that is not 
+ * less than an object, or with 'upper' set the first that is greater. Each 
+ * step halves the range by moving its start or not, which compiles to a 
+ * conditional move instead of a branch **/
+static uint64_t alfArrayListSearchBound(
+	const AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compare,
+	AlfBool upper)
+{
+	if (list->size == 0) { return 0; }
+	const uint32_t size = list->objectSize;
+	const uint8_t* base = list->buffer;
+	uint64_t count = list->size;
+	while (count > 1)
+	{
+		const uint64_t half = count / 2;
+		const int32_t order = compare(base + half * size, object);
+		base += (upper ? order <= 0 : order < 0) ? half * size : 0;
+		count -= half;
+	}
+	const int32_t order = compare(base, object);
+	return (uint64_t)(base - list->buffer) / size + 
+		(upper ? order <= 0 : order < 0);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether the next object of a list in a k-way merge is ordered 
+ * before the next object of another list. Equal objects are ordered by list,
+ * which keeps the merge stable **/
+static AlfBool alfArrayListMergeLess(
+	const AlfArrayListMergeContext* context,
+	uint32_t list0,
+	uint32_t list1)
+{
+	const AlfArrayList* l0 = context->lists[list0];
+	const AlfArrayList* l1 = context->lists[list1];
+	const int32_t order = context->compare(
+		l0->buffer + context->positions[list0] * l0->objectSize,
+		l1->buffer + context->positions[list1] * l1->objectSize);
+	return order < 0 || (order == 0 && list0 < list1);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Move a list down the heap of a k-way merge until its next object is not 
+ * ordered after the next object of either of its children **/
+static void alfArrayListMergeSiftDown(
+	AlfArrayListMergeContext* context, 
+	uint32_t index)
+{
+	uint32_t* heap = context->heap;
+	for (;;)
+	{
+		uint32_t child = index * 2 + 1;
+		if (child >= context->heapSize) { return; }
+		if (child + 1 < context->heapSize && 
+			alfArrayListMergeLess(context, heap[child + 1], heap[child]))
+		{
+			child++;
+		}
+		if (!alfArrayListMergeLess(context, heap[child], heap[index])) 
+		{ 
+			return; 
+		}
+		const uint32_t swap = heap[index];
+		heap[index] = heap[child];
+		heap[child] = swap;
+		index = child;
+	}
+}
+
+// ========================================================================== //
+// ArrayList Functions
+// ========================================================================== //
+
+AlfArrayList* alfCreateArrayList(const AlfArrayListDesc* desc)
+{
+	ALF_COLLECTION_ASSERT(
+		desc->objectSize != 0, 
+		"Size of objects in array-list must be greater than zero"
+	);
+
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfArrayList* list = alfAllocatorAlloc(&allocator, sizeof(AlfArrayList));
+	if (!list) { return NULL; }
+	if (!alfSetupArrayList(list, desc))
+	{
+		alfAllocatorFree(&allocator, list, sizeof(AlfArrayList));
+		return NULL;
+	}
+	return list;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfArrayList* alfCreateArrayListForObjectSize(uint32_t objectSize, PFN_AlfCollectionCleaner cleaner)
+{
+	AlfArrayListDesc desc = { 0 };
+	desc.objectSize = objectSize;
+	desc.cleaner = cleaner;
+	desc.capacity = ALF_LIST_DEFAULT_CAPACITY;
+	return alfCreateArrayList(&desc);
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfDestroyArrayList(AlfArrayList* list)
+{
+	const AlfAllocator allocator = list->allocator;
+	alfCleanupArrayList(list);
+	alfAllocatorFree(&allocator, list, sizeof(AlfArrayList));
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListAdd(AlfArrayList* list, const void* object)
+{
+	if (list->size >= list->capacity)
+	{
+		alfArrayListReserve(list, list->capacity * 2);
+	}
+
+	memcpy(
+		list->buffer + (list->size++ * list->objectSize), 
+		object, 
+		list->objectSize
+	);
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListPrepend(AlfArrayList* list, const void* object)
+{
+	if (list->size >= list->capacity)
+	{
+		alfArrayListReserve(list, list->capacity * 2);
+	}
+
+	memmove(
+		list->buffer + list->objectSize, 
+		list->buffer, 
+		list->size * list->objectSize
+	);
+	memcpy(list->buffer, object, list->objectSize);
+	list->size++;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListInsert(AlfArrayList* list, const void* object, uint64_t index)
+{
+	if (index == 0)
+	{
+		alfArrayListPrepend(list, object);
+		return;
+	}
+
+	if (index >= list->size)
+	{
+		alfArrayListAdd(list, object);
+		return;
+	}
+
+	if (list->size >= list->capacity)
+	{
+		alfArrayListReserve(list, list->capacity * 2);
+	}
+
+	memmove(
+		list->buffer + (index + 1) * list->objectSize, 
+		list->buffer + index * list->objectSize, 
+		(list->size - index) * list->objectSize
+	);
+	memcpy(list->buffer + (index * list->objectSize), object, list->objectSize);
+	list->size++;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListRemove(AlfArrayList* list, uint64_t index)
+{
+	if (index >= list->size) { return; }
+
+	memmove(
+		list->buffer + index * list->objectSize,
+		list->buffer + (index + 1) * list->objectSize,
+		(list->size - index - 1) * list->objectSize
+	);
+	list->size--;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListRemoveGet(AlfArrayList* list, uint64_t index, void* object)
+{
+	if (index >= list->size) { return; }
+
+	if (object)
+	{
+		memcpy(
+			object, 
+			list->buffer + index * list->objectSize, 
+			list->objectSize
+		);
+	}
+	memmove(
+		list->buffer + index * list->objectSize,
+		list->buffer + (index + 1) * list->objectSize,
+		(list->size - index - 1) * list->objectSize
+	);
+	list->size--;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListRemoveObject(AlfArrayList* list, void* object, PFN_AlfCollectionEqual equalsFunction)
+{
+	for (uint64_t i = 0; i < list->size; i++)
+	{
+		void* listObject = alfArrayListGet(list, i);
+		if (equalsFunction(listObject, object))
+		{
+			alfArrayListRemove(list, i);
+		}
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListAddRange(
+	AlfArrayList* list, 
+	const void* objects, 
+	uint64_t count)
+{
+	alfArrayListInsertRange(list, objects, count, list->size);
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListInsertRange(
+	AlfArrayList* list, 
+	const void* objects, 
+	uint64_t count, 
+	uint64_t index)
+{
+	if (count == 0) { return; }
+
+	// Grow once to fit all objects
+	if (list->size + count > list->capacity)
+	{
+		alfArrayListReserve(list, 
+			ALF_COLLECTION_MAX(list->capacity * 2, list->size + count));
+		if (list->size + count > list->capacity) { return; }
+	}
+
+	index = ALF_COLLECTION_MIN(index, list->size);
+	memmove(
+		list->buffer + (index + count) * list->objectSize, 
+		list->buffer + index * list->objectSize, 
+		(list->size - index) * list->objectSize
+	);
+	memcpy(
+		list->buffer + index * list->objectSize, 
+		objects, 
+		count * list->objectSize
+	);
+	list->size += count;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListRemoveRange(
+	AlfArrayList* list, 
+	uint64_t index, 
+	uint64_t count, 
+	void* objects)
+{
+	if (index >= list->size) { return; }
+	count = ALF_COLLECTION_MIN(count, list->size - index);
+
+	if (objects)
+	{
+		memcpy(
+			objects, 
+			list->buffer + index * list->objectSize, 
+			count * list->objectSize
+		);
+	}
+	memmove(
+		list->buffer + index * list->objectSize,
+		list->buffer + (index + count) * list->objectSize,
+		(list->size - index - count) * list->objectSize
+	);
+	list->size -= count;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfArrayListRemoveIf(
+	AlfArrayList* list, 
+	PFN_AlfCollectionPredicate predicate, 
+	void* user)
+{
+	// Move each object that is kept down over the removed objects. Objects 
+	// that are already in place are not copied
+	const uint32_t objectSize = list->objectSize;
+	uint64_t size = 0;
+	for (uint64_t i = 0; i < list->size; i++)
+	{
+		uint8_t* object = list->buffer + i * objectSize;
+		if (predicate(object, user))
+		{
+			list->cleaner(object);
+		}
+		else
+		{
+			if (size != i)
+			{
+				memcpy(list->buffer + size * objectSize, object, objectSize);
+			}
+			size++;
+		}
+	}
+
+	const uint64_t removedCount = list->size - size;
+	list->size = size;
+	return removedCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+void* alfArrayListGet(const AlfArrayList* list, uint64_t index)
+{
+	ALF_COLLECTION_ASSERT(
+		index >= 0 && index < list->size, 
+		"Index out of bounds: %u (0 - %u)", 
+		index, list->size
+	);
+
+	return list->buffer + (index * list->objectSize);
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListResize(AlfArrayList* list, uint64_t size)
+{
+	if (size > list->capacity)
+	{
+		alfArrayListReserve(list, size);
+	}
+	list->size = size;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListReserve(AlfArrayList* list, uint64_t capacity)
+{
+	if (capacity <= list->capacity) { return; }
+
+	uint8_t* buffer = alfAllocatorRealloc(&list->allocator, list->buffer, 
+		list->capacity * list->objectSize, capacity * list->objectSize);
+	if (!buffer) { return; }
+	list->capacity = capacity;
+	list->buffer = buffer;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListShrink(AlfArrayList* list, uint64_t capacity)
+{
+	if (capacity >= list->capacity) { return; }
+
+	for (uint64_t i = capacity; i < list->size; i++)
+	{
+		list->cleaner(alfArrayListGet(list, i));
+	}
+	list->size = ALF_COLLECTION_MIN(capacity, list->size);
+
+	// The buffer always holds at least one object so that it can grow again
+	capacity = capacity ? capacity : 1;
+	uint8_t* buffer = alfAllocatorRealloc(&list->allocator, list->buffer, 
+		list->capacity * list->objectSize, capacity * list->objectSize);
+	if (!buffer) { return; }
+	list->capacity = capacity;
+	list->buffer = buffer;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListShrinkToFit(AlfArrayList* list)
+{
+	alfArrayListShrink(list, list->size);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfGetArrayListSize(const AlfArrayList* list)
+{
+	return list->size;
+}
+
+// -------------------------------------------------------------------------- //
+
+const uint8_t* alfArrayListGetData(const AlfArrayList* list)
+{
+	return list->buffer;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfArrayListSort(
+	AlfArrayList* list, 
+	PFN_AlfCollectionCompare compareFunction)
+{
+	if (list->size < 2) { return; }
+
+	// Objects are moved through a temporary object, which is only allocated
+	// for large objects. Heapsort needs none if it cannot be allocated
+	uint8_t stackTemp[ALF_ARRAY_LIST_SORT_STACK_OBJECT_SIZE];
+	AlfArrayListSortContext context;
+	context.objectSize = list->objectSize;
+	context.compare = compareFunction;
+	context.temp = list->objectSize <= ALF_ARRAY_LIST_SORT_STACK_OBJECT_SIZE ?
+		stackTemp : alfAllocatorAlloc(&list->allocator, list->objectSize);
+	uint8_t* end = list->buffer + list->size * list->objectSize;
+	if (!context.temp)
+	{
+		alfArrayListHeapSort(&context, list->buffer, end);
+		return;
+	}
+
+	// Allow as many bad partitions as the logarithm of the size
+	uint32_t badAllowed = 0;
+	for (uint64_t size = list->size; size > 1; size >>= 1) { badAllowed++; }
+	alfArrayListIntroSort(&context, list->buffer, end, badAllowed, ALF_TRUE);
+	if (context.temp != stackTemp)
+	{
+		alfAllocatorFree(&list->allocator, context.temp, list->objectSize);
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfArrayListRadixSort(
+	AlfArrayList* list,
+	uint32_t keyOffset,
+	uint32_t keyWidth,
+	AlfArrayListKeyType keyType)
+{
+	// Assert the preconditions
+	ALF_COLLECTION_ASSERT(
+		keyWidth == 1 || keyWidth == 2 || keyWidth == 4 || keyWidth == 8,
+		"Width of radix sort key must be 1, 2, 4 or 8 bytes"
+	);
+	ALF_COLLECTION_ASSERT(
+		keyType != ALF_ARRAY_LIST_KEY_TYPE_FLOAT || keyWidth >= 4,
+		"Width of floating-point radix sort key must be 4 or 8 bytes"
+	);
+	ALF_COLLECTION_ASSERT(
+		(uint64_t)keyOffset + keyWidth <= list->objectSize,
+		"Radix sort key must be inside the objects of the array-list"
+	);
+	if (list->size < 2) { return ALF_TRUE; }
+
+	// Count the digits of all passes at once
+	const uint32_t objectSize = list->objectSize;
+	uint64_t counts[ALF_ARRAY_LIST_RADIX_MAX_KEY_WIDTH][256];
+	memset(counts, 0, sizeof(counts));
+	for (uint64_t i = 0; i < list->size; i++)
+	{
+		const uint64_t key = alfArrayListGetRadixKey(
+			list->buffer + i * objectSize + keyOffset, keyWidth, keyType);
+		for (uint32_t pass = 0; pass < keyWidth; pass++)
+		{
+			counts[pass][(key >> (pass * 8)) & 0xFF]++;
+		}
+	}
+
+	// The scratch buffer has the capacity of the list, so that it can replace
+	// the list buffer when it holds the result
+	const uint64_t bufferSize = list->capacity * objectSize;
+	uint8_t* scratch = alfAllocatorAlloc(&list->allocator, bufferSize);
+	if (!scratch) { return ALF_FALSE; }
+
+	// Sort by each digit from the least significant, skipping digits that are
+	// the same in all keys
+	uint8_t* source = list->buffer;
+	uint8_t* destination = scratch;
+	const uint64_t firstKey = 
+		alfArrayListGetRadixKey(source + keyOffset, keyWidth, keyType);
+	for (uint32_t pass = 0; pass < keyWidth; pass++)
+	{
+		uint64_t* offsets = counts[pass];
+		if (offsets[(firstKey >> (pass * 8)) & 0xFF] == list->size) { continue; }
+		uint64_t offset = 0;
+		for (uint32_t digit = 0; digit < 256; digit++)
+		{
+			const uint64_t count = offsets[digit];
+			offsets[digit] = offset;
+			offset += count;
+		}
+		for (uint64_t i = 0; i < list->size; i++)
+		{
+			const uint8_t* object = source + i * objectSize;
+			const uint64_t key = 
+				alfArrayListGetRadixKey(object + keyOffset, keyWidth, keyType);
+			memcpy(destination + offsets[(key >> (pass * 8)) & 0xFF]++ * 
+				objectSize, object, objectSize);
+		}
+		uint8_t* swap = source;
+		source = destination;
+		destination = swap;
+	}
+
+	// Keep the buffer that holds the result
+	if (source != list->buffer)
+	{
+		alfAllocatorFree(&list->allocator, list->buffer, bufferSize);
+		list->buffer = source;
+	}
+	else
+	{
+		alfAllocatorFree(&list->allocator, scratch, bufferSize);
+	}
+	return ALF_TRUE;
+}
+
+// ========================================================================== //
+// ArrayList Sorted Functions
+// ========================================================================== //
+
+uint64_t alfArrayListLowerBound(
+	const AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction)
+{
+	return alfArrayListSearchBound(list, object, compareFunction, ALF_FALSE);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfArrayListUpperBound(
+	const AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction)
+{
+	return alfArrayListSearchBound(list, object, compareFunction, ALF_TRUE);
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfArrayListBinarySearch(
+	const AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction,
+	uint64_t* indexOut)
+{
+	const uint64_t index = 
+		alfArrayListSearchBound(list, object, compareFunction, ALF_FALSE);
+	if (indexOut) { *indexOut = index; }
+	return index < list->size && 
+		compareFunction(list->buffer + index * list->objectSize, object) == 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfArrayListInsertSorted(
+	AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction)
+{
+	const uint64_t index = 
+		alfArrayListSearchBound(list, object, compareFunction, ALF_TRUE);
+	if (list->size >= list->capacity)
+	{
+		alfArrayListReserve(list, list->capacity * 2);
+	}
+
+	memmove(
+		list->buffer + (index + 1) * list->objectSize, 
+		list->buffer + index * list->objectSize, 
+		(list->size - index) * list->objectSize
+	);
+	memcpy(list->buffer + index * list->objectSize, object, list->objectSize);
+	list->size++;
+	return index;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfArrayListMergeSorted(
+	AlfArrayList* list,
+	const AlfArrayList* const* lists,
+	uint32_t listCount,
+	PFN_AlfCollectionCompare compareFunction)
+{
+	// Reserve space for all objects at once
+	const uint32_t objectSize = list->objectSize;
+	uint64_t count = 0;
+	for (uint32_t i = 0; i < listCount; i++)
+	{
+		ALF_COLLECTION_ASSERT(lists[i] != list, 
+			"Array-list cannot be merged into itself");
+		ALF_COLLECTION_ASSERT(lists[i]->objectSize == objectSize,
+			"Merged array-lists must have the same object size");
+		count += lists[i]->size;
+	}
+	if (count == 0) { return ALF_TRUE; }
+	alfArrayListReserve(list, list->size + count);
+	if (list->capacity < list->size + count) { return ALF_FALSE; }
+
+	// Place each list with objects in the heap
+	AlfArrayListMergeContext context;
+	context.lists = lists;
+	context.compare = compareFunction;
+	context.heapSize = 0;
+	context.positions = 
+		alfAllocatorAlloc(&list->allocator, sizeof(uint64_t) * listCount);
+	context.heap = 
+		alfAllocatorAlloc(&list->allocator, sizeof(uint32_t) * listCount);
+	if (!context.positions || !context.heap)
+	{
+		alfAllocatorFree(&list->allocator, context.heap, 
+			sizeof(uint32_t) * listCount);
+		alfAllocatorFree(&list->allocator, context.positions, 
+			sizeof(uint64_t) * listCount);
+		return ALF_FALSE;
+	}
+	for (uint32_t i = 0; i < listCount; i++)
+	{
+		context.positions[i] = 0;
+		if (lists[i]->size) { context.heap[context.heapSize++] = i; }
+	}
+	for (uint32_t i = context.heapSize / 2; i > 0; i--)
+	{
+		alfArrayListMergeSiftDown(&context, i - 1);
+	}
+
+	// Take the next object of the list at the top of the heap, until a single
+	// list remains whose objects are then copied at once
+	uint8_t* destination = list->buffer + list->size * objectSize;
+	while (context.heapSize > 1)
+	{
+		const uint32_t top = context.heap[0];
+		memcpy(destination, lists[top]->buffer + 
+			context.positions[top] * objectSize, objectSize);
+		destination += objectSize;
+		if (++context.positions[top] == lists[top]->size)
+		{
+			context.heap[0] = context.heap[--context.heapSize];
+		}
+		alfArrayListMergeSiftDown(&context, 0);
+	}
+	if (context.heapSize)
+	{
+		const uint32_t last = context.heap[0];
+		memcpy(destination, 
+			lists[last]->buffer + context.positions[last] * objectSize,
+			(lists[last]->size - context.positions[last]) * objectSize);
+	}
+	list->size += count;
+
+	alfAllocatorFree(&list->allocator, context.heap, 
+		sizeof(uint32_t) * listCount);
+	alfAllocatorFree(&list->allocator, context.positions, 
+		sizeof(uint64_t) * listCount);
+	return ALF_TRUE;
+}
+
+// ========================================================================== //
+// ArrayList Parallel Structures
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Maximum number of threads used by a parallel array-list sort **/
+#define ALF_ARRAY_LIST_PARALLEL_MAX_THREAD_COUNT 256
+
+// -------------------------------------------------------------------------- //
+
+/** Minimum number of objects that each thread of a parallel array-list sort
+ * sorts. Smaller lists are sorted on fewer threads **/
+#define ALF_ARRAY_LIST_PARALLEL_MIN_RUN_SIZE 16384
+
+// -------------------------------------------------------------------------- //
+
+/** Number of objects in the runs that a stable merge sort insertion sorts 
+ * before merging them **/
+#define ALF_ARRAY_LIST_STABLE_RUN_SIZE 16
+
+// -------------------------------------------------------------------------- //
+
+/** Work of a single thread in a parallel array-list sort. The task either 
+ * sorts its first run in place, or merges its two runs into the destination **/
+typedef struct AlfArrayListParallelTask
+{
+	/** Sort context of the thread **/
+	AlfArrayListSortContext context;
+	/** Whether the task merges instead of sorts **/
+	AlfBool merge;
+	/** Whether the sort must keep equal objects in order **/
+	AlfBool stable;
+
+	/** Start of the first run **/
+	uint8_t* begin0;
+	/** End of the first run **/
+	uint8_t* end0;
+	/** Start of the second run **/
+	uint8_t* begin1;
+	/** End of the second run **/
+	uint8_t* end1;
+	/** Destination of a merge, or scratch memory of a stable sort **/
+	uint8_t* destination;
+} AlfArrayListParallelTask;
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// ArrayList Private Parallel Functions
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Merge two sorted runs into the destination. Objects of the first run are 
+ * placed before equal objects of the second run, which keeps the merge stable
+ **/
+static void alfArrayListMerge(
+	const AlfArrayListSortContext* context,
+	const uint8_t* begin0,
+	const uint8_t* end0,
+	const uint8_t* begin1,
+	const uint8_t* end1,
+	uint8_t* destination)
+{
+	const uint32_t size = context->objectSize;
+	while (begin0 < end0 && begin1 < end1)
+	{
+		if (alfArrayListSortLess(context, begin1, begin0))
+		{
+			memcpy(destination, begin1, size);
+			begin1 += size;
+		}
+		else
+		{
+			memcpy(destination, begin0, size);
+			begin0 += size;
+		}
+		destination += size;
+	}
+	memcpy(destination, begin0, (size_t)(end0 - begin0));
+	destination += end0 - begin0;
+	memcpy(destination, begin1, (size_t)(end1 - begin1));
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Stable merge sort of the objects from 'begin' to 'end', using scratch 
+ * memory of the same size. Short runs are insertion sorted and then merged 
+ * bottom-up, back and forth between the objects and the scratch memory **/
+static void alfArrayListMergeSort(
+	const AlfArrayListSortContext* context,
+	uint8_t* begin,
+	uint8_t* end,
+	uint8_t* scratch)
+{
+	const uint32_t size = context->objectSize;
+	const uint64_t count = (uint64_t)(end - begin) / size;
+	for (uint64_t i = 0; i < count; i += ALF_ARRAY_LIST_STABLE_RUN_SIZE)
+	{
+		const uint64_t runEnd = 
+			ALF_COLLECTION_MIN(i + ALF_ARRAY_LIST_STABLE_RUN_SIZE, count);
+		alfArrayListInsertionSort(
+			context, begin + i * size, begin + runEnd * size, UINT64_MAX);
+	}
+
+	uint8_t* source = begin;
+	uint8_t* destination = scratch;
+	for (uint64_t width = ALF_ARRAY_LIST_STABLE_RUN_SIZE; width < count; 
+		width *= 2)
+	{
+		for (uint64_t i = 0; i < count; i += 2 * width)
+		{
+			const uint64_t middle = ALF_COLLECTION_MIN(i + width, count);
+			const uint64_t runEnd = ALF_COLLECTION_MIN(i + 2 * width, count);
+			alfArrayListMerge(context, source + i * size, source + middle * size,
+				source + middle * size, source + runEnd * size, 
+				destination + i * size);
+		}
+		uint8_t* swap = source;
+		source = destination;
+		destination = swap;
+	}
+	if (source != begin) { memcpy(begin, source, count * size); }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns how many of the first 'count' objects of the merge of two sorted 
+ * runs that come from the first run. This lets a merge be divided into parts
+ * that produce consecutive ranges of the output **/
+static uint64_t alfArrayListMergeSplit(
+	const AlfArrayListSortContext* context,
+	const uint8_t* begin0,
+	uint64_t count0,
+	const uint8_t* begin1,
+	uint64_t count1,
+	uint64_t count)
+{
+	// Find the smallest split where the next object of the first run is not 
+	// needed before the last object taken from the second run
+	const uint32_t size = context->objectSize;
+	uint64_t low = count > count1 ? count - count1 : 0;
+	uint64_t high = ALF_COLLECTION_MIN(count, count0);
+	while (low < high)
+	{
+		const uint64_t split = low + (high - low) / 2;
+		if (!alfArrayListSortLess(context, 
+			begin1 + (count - split - 1) * size, begin0 + split * size))
+		{
+			low = split + 1;
+		}
+		else
+		{
+			high = split;
+		}
+	}
+	return low;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Thread function of a parallel array-list sort task **/
+static uint32_t alfArrayListParallelWork(void* argument)
+{
+	AlfArrayListParallelTask* task = argument;
+	if (task->merge)
+	{
+		alfArrayListMerge(&task->context, task->begin0, task->end0, 
+			task->begin1, task->end1, task->destination);
+	}
+	else if (task->stable)
+	{
+		alfArrayListMergeSort(
+			&task->context, task->begin0, task->end0, task->destination);
+	}
+	else
+	{
+		uint32_t badAllowed = 0;
+		for (uint64_t count = (uint64_t)(task->end0 - task->begin0) / 
+			task->context.objectSize; count > 1; count >>= 1) 
+		{ 
+			badAllowed++; 
+		}
+		alfArrayListIntroSort(
+			&task->context, task->begin0, task->end0, badAllowed, ALF_TRUE);
+	}
+	return 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Run each task on its own thread. The first task is run on the calling 
+ * thread, as is any task whose thread could not be created **/
+static void alfArrayListRunParallel(
+	AlfArrayListParallelTask* tasks, 
+	uint32_t taskCount)
+{
+	AlfThread* threads[ALF_ARRAY_LIST_PARALLEL_MAX_THREAD_COUNT + 1];
+	for (uint32_t i = 1; i < taskCount; i++)
+	{
+		threads[i] = alfCreateThread(alfArrayListParallelWork, &tasks[i]);
+	}
+	alfArrayListParallelWork(&tasks[0]);
+	for (uint32_t i = 1; i < taskCount; i++)
+	{
+		if (threads[i]) { alfJoinThread(threads[i]); }
+		else { alfArrayListParallelWork(&tasks[i]); }
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Sort an array list with one run per thread, that are then merged in 
+ * parallel. Returns false if memory could not be allocated, or if the sort is
+ * not stable and the list is too small to divide **/
+static AlfBool alfArrayListSortParallelRuns(
+	AlfArrayList* list,
+	PFN_AlfCollectionCompare compareFunction,
+	uint32_t threadCount,
+	AlfBool stable)
+{
+	// Use fewer threads for small lists
+	if (!threadCount)
+	{
+		threadCount = alfGetHardwareThreadCount();
+	}
+	if (threadCount > ALF_ARRAY_LIST_PARALLEL_MAX_THREAD_COUNT)
+	{
+		threadCount = ALF_ARRAY_LIST_PARALLEL_MAX_THREAD_COUNT;
+	}
+	const uint64_t maxThreadCount = 
+		list->size / ALF_ARRAY_LIST_PARALLEL_MIN_RUN_SIZE;
+	if (threadCount > maxThreadCount)
+	{
+		threadCount = (uint32_t)maxThreadCount;
+	}
+	if (threadCount < 2 && !stable) { return ALF_FALSE; }
+	threadCount = threadCount ? threadCount : 1;
+
+	// Allocate the scratch buffer with the capacity of the list, so that it 
+	// can replace the list buffer, and the tasks with a temporary object each.
+	// A merge round may need one more task than there are threads
+	const uint32_t objectSize = list->objectSize;
+	const uint64_t bufferSize = list->capacity * objectSize;
+	const uint32_t taskCount = threadCount + 1;
+	uint8_t* scratch = alfAllocatorAlloc(&list->allocator, bufferSize);
+	AlfArrayListParallelTask* tasks = alfAllocatorAlloc(
+		&list->allocator, sizeof(AlfArrayListParallelTask) * taskCount);
+	uint8_t* temps = 
+		alfAllocatorAlloc(&list->allocator, (uint64_t)objectSize * taskCount);
+	if (!scratch || !tasks || !temps)
+	{
+		alfAllocatorFree(&list->allocator, temps, 
+			(uint64_t)objectSize * taskCount);
+		alfAllocatorFree(&list->allocator, tasks, 
+			sizeof(AlfArrayListParallelTask) * taskCount);
+		alfAllocatorFree(&list->allocator, scratch, bufferSize);
+		return ALF_FALSE;
+	}
+	for (uint32_t i = 0; i < taskCount; i++)
+	{
+		tasks[i].context.objectSize = objectSize;
+		tasks[i].context.compare = compareFunction;
+		tasks[i].context.temp = temps + (uint64_t)i * objectSize;
+		tasks[i].stable = stable;
+	}
+
+	// Sort one run on each thread
+	uint64_t bounds[ALF_ARRAY_LIST_PARALLEL_MAX_THREAD_COUNT + 1];
+	for (uint32_t i = 0; i <= threadCount; i++)
+	{
+		bounds[i] = list->size / threadCount * i + 
+			list->size % threadCount * i / threadCount;
+	}
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		tasks[i].merge = ALF_FALSE;
+		tasks[i].begin0 = list->buffer + bounds[i] * objectSize;
+		tasks[i].end0 = list->buffer + bounds[i + 1] * objectSize;
+		tasks[i].destination = scratch + bounds[i] * objectSize;
+	}
+	alfArrayListRunParallel(tasks, threadCount);
+
+	// Merge pairs of runs until one remains. Each merge is divided into parts
+	// of equal output size, so that all threads are used in every round. An 
+	// odd run is moved by a merge with an empty run
+	uint8_t* source = list->buffer;
+	uint8_t* destination = scratch;
+	uint32_t runCount = threadCount;
+	while (runCount > 1)
+	{
+		const uint32_t pairCount = runCount / 2;
+		const uint32_t partCount = 
+			threadCount / pairCount ? threadCount / pairCount : 1;
+		uint32_t mergeCount = 0;
+		for (uint32_t pair = 0; pair < pairCount; pair++)
+		{
+			const uint64_t begin = bounds[pair * 2];
+			const uint64_t middle = bounds[pair * 2 + 1];
+			const uint64_t end = bounds[pair * 2 + 2];
+			uint64_t previousCount = 0;
+			uint64_t previousSplit = 0;
+			for (uint32_t part = 1; part <= partCount; part++)
+			{
+				const uint64_t count = (end - begin) / partCount * part + 
+					(end - begin) % partCount * part / partCount;
+				const uint64_t split = part == partCount ? middle - begin :
+					alfArrayListMergeSplit(&tasks->context, 
+						source + begin * objectSize, middle - begin, 
+						source + middle * objectSize, end - middle, count);
+				AlfArrayListParallelTask* task = &tasks[mergeCount++];
+				task->merge = ALF_TRUE;
+				task->begin0 = source + (begin + previousSplit) * objectSize;
+				task->end0 = source + (begin + split) * objectSize;
+				task->begin1 = 
+					source + (middle + previousCount - previousSplit) * objectSize;
+				task->end1 = source + (middle + count - split) * objectSize;
+				task->destination = 
+					destination + (begin + previousCount) * objectSize;
+				previousCount = count;
+				previousSplit = split;
+			}
+			bounds[pair] = begin;
+		}
+		if (runCount % 2)
+		{
+			AlfArrayListParallelTask* task = &tasks[mergeCount++];
+			task->merge = ALF_TRUE;
+			task->begin0 = source + bounds[runCount - 1] * objectSize;
+			task->end0 = source + bounds[runCount] * objectSize;
+			task->begin1 = task->end0;
+			task->end1 = task->end0;
+			task->destination = destination + bounds[runCount - 1] * objectSize;
+			bounds[pairCount] = bounds[runCount - 1];
+		}
+		alfArrayListRunParallel(tasks, mergeCount);
+
+		runCount = (runCount + 1) / 2;
+		bounds[runCount] = list->size;
+		uint8_t* swap = source;
+		source = destination;
+		destination = swap;
+	}
+
+	// Keep the buffer that holds the result
+	if (source != list->buffer)
+	{
+		alfAllocatorFree(&list->allocator, list->buffer, bufferSize);
+		list->buffer = source;
+	}
+	else
+	{
+		alfAllocatorFree(&list->allocator, scratch, bufferSize);
+	}
+	alfAllocatorFree(&list->allocator, temps, (uint64_t)objectSize * taskCount);
+	alfAllocatorFree(&list->allocator, tasks, 
+		sizeof(AlfArrayListParallelTask) * taskCount);
+	return ALF_TRUE;
+}
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// ArrayList Parallel Functions
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+void alfArrayListSortParallel(
+	AlfArrayList* list,
+	PFN_AlfCollectionCompare compareFunction,
+	uint32_t threadCount)
+{
+	if (list->size < 2) { return; }
+	if (!alfArrayListSortParallelRuns(
+		list, compareFunction, threadCount, ALF_FALSE))
+	{
+		alfArrayListSort(list, compareFunction);
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfArrayListSortParallelStable(
+	AlfArrayList* list,
+	PFN_AlfCollectionCompare compareFunction,
+	uint32_t threadCount)
+{
+	if (list->size < 2) { return ALF_TRUE; }
+	return alfArrayListSortParallelRuns(
+		list, compareFunction, threadCount, ALF_TRUE);
+}
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// EytzingerArray Structures
+// ========================================================================== //
+
+/** Number of tree levels that an Eytzinger array search prefetches ahead. The
+ * descendants of a node at this depth are consecutive in memory **/
+#define ALF_EYTZINGER_ARRAY_PREFETCH_DEPTH 4
+
+// -------------------------------------------------------------------------- //
+
+typedef struct tag_AlfEytzingerArray
+{
+	/** Size of each object **/
+	uint32_t objectSize;
+	/** Number of objects **/
+	uint64_t size;
+
+	/** Objects in breadth-first order of the search tree. The root is at index
+	 * one and the children of index i are at 2i and 2i + 1 **/
+	uint8_t* objects;
+	/** Index in the sorted list of each object **/
+	uint64_t* ranks;
+
+	/** Allocator **/
+	AlfAllocator allocator;
+} tag_AlfEytzingerArray;
+
+// ========================================================================== //
+// EytzingerArray Private Functions
+// ========================================================================== //
+
+/** Place the objects of a sorted array-list in an Eytzinger array by an 
+ * in-order traversal of the tree, starting at node 'node'. Returns the index 
+ * of the next object of the list to place **/
+static uint64_t alfEytzingerArrayFill(
+	AlfEytzingerArray* array,
+	const AlfArrayList* list,
+	uint64_t node,
+	uint64_t next)
+{
+	if (node > array->size) { return next; }
+	next = alfEytzingerArrayFill(array, list, node * 2, next);
+	memcpy(array->objects + node * array->objectSize, 
+		list->buffer + next * array->objectSize, array->objectSize);
+	array->ranks[node] = next++;
+	return alfEytzingerArrayFill(array, list, node * 2 + 1, next);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the node of the first object that is not less than an object, or 
+ * zero if there is none. The search descends to a leaf, going right when the
+ * node is less than the object. The answer is the node where the search last 
+ * went left, which is found by removing the trailing right turns and the final
+ * left turn from the path **/
+static uint64_t alfEytzingerArraySearch(
+	const AlfEytzingerArray* array,
+	const void* object,
+	PFN_AlfCollectionCompare compare)
+{
+	const uint32_t size = array->objectSize;
+	const uint64_t prefetchStride = 1ull << ALF_EYTZINGER_ARRAY_PREFETCH_DEPTH;
+	uint64_t node = 1;
+	while (node <= array->size)
+	{
+		if (node * prefetchStride <= array->size)
+		{
+			ALF_COLLECTION_PREFETCH(
+				array->objects + node * prefetchStride * size);
+		}
+		node = node * 2 + 
+			(compare(array->objects + node * size, object) < 0);
+	}
+	return node >> (alfCountTrailingZeros64(~node) + 1);
+}
+
+// ========================================================================== //
+// EytzingerArray Functions
+// ========================================================================== //
+
+AlfEytzingerArray* alfCreateEytzingerArray(const AlfArrayList* list)
+{
+	const AlfAllocator* allocator = &list->allocator;
+	AlfEytzingerArray* array = 
+		alfAllocatorAlloc(allocator, sizeof(AlfEytzingerArray));
+	if (!array) { return NULL; }
+	array->allocator = *allocator;
+	array->objectSize = list->objectSize;
+	array->size = list->size;
+
+	// Index zero is not used, which keeps the child indices simple
+	array->objects = alfAllocatorAlloc(
+		allocator, (list->size + 1) * list->objectSize);
+	array->ranks = 
+		alfAllocatorAlloc(allocator, (list->size + 1) * sizeof(uint64_t));
+	if (!array->objects || !array->ranks)
+	{
+		alfDestroyEytzingerArray(array);
+		return NULL;
+	}
+	alfEytzingerArrayFill(array, list, 1, 0);
+	return array;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfDestroyEytzingerArray(AlfEytzingerArray* array)
+{
+	const AlfAllocator allocator = array->allocator;
+	alfAllocatorFree(&allocator, array->ranks, 
+		(array->size + 1) * sizeof(uint64_t));
+	alfAllocatorFree(&allocator, array->objects, 
+		(array->size + 1) * array->objectSize);
+	alfAllocatorFree(&allocator, array, sizeof(AlfEytzingerArray));
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfEytzingerArrayLowerBound(
+	const AlfEytzingerArray* array,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction)
+{
+	const uint64_t node = 
+		alfEytzingerArraySearch(array, object, compareFunction);
+	return node ? array->ranks[node] : array->size;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfEytzingerArrayFind(
+	const AlfEytzingerArray* array,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction,
+	uint64_t* indexOut)
+{
+	const uint64_t node = 
+		alfEytzingerArraySearch(array, object, compareFunction);
+	if (!node || 
+		compareFunction(array->objects + node * array->objectSize, object) != 0)
+	{
+		return ALF_FALSE;
+	}
+	if (indexOut) { *indexOut = array->ranks[node]; }
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfEytzingerArrayGetSize(const AlfEytzingerArray* array)
+{
+	return array->size;
+}
+
+// ========================================================================== //
+// Stack Structures
+// ========================================================================== //
+
+typedef struct tag_AlfStack
+{
+	/** Capacity **/
+	uint32_t capacity;
+	/** Stack size**/
+	uint32_t size;
+	/** Data buffer **/
+	uint8_t* buffer;
+
+	/** Object size**/
+	uint32_t objectSize;
+
+	/** Object cleaner **/
+	PFN_AlfCollectionCleaner objectCleaner;
+
+	/** Allocator **/
+	AlfAllocator allocator;
+} tag_AlfStack;
+
+// ========================================================================== //
+// Stack Functions
+// ========================================================================== //
+
+AlfStack* alfCreateStack(const AlfStackDesc* desc)
+{
+	ALF_COLLECTION_ASSERT(
+		desc->objectSize != 0,
+		"Size of objects in stack must be greater than zero"
+	);
+
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfStack* stack = alfAllocatorAlloc(&allocator, sizeof(AlfStack));
+	if (!stack) { return NULL; }
+
+	stack->allocator = allocator;
+	stack->capacity = 
+		desc->capacity ? desc->capacity : ALF_LIST_DEFAULT_CAPACITY;
+	stack->size = 0;
+	stack->objectSize = desc->objectSize;
+	stack->objectCleaner = 
+		desc->objectCleaner ? desc->objectCleaner : alfDefaultCleaner;
+	stack->buffer = alfAllocatorAlloc(
+		&allocator, (uint64_t)stack->objectSize * stack->capacity);
+	if (!stack->buffer)
+	{
+		alfAllocatorFree(&allocator, stack, sizeof(AlfStack));
+		return NULL;
+	}
+
+	return stack;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfDestroyStack(AlfStack* stack)
+{
+	for (uint32_t i = 0; i < stack->size; i++)
+	{
+		void* object = stack->buffer + (stack->objectSize * i);
+		stack->objectCleaner(object);
+	}
+	const AlfAllocator allocator = stack->allocator;
+	alfAllocatorFree(&allocator, stack->buffer, 
+		(uint64_t)stack->objectSize * stack->capacity);
+	alfAllocatorFree(&allocator, stack, sizeof(AlfStack));
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfStackPush(AlfStack* stack, const void* object)
+{
+	if (stack->capacity <= stack->size)
+	{
+		const AlfBool success = alfStackResize(stack, stack->capacity * 2);
+		if (!success) { return ALF_FALSE; }
+	}
+	memcpy(
+		stack->buffer + (stack->objectSize * stack->size++), 
+		object, 
+		stack->objectSize
+	);
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfStackPop(AlfStack* stack, void* objectOut)
+{
+	if (stack->size < 1) { return ALF_FALSE; }
+	memcpy(
+		objectOut,
+		stack->buffer + (stack->objectSize * --stack->size),
+		stack->objectSize
+	);
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfStackResize(AlfStack* stack, uint32_t size)
+{
+	// Clean objects that are after end of resized buffer
+	for (uint32_t i = size; i < stack->size; i++)
+	{
+		void* object = stack->buffer + (stack->objectSize * i);
+		stack->objectCleaner(object);
+	}
+	stack->size = ALF_COLLECTION_MIN(size, stack->size);
+
+	// Resize buffer, which always holds at least one object so that it can 
+	// grow again. A buffer that could not be shrunk is kept as it is
+	const uint32_t capacity = size ? size : 1;
+	uint8_t* buffer = alfAllocatorRealloc(&stack->allocator, stack->buffer, 
+		(uint64_t)stack->objectSize * stack->capacity, 
+		(uint64_t)stack->objectSize * capacity);
+	if (!buffer) { return capacity <= stack->capacity; }
+	stack->buffer = buffer;
+	stack->capacity = capacity;
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t alfStackGetSize(AlfStack* stack)
+{
+	return stack->size;
+}
+
+// ========================================================================== //
+// Filter Structures
+// ========================================================================== //
+
+/** Number of 64-bit words in a block of a blocked Bloom filter. A block is one
+ * cache line, and each key sets one bit in each word of its block **/
+#define ALF_FILTER_BLOCK_WORDS 8
+
+// -------------------------------------------------------------------------- //
+
+/** Default number of bits per key of a blocked Bloom filter **/
+#define ALF_FILTER_DEFAULT_BITS_PER_KEY 12
+
+// -------------------------------------------------------------------------- //
+
+/** Number of fingerprints in a bucket of a cuckoo filter **/
+#define ALF_FILTER_CUCKOO_SLOTS 4
+
+// -------------------------------------------------------------------------- //
+
+/** Maximum number of fingerprints that are kicked to their alternate bucket 
+ * before a cuckoo filter is considered full **/
+#define ALF_FILTER_CUCKOO_MAX_KICKS 500
+
+// -------------------------------------------------------------------------- //
+
+/** Filter structure **/
+typedef struct tag_AlfFilter
+{
+	/** Type of filter **/
+	AlfFilterType type;
+	/** Blocks of a blocked Bloom filter, or buckets of four 16-bit fingerprints
+	 * of a cuckoo filter. Aligned to a cache line **/
+	uint64_t* words;
+	/** Allocated memory that the words are placed in **/
+	void* memory;
+	/** Number of blocks or buckets. Always a power of two for cuckoo filters **/
+	uint64_t blockCount;
+	/** Number of keys that the filter was sized for **/
+	uint64_t capacity;
+	/** Number of keys in the filter **/
+	uint64_t size;
+	/** Bits per key of a blocked Bloom filter **/
+	uint32_t bitsPerKey;
+
+	/** Whether a cuckoo filter holds a fingerprint that did not fit **/
+	AlfBool hasVictim;
+	/** Fingerprint that did not fit **/
+	uint16_t victimFingerprint;
+	/** Bucket index of the fingerprint that did not fit **/
+	uint64_t victimIndex;
+	/** State of the generator that picks which fingerprint to kick **/
+	uint64_t kickState;
+
+	/** Size of keys in bytes, zero for null-terminated strings **/
+	uint32_t keySize;
+	/** Hash function **/
+	PFN_AlfCollectionHash hashFunction;
+	/** 64-bit hash function **/
+	PFN_AlfCollectionHash64 hashFunction64;
+	/** Seed of the built-in hash **/
+	uint64_t hashSeed;
+
+	/** Allocator **/
+	AlfAllocator allocator;
+} tag_AlfFilter;
+
+// ========================================================================== //
+// Filter Private Functions
+// ========================================================================== //
+
+/** Returns the size in bytes of the memory of a filter, which has room to 
+ * align the words to a cache line **/
+static uint64_t alfFilterGetMemorySize(const AlfFilter* filter)
+{
+	const uint64_t wordCount = filter->type == ALF_FILTER_TYPE_CUCKOO ? 
+		filter->blockCount : filter->blockCount * ALF_FILTER_BLOCK_WORDS;
+	return wordCount * sizeof(uint64_t) + 64;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns a hash that is mixed so that every bit depends on every bit of the
+ * key hash. Hashes of 32-bit hash functions, that have been spread over 64 
+ * bits by a multiplication, otherwise keep their low bits **/
+static uint64_t alfFilterMix(uint64_t hash)
+{
+	hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+	hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+	return hash ^ (hash >> 31);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the block of a blocked Bloom filter that a mixed hash belongs to. 
+ * The high 32 bits select the block and the low 32 bits select the bits **/
+static uint64_t* alfFilterGetBlock(AlfFilter* filter, uint64_t mixed)
+{
+	const uint64_t block = ((mixed >> 32) * filter->blockCount) >> 32;
+	return filter->words + block * ALF_FILTER_BLOCK_WORDS;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the bit that a mixed hash sets in a word of its block. Each word
+ * uses a different odd multiplier, as in split block Bloom filters **/
+static uint64_t alfFilterGetBlockBit(uint64_t mixed, uint32_t word)
+{
+	static const uint32_t salts[ALF_FILTER_BLOCK_WORDS] = {
+		0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 
+		0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+	};
+	return 1ull << (((uint32_t)mixed * salts[word]) >> 26);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the fingerprint of a mixed hash for a cuckoo filter. Zero marks an
+ * empty slot, so it is never returned **/
+static uint16_t alfFilterGetFingerprint(uint64_t mixed)
+{
+	const uint16_t fingerprint = (uint16_t)(mixed >> 48);
+	return fingerprint ? fingerprint : 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the alternate bucket of a fingerprint in a cuckoo filter. Applying
+ * this to the alternate bucket gives back the first bucket **/
+static uint64_t alfFilterGetAlternateIndex(
+	AlfFilter* filter,
+	uint64_t index,
+	uint16_t fingerprint)
+{
+	return (index ^ ((uint64_t)fingerprint * 0x5bd1e995u)) & 
+		(filter->blockCount - 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a bucket of a cuckoo filter holds a fingerprint. All four 
+ * slots are compared at once by looking for a zero 16-bit lane **/
+static AlfBool alfFilterBucketHas(uint64_t bucket, uint16_t fingerprint)
+{
+	const uint64_t lanes = 0x0001000100010001ull;
+	const uint64_t x = bucket ^ (fingerprint * lanes);
+	return ((x - lanes) & ~x & (lanes << 15)) != 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Add a fingerprint to a free slot of a cuckoo filter bucket. Returns false 
+ * if the bucket is full **/
+static AlfBool alfFilterBucketAdd(
+	AlfFilter* filter, 
+	uint64_t index, 
+	uint16_t fingerprint)
+{
+	uint64_t* bucket = &filter->words[index];
+	for (uint32_t slot = 0; slot < ALF_FILTER_CUCKOO_SLOTS; slot++)
+	{
+		const uint32_t shift = slot * 16;
+		if (((*bucket >> shift) & 0xffff) == 0)
+		{
+			*bucket |= (uint64_t)fingerprint << shift;
+			return ALF_TRUE;
+		}
+	}
+	return ALF_FALSE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Remove one copy of a fingerprint from a cuckoo filter bucket. Returns false
+ * if the bucket does not hold the fingerprint **/
+static AlfBool alfFilterBucketRemove(
+	AlfFilter* filter, 
+	uint64_t index, 
+	uint16_t fingerprint)
+{
+	uint64_t* bucket = &filter->words[index];
+	for (uint32_t slot = 0; slot < ALF_FILTER_CUCKOO_SLOTS; slot++)
+	{
+		const uint32_t shift = slot * 16;
+		if (((*bucket >> shift) & 0xffff) == fingerprint)
+		{
+			*bucket &= ~(0xffffull << shift);
+			return ALF_TRUE;
+		}
+	}
+	return ALF_FALSE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Place a fingerprint in either of its buckets of a cuckoo filter, kicking
+ * fingerprints to their alternate buckets to make room. A fingerprint that is
+ * left without room is kept as the victim, after which the filter is full **/
+static void alfFilterCuckooPlace(
+	AlfFilter* filter, 
+	uint64_t index, 
+	uint16_t fingerprint)
+{
+	if (alfFilterBucketAdd(filter, index, fingerprint)) { return; }
+	index = alfFilterGetAlternateIndex(filter, index, fingerprint);
+	if (alfFilterBucketAdd(filter, index, fingerprint)) { return; }
+	for (uint32_t kick = 0; kick < ALF_FILTER_CUCKOO_MAX_KICKS; kick++)
+	{
+		// Swap with a random slot of the bucket and move the kicked one
+		filter->kickState ^= filter->kickState << 13;
+		filter->kickState ^= filter->kickState >> 7;
+		filter->kickState ^= filter->kickState << 17;
+		const uint32_t shift = 
+			(uint32_t)(filter->kickState % ALF_FILTER_CUCKOO_SLOTS) * 16;
+		uint64_t* bucket = &filter->words[index];
+		const uint16_t kicked = (uint16_t)(*bucket >> shift);
+		*bucket = (*bucket & ~(0xffffull << shift)) | 
+			((uint64_t)fingerprint << shift);
+		fingerprint = kicked;
+		index = alfFilterGetAlternateIndex(filter, index, fingerprint);
+		if (alfFilterBucketAdd(filter, index, fingerprint)) { return; }
+	}
+	filter->hasVictim = ALF_TRUE;
+	filter->victimFingerprint = fingerprint;
+	filter->victimIndex = index;
+}
+
+// ========================================================================== //
+// Filter Functions
+// ========================================================================== //
+
+AlfFilter* alfCreateFilter(const AlfFilterDesc* desc)
+{
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfFilter* filter = alfAllocatorAlloc(&allocator, sizeof(AlfFilter));
+	if (!filter) { return NULL; }
+	filter->allocator = allocator;
+	filter->type = desc->type;
+	filter->capacity = desc->capacity ? desc->capacity : 1;
+	filter->size = 0;
+	filter->bitsPerKey = desc->bitsPerKey ? 
+		desc->bitsPerKey : ALF_FILTER_DEFAULT_BITS_PER_KEY;
+	filter->keySize = desc->keySize;
+	filter->hashFunction = desc->hashFunction;
+	filter->hashFunction64 = desc->hashFunction64;
+	filter->hashSeed = desc->hashSeed;
+
+	// Size blocks for the bits per key, or buckets for a load factor of 95%
+	if (filter->type == ALF_FILTER_TYPE_CUCKOO)
+	{
+		const uint64_t slotCount = filter->capacity + filter->capacity / 19 + 1;
+		filter->blockCount = 1;
+		while (filter->blockCount * ALF_FILTER_CUCKOO_SLOTS < slotCount)
+		{
+			filter->blockCount <<= 1;
+		}
+	}
+	else
+	{
+		const uint64_t bitCount = filter->capacity * filter->bitsPerKey;
+		const uint64_t blockBits = ALF_FILTER_BLOCK_WORDS * 64;
+		filter->blockCount = (bitCount + blockBits - 1) / blockBits;
+		if (filter->blockCount > UINT32_MAX) { filter->blockCount = UINT32_MAX; }
+	}
+
+	// Align words to a cache line, so that a block is read in one line
+	filter->memory = 
+		alfAllocatorAlloc(&allocator, alfFilterGetMemorySize(filter));
+	if (!filter->memory)
+	{
+		alfAllocatorFree(&allocator, filter, sizeof(AlfFilter));
+		return NULL;
+	}
+	filter->words = (uint64_t*)(((uintptr_t)filter->memory + 63) & 
+		~(uintptr_t)63);
+	alfFilterClear(filter);
+	return filter;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfDestroyFilter(AlfFilter* filter)
+{
+	const AlfAllocator allocator = filter->allocator;
+	alfAllocatorFree(
+		&allocator, filter->memory, alfFilterGetMemorySize(filter));
+	alfAllocatorFree(&allocator, filter, sizeof(AlfFilter));
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfFilterGetKeyHash(AlfFilter* filter, const void* key)
+{
+	uint64_t hash;
+	if (filter->hashFunction64)
+	{
+		hash = filter->hashFunction64(key);
+	}
+	else if (filter->hashFunction)
+	{
+		hash = (uint64_t)filter->hashFunction(key) * 0x9e3779b97f4a7c15ull;
+	}
+	else
+	{
+		const uint64_t size = 
+			filter->keySize ? filter->keySize : strlen((const char*)key);
+		hash = alfHash64(key, size, filter->hashSeed);
+	}
+	return hash ? hash : 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfFilterInsert(AlfFilter* filter, const void* key)
+{
+	return alfFilterInsertHash(filter, alfFilterGetKeyHash(filter, key));
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfFilterInsertHash(AlfFilter* filter, uint64_t hash)
+{
+	const uint64_t mixed = alfFilterMix(hash);
+	if (filter->type != ALF_FILTER_TYPE_CUCKOO)
+	{
+		uint64_t* block = alfFilterGetBlock(filter, mixed);
+		for (uint32_t i = 0; i < ALF_FILTER_BLOCK_WORDS; i++)
+		{
+			block[i] |= alfFilterGetBlockBit(mixed, i);
+		}
+		filter->size++;
+		return ALF_TRUE;
+	}
+
+	// A full cuckoo filter accepts no more keys
+	if (filter->hasVictim) { return ALF_FALSE; }
+	alfFilterCuckooPlace(filter, mixed & (filter->blockCount - 1), 
+		alfFilterGetFingerprint(mixed));
+	filter->size++;
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfFilterMayContain(AlfFilter* filter, const void* key)
+{
+	return alfFilterMayContainHash(filter, alfFilterGetKeyHash(filter, key));
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfFilterMayContainHash(AlfFilter* filter, uint64_t hash)
+{
+	const uint64_t mixed = alfFilterMix(hash);
+	if (filter->type != ALF_FILTER_TYPE_CUCKOO)
+	{
+		const uint64_t* block = alfFilterGetBlock(filter, mixed);
+		uint64_t missing = 0;
+		for (uint32_t i = 0; i < ALF_FILTER_BLOCK_WORDS; i++)
+		{
+			const uint64_t bit = alfFilterGetBlockBit(mixed, i);
+			missing |= (block[i] & bit) ^ bit;
+		}
+		return missing == 0;
+	}
+
+	const uint16_t fingerprint = alfFilterGetFingerprint(mixed);
+	const uint64_t index = mixed & (filter->blockCount - 1);
+	const uint64_t alternate = 
+		alfFilterGetAlternateIndex(filter, index, fingerprint);
+	return alfFilterBucketHas(filter->words[index], fingerprint) ||
+		alfFilterBucketHas(filter->words[alternate], fingerprint) ||
+		(filter->hasVictim && filter->victimFingerprint == fingerprint &&
+		(filter->victimIndex == index || filter->victimIndex == alternate));
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfFilterRemove(AlfFilter* filter, const void* key)
+{
+	return alfFilterRemoveHash(filter, alfFilterGetKeyHash(filter, key));
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfFilterRemoveHash(AlfFilter* filter, uint64_t hash)
+{
+	if (filter->type != ALF_FILTER_TYPE_CUCKOO) { return ALF_FALSE; }
+
+	// Remove the fingerprint from either bucket or from the victim
+	const uint64_t mixed = alfFilterMix(hash);
+	const uint16_t fingerprint = alfFilterGetFingerprint(mixed);
+	const uint64_t index = mixed & (filter->blockCount - 1);
+	const uint64_t alternate = 
+		alfFilterGetAlternateIndex(filter, index, fingerprint);
+	if (filter->hasVictim && filter->victimFingerprint == fingerprint &&
+		(filter->victimIndex == index || filter->victimIndex == alternate))
+	{
+		filter->hasVictim = ALF_FALSE;
+	}
+	else if (!alfFilterBucketRemove(filter, index, fingerprint) &&
+		!alfFilterBucketRemove(filter, alternate, fingerprint))
+	{
+		return ALF_FALSE;
+	}
+	filter->size--;
+
+	// The removal may have made room for the victim
+	if (filter->hasVictim)
+	{
+		filter->hasVictim = ALF_FALSE;
+		alfFilterCuckooPlace(
+			filter, filter->victimIndex, filter->victimFingerprint);
+	}
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfFilterClear(AlfFilter* filter)
+{
+	const uint64_t wordCount = filter->type == ALF_FILTER_TYPE_CUCKOO ?
+		filter->blockCount : filter->blockCount * ALF_FILTER_BLOCK_WORDS;
+	memset(filter->words, 0, wordCount * sizeof(uint64_t));
+	filter->size = 0;
+	filter->hasVictim = ALF_FALSE;
+	filter->kickState = 0x2545f4914f6cdd1dull;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfFilterGetSize(AlfFilter* filter)
+{
+	return filter->size;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfFilterGetCapacity(AlfFilter* filter)
+{
+	return filter->capacity;
+}
+
+// ========================================================================== //
+// HashTable Structures
+// ========================================================================== //
+
+/** Header of a single hash table bucket. The value is stored after the header 
+ * at the value offset of the table. Tables with inline keys store the key bytes
+ * at the key offset of the table instead of the key pointer **/
+typedef struct AlfHashTableBucket
+{
+	/** Cached hash value **/
+	uint64_t hash;
+	/** Key pointer. Only used by tables that do not store keys inline **/
+	void* key;
+} AlfHashTableBucket;
+
+// -------------------------------------------------------------------------- //
+
+/** Chunk of memory in the string arena of a hash table **/
+typedef struct AlfHashTableArenaChunk
+{
+	/** Next chunk **/
+	struct AlfHashTableArenaChunk* next;
+	/** Number of bytes used **/
+	uint64_t size;
+	/** Capacity in bytes **/
+	uint64_t capacity;
+	/** Key data **/
+	uint8_t data[];
+} AlfHashTableArenaChunk;
+
+// -------------------------------------------------------------------------- //
+
+/** Hash table structure **/
+typedef struct tag_AlfHashTable
+{
+	/** Bucket count **/
+	uint64_t bucketCount;
+	/** Current entry count**/
+	uint64_t size;
+	/** buckets **/
+	uint8_t* buckets;
+	/** Size of a bucket in bytes **/
+	uint32_t bucketSize;
+	/** Maximum load factor **/
+	float maxLoadFactor;
+
+	/** Memory layout **/
+	AlfHashTableLayout layout;
+	/** Pages that large bucket arrays are allocated on **/
+	AlfHashTablePages pages;
+	/** Control bytes, one per bucket. Only used by the control byte layout **/
+	uint8_t* control;
+	/** Number of deleted control bytes. Only used by the control byte layout **/
+	uint64_t deletedCount;
+
+	/** Size of value object in bytes **/
+	uint32_t valueSize;
+	/** Size of inline keys in bytes, zero if keys are stored by pointer **/
+	uint32_t keySize;
+	/** Offset of inline key in each bucket **/
+	uint32_t keyOffset;
+	/** Offset of value in each bucket **/
+	uint32_t valueOffset;
+
+	/** Storage of keys that are not inline **/
+	AlfHashTableKeyStorage keyStorage;
+	/** Chunks of the string arena, the first chunk is allocated from **/
+	AlfHashTableArenaChunk* arenaChunks;
+	/** Number of bytes allocated from the string arena **/
+	uint64_t arenaUsedBytes;
+	/** Number of allocated bytes that belong to removed keys **/
+	uint64_t arenaDeadBytes;
+
+	/** Number of old buckets migrated by each operation during an incremental
+	 * resize. Zero if resizing is not incremental **/
+	uint32_t migrateStep;
+	/** Old bucket count, zero if no incremental resize is in progress **/
+	uint64_t oldBucketCount;
+	/** Old buckets that remain to be migrated **/
+	uint8_t* oldBuckets;
+	/** Old control bytes **/
+	uint8_t* oldControl;
+	/** Index of the first old bucket that was migrated **/
+	uint64_t migrateStart;
+	/** Number of old buckets that have been migrated **/
+	uint64_t migrateCount;
+
+	/** Whether automatic shrinking is enabled **/
+	AlfBool automaticShrink;
+	/** Load factor below which the table is shrunk **/
+	float minLoadFactor;
+	/** Bucket count that the table is never shrunk below **/
+	uint64_t minBucketCount;
+
+	/** Filter of the keys in the table, NULL if no filter is maintained **/
+	AlfFilter* filter;
+	/** Number of removed keys that are still set in a Bloom filter **/
+	uint64_t filterStaleCount;
+	/** Allocator of the table, its buckets, string arena and filter **/
+	AlfAllocator allocator;
+
+	/** Hash function  **/
+	PFN_AlfCollectionHash hashFunction;
+	/** 64-bit hash function **/
+	PFN_AlfCollectionHash64 hashFunction64;
+	/** Seed of the built-in hash **/
+	uint64_t hashSeed;
+	/** Address that key offsets are relative to. Zero unless the table is 
+	 * mapped from a snapshot, where keys are stored as offsets **/
+	uintptr_t keyBase;
+	/** Mapped snapshot memory. Tables that are mapped are read-only **/
+	uint8_t* mapping;
+	/** Size of mapped snapshot memory in bytes **/
+	uint64_t mappingSize;
+	/** Key equality function **/
+	PFN_AlfCollectionEqual keyEqual;
+	/** Key copy function **/
+	PFN_AlfCollectionCopy keyCopy;
+	/** Key destructor **/
+	PFN_AlfCollectionDestructor keyDestructor;
+	/** Value cleaner **/
+	PFN_AlfCollectionCleaner valueCleaner;
+
+#if defined(ALF_COLLECTION_STATISTICS)
+	/** Statistics gathered by operations on the table **/
+	AlfHashTableStatistics statistics;
+#endif
+} tag_AlfHashTable;
+
+// -------------------------------------------------------------------------- //
+
+/** Header at the start of a hash table snapshot file. The bucket array, the
+ * control bytes and the keys follow in separate sections. Keys that are not 
+ * inline are stored in the key section and buckets store the offset of their
+ * key from the start of the file in place of the key pointer **/
+typedef struct AlfHashTableSnapshotHeader
+{
+	/** Magic number **/
+	uint64_t magic;
+	/** Format version **/
+	uint32_t version;
+	/** Memory layout **/
+	uint32_t layout;
+	/** Bucket count **/
+	uint64_t bucketCount;
+	/** Entry count **/
+	uint64_t size;
+	/** Size of a bucket in bytes **/
+	uint32_t bucketSize;
+	/** Size of inline keys in bytes **/
+	uint32_t keySize;
+	/** Size of values in bytes **/
+	uint32_t valueSize;
+	/** Kind of hash function, see alfHashTableGetHashKind **/
+	uint32_t hashKind;
+	/** Seed of the built-in hash **/
+	uint64_t hashSeed;
+	/** Offset of the bucket array **/
+	uint64_t bucketOffset;
+	/** Offset of the control bytes, zero if the layout has none **/
+	uint64_t controlOffset;
+	/** Offset of the keys **/
+	uint64_t keyOffset;
+} AlfHashTableSnapshotHeader;
+
+// ========================================================================== //
+// HashTable Macro Declarations
+// ========================================================================== //
+
+/** Default hash-table bucket count **/
+#define ALF_DEFAULT_HASH_TABLE_BUCKET_COUNT (1 << 5)
+
+// -------------------------------------------------------------------------- //
+
+/** Default load factor to trigger resize of hash-table **/
+#define ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_RESIZE 0.8f
+
+// -------------------------------------------------------------------------- //
+
+/** Default load factor to trigger shrinking of hash-table. This is well below
+ * half of the resize trigger so that a shrunk table does not grow right away **/
+#define ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_SHRINK 0.2f
+
+// -------------------------------------------------------------------------- //
+
+/** Minimum number of old buckets that are migrated by each operation during an
+ * incremental resize **/
+#define ALF_HASH_TABLE_MIN_MIGRATE_STEP 2
+
+// -------------------------------------------------------------------------- //
+
+/** Number of keys that are hashed and prefetched together in a batch lookup **/
+#define ALF_HASH_TABLE_BATCH_SIZE 64
+
+// -------------------------------------------------------------------------- //
+
+/** Number of removed keys that a Bloom filter of a hash table always keeps 
+ * before it is rebuilt, so that small tables are not rebuilt too often **/
+#define ALF_HASH_TABLE_MIN_FILTER_STALE_COUNT 64
+
+// -------------------------------------------------------------------------- //
+
+/** Largest capacity of the filter of a hash table, as a multiple of the number
+ * of entries. A cuckoo filter that does not fit the entries at this capacity
+ * holds too many entries with the same hash, which no capacity can fit **/
+#define ALF_HASH_TABLE_MAX_FILTER_CAPACITY_FACTOR 8
+
+// -------------------------------------------------------------------------- //
+
+/** Minimum size of a chunk in the string arena of a hash-table **/
+#define ALF_HASH_TABLE_ARENA_CHUNK_SIZE (64 * 1024)
+
+// -------------------------------------------------------------------------- //
+
+/** Alignment of values in hash-table buckets **/
+#define ALF_HASH_TABLE_VALUE_ALIGNMENT 8
+
+// -------------------------------------------------------------------------- //
+
+/** Macro to align a size up to a multiple of a power of two **/
+#define ALF_ALIGN_POWER_OF_TWO(x, y) (((x) + ((y) - 1)) & ~((y) - 1))
+
+// -------------------------------------------------------------------------- //
+
+/** Macro to check if power of two **/
+#define ALF_IS_POWER_OF_TWO(num) (num && !(num & (num - 1)))
+
+// -------------------------------------------------------------------------- //
+
+/** Macro to perform modulo calculation where y is a power of two **/
+#define ALF_MOD_POWER_OF_TWO(x, y) ((x) & ((y) - 1))
+
+// -------------------------------------------------------------------------- //
+
+/** Number of control bytes that are probed together as one group **/
+#define ALF_HASH_TABLE_GROUP_WIDTH 16
+
+// -------------------------------------------------------------------------- //
+
+/** Size of a huge page in bytes. Bucket arrays smaller than this are never
+ * placed on huge pages **/
+#define ALF_HASH_TABLE_HUGE_PAGE_SIZE (2ull << 20)
+
+// -------------------------------------------------------------------------- //
+
+/** Control byte of an empty bucket **/
+#define ALF_HASH_TABLE_CONTROL_EMPTY ((uint8_t)0x80)
+
+// -------------------------------------------------------------------------- //
+
+/** Control byte of a deleted bucket. Probing continues past deleted buckets **/
+#define ALF_HASH_TABLE_CONTROL_DELETED ((uint8_t)0xFE)
+
+// -------------------------------------------------------------------------- //
+
+/** Record the probe length of a lookup in the statistics of a table. Compiles
+ * to nothing unless statistics are enabled **/
+#if defined(ALF_COLLECTION_STATISTICS)
+#	define ALF_HASH_TABLE_RECORD_PROBE(table, hit, length) \
+		alfHashTableRecordProbe(table, hit, length)
+#else
+#	define ALF_HASH_TABLE_RECORD_PROBE(table, hit, length) ((void)(length))
+#endif
+
+// -------------------------------------------------------------------------- //
+
+/** Start a timer for a resize and record the resize in the statistics of a 
+ * table. Compiles to nothing unless statistics are enabled **/
+#if defined(ALF_COLLECTION_STATISTICS)
+#	define ALF_HASH_TABLE_START_RESIZE_TIMER(name) \
+		const uint64_t name = alfHashTableGetTime()
+#	define ALF_HASH_TABLE_RECORD_RESIZE(table, startTime, count) \
+		alfHashTableRecordResize(table, startTime, count)
+#else
+#	define ALF_HASH_TABLE_START_RESIZE_TIMER(name) ((void)0)
+#	define ALF_HASH_TABLE_RECORD_RESIZE(table, startTime, count) ((void)0)
+#endif
+
+// -------------------------------------------------------------------------- //
+
+/** Magic number at the start of hash table snapshot files ("ALFHTSNP") **/
+#define ALF_HASH_TABLE_SNAPSHOT_MAGIC 0x504e535448464c41ull
+
+// -------------------------------------------------------------------------- //
+
+/** Version of the hash table snapshot file format **/
+#define ALF_HASH_TABLE_SNAPSHOT_VERSION 2
+
+// -------------------------------------------------------------------------- //
+
+/** Alignment of each section in a hash table snapshot file **/
+#define ALF_HASH_TABLE_SNAPSHOT_ALIGNMENT 64
+
+// -------------------------------------------------------------------------- //
+
+/** Number of buckets that are written to a snapshot file at a time **/
+#define ALF_HASH_TABLE_SNAPSHOT_BATCH_SIZE 1024
+
+// ========================================================================== //
+// HashTable Private String Functions
+// ========================================================================== //
+
+/** String copy **/
+void* alfStringCopyFunction(const void* object)
+{
+	const char* str = (const void*)object;
+	const uint64_t size = strlen(str);
+	char* buffer = ALF_COLLECTION_ALLOC(size + 1);
+	buffer[size] = 0;
+	memcpy(buffer, str, size);
+	return buffer;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** String destructor **/
+void alfStringDestructorFunction(void* object)
+{
+	char* str = (char*)object;
+	ALF_COLLECTION_FREE(str);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** String comparison **/
+AlfBool alfStringEqualFunction(const void* object0, const void* object1)
+{
+	const char* str0 = (const char*)object0;
+	const char* str1 = (const char*)object1;
+	return strcmp(str0, str1) == 0;
+}
+
+// ========================================================================== //
+// HashTable Private Functions
+// ========================================================================== //
+
+/** Returns pointer to bucket at specified index in bucket array **/
+static AlfHashTableBucket* alfHashTableGetBucketAtIndex(
+	uint8_t* buckets,
+	uint32_t bucketSize,
+	uint64_t index)
+{
+	return (AlfHashTableBucket*)(buckets + ((uint64_t)index * bucketSize));
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Creates a hash that is valid for the hash table from the hash function that
+ * the user specified at hash table creation. This function makes sure that 0 is
+ * never returned as a valid hash (Signifies empty bucket).
+ * 
+ * A 32-bit hash is multiplied by an odd constant to spread it over 64 bits. The
+ * low bits, that select buckets, then still map one-to-one to the low bits of 
+ * the hash, while the high bits that are used as fingerprint depend on all 
+ * bits. Without a hash function the built-in hash is used on the bytes of the
+ * inline key or the characters of the string key **/
+static uint64_t alfHashTableGetKeyHash(AlfHashTable* table, const void* key)
+{
+	uint64_t hash;
+	if (table->hashFunction64)
+	{
+		hash = table->hashFunction64(key);
+	}
+	else if (table->hashFunction)
+	{
+		hash = (uint64_t)table->hashFunction(key) * 0x9e3779b97f4a7c15ull;
+	}
+	else
+	{
+		const uint64_t size = 
+			table->keySize ? table->keySize : strlen((const char*)key);
+		hash = alfHash64(key, size, table->hashSeed);
+	}
+	return hash ? hash : 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns pointer to the key of a bucket. This is the stored key pointer, or
+ * the key inside the bucket for tables with inline keys **/
+static void* alfHashTableGetBucketKey(
+	AlfHashTable* table,
+	AlfHashTableBucket* bucket)
+{
+	if (table->keySize)
+	{
+		return (uint8_t*)bucket + table->keyOffset;
+	}
+	return (void*)(table->keyBase + (uintptr_t)bucket->key);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns pointer to the value of a bucket **/
+static void* alfHashTableGetBucketValue(
+	AlfHashTable* table,
+	AlfHashTableBucket* bucket)
+{
+	return (uint8_t*)bucket + table->valueOffset;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Sets the hash, key and value of a bucket. The key is stored as a pointer, or
+ * for tables with inline keys, copied into the bucket **/
+static void alfHashTableSetBucket(
+	AlfHashTable* table,
+	AlfHashTableBucket* bucket,
+	void* key,
+	uint64_t hash,
+	const void* value)
+{
+	bucket->hash = hash;
+	if (table->keySize)
+	{
+		memcpy((uint8_t*)bucket + table->keyOffset, key, table->keySize);
+	}
+	else
+	{
+		bucket->key = key;
+	}
+	memcpy(alfHashTableGetBucketValue(table, bucket), value, table->valueSize);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a key is equal to the key of a bucket. Inline keys without
+ * an equality function are compared by bytes, with the common key sizes as
+ * constants so that the comparison is done without a call to memcmp **/
+static AlfBool alfHashTableKeyEqual(
+	AlfHashTable* table,
+	const void* key,
+	AlfHashTableBucket* bucket)
+{
+	if (!table->keySize)
+	{
+		return table->keyEqual(key, alfHashTableGetBucketKey(table, bucket));
+	}
+
+	const void* bucketKey = (uint8_t*)bucket + table->keyOffset;
+	if (table->keyEqual)
+	{
+		return table->keyEqual(key, bucketKey);
+	}
+	switch (table->keySize)
+	{
+		case 4: return memcmp(key, bucketKey, 4) == 0;
+		case 8: return memcmp(key, bucketKey, 8) == 0;
+		case 16: return memcmp(key, bucketKey, 16) == 0;
+		default: return memcmp(key, bucketKey, table->keySize) == 0;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of bytes that a string of the specified length takes up
+ * in a string arena. Each string is preceded by its length and followed by a 
+ * null-terminator **/
+static uint64_t alfHashTableArenaEntrySize(uint32_t length)
+{
+	return ALF_ALIGN_POWER_OF_TWO(
+		sizeof(uint32_t) + length + 1, sizeof(uint32_t));
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the length of a string that is stored in a string arena **/
+static uint32_t alfHashTableArenaKeyLength(const void* key)
+{
+	uint32_t length;
+	memcpy(&length, (const uint8_t*)key - sizeof(uint32_t), sizeof(uint32_t));
+	return length;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Allocate a new chunk in the string arena that can hold at least 'size' 
+ * bytes. Chunks that are larger than the default chunk size are placed after 
+ * the first chunk, so that the first chunk can still be allocated from **/
+static AlfHashTableArenaChunk* alfHashTableArenaAddChunk(
+	AlfHashTable* table,
+	uint64_t size)
+{
+	const uint64_t capacity = size > ALF_HASH_TABLE_ARENA_CHUNK_SIZE ? 
+		size : ALF_HASH_TABLE_ARENA_CHUNK_SIZE;
+	AlfHashTableArenaChunk* chunk = alfAllocatorAlloc(
+		&table->allocator, sizeof(AlfHashTableArenaChunk) + capacity);
+	if (!chunk) { return NULL; }
+	chunk->size = 0;
+	chunk->capacity = capacity;
+	if (table->arenaChunks && capacity > ALF_HASH_TABLE_ARENA_CHUNK_SIZE)
+	{
+		chunk->next = table->arenaChunks->next;
+		table->arenaChunks->next = chunk;
+	}
+	else
+	{
+		chunk->next = table->arenaChunks;
+		table->arenaChunks = chunk;
+	}
+	return chunk;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Copy a string into a chunk that has enough space left. Returns the pointer
+ * to the copied string **/
+static void* alfHashTableArenaWriteKey(
+	AlfHashTableArenaChunk* chunk, 
+	const char* key,
+	uint32_t length)
+{
+	uint8_t* entry = chunk->data + chunk->size;
+	memcpy(entry, &length, sizeof(uint32_t));
+	memcpy(entry + sizeof(uint32_t), key, length + 1);
+	chunk->size += alfHashTableArenaEntrySize(length);
+	return entry + sizeof(uint32_t);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Copy a string key into the string arena of a table **/
+static void* alfHashTableArenaCopyKey(AlfHashTable* table, const char* key)
+{
+	const uint32_t length = (uint32_t)strlen(key);
+	const uint64_t size = alfHashTableArenaEntrySize(length);
+	AlfHashTableArenaChunk* chunk = table->arenaChunks;
+	if (!chunk || chunk->capacity - chunk->size < size)
+	{
+		chunk = alfHashTableArenaAddChunk(table, size);
+		if (!chunk) { return NULL; }
+	}
+	table->arenaUsedBytes += size;
+	return alfHashTableArenaWriteKey(chunk, key, length);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Free all chunks of the string arena of a table **/
+static void alfHashTableArenaFree(AlfHashTable* table)
+{
+	AlfHashTableArenaChunk* chunk = table->arenaChunks;
+	while (chunk)
+	{
+		AlfHashTableArenaChunk* next = chunk->next;
+		alfAllocatorFree(&table->allocator, chunk, 
+			sizeof(AlfHashTableArenaChunk) + chunk->capacity);
+		chunk = next;
+	}
+	table->arenaChunks = NULL;
+	table->arenaUsedBytes = 0;
+	table->arenaDeadBytes = 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Compact the string arena of a table if removed keys take up more space than
+ * the remaining keys. All remaining keys are copied, in bucket order, into a 
+ * single new chunk and the bucket key pointers are updated **/
+static void alfHashTableArenaCompact(AlfHashTable* table)
+{
+	if (table->arenaDeadBytes < ALF_HASH_TABLE_ARENA_CHUNK_SIZE ||
+		table->arenaDeadBytes * 2 < table->arenaUsedBytes)
+	{
+		return;
+	}
+
+	// Allocate new chunk, compaction is skipped if it fails
+	AlfHashTableArenaChunk* oldChunks = table->arenaChunks;
+	const uint64_t liveBytes = table->arenaUsedBytes - table->arenaDeadBytes;
+	table->arenaChunks = NULL;
+	AlfHashTableArenaChunk* chunk = alfHashTableArenaAddChunk(table, liveBytes);
+	if (!chunk)
+	{
+		table->arenaChunks = oldChunks;
+		return;
+	}
+
+	// Move keys from both current and old buckets
+	for (uint32_t n = 0; n < 2; n++)
+	{
+		uint8_t* buckets = n == 0 ? table->buckets : table->oldBuckets;
+		const uint64_t bucketCount = 
+			n == 0 ? table->bucketCount : table->oldBucketCount;
+		for (uint64_t i = 0; i < bucketCount; i++)
+		{
+			AlfHashTableBucket* bucket =
+				alfHashTableGetBucketAtIndex(buckets, table->bucketSize, i);
+			if (bucket->hash != 0)
+			{
+				bucket->key = alfHashTableArenaWriteKey(chunk, bucket->key, 
+					alfHashTableArenaKeyLength(bucket->key));
+			}
+		}
+	}
+
+	// Free old chunks
+	table->arenaChunks = oldChunks;
+	alfHashTableArenaFree(table);
+	table->arenaChunks = chunk;
+	table->arenaUsedBytes = liveBytes;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the key that is stored in a bucket for the specified key. Inline
+ * keys are copied into the bucket later, while other keys are copied to the 
+ * key storage of the table **/
+static void* alfHashTableCopyKey(AlfHashTable* table, const void* key)
+{
+	if (table->keySize)
+	{
+		return (void*)key;
+	}
+	if (table->keyStorage == ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)
+	{
+		return alfHashTableArenaCopyKey(table, key);
+	}
+	return table->keyCopy(key);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a key that was returned from alfHashTableCopyKey. Keys in the 
+ * string arena are only counted as dead until the arena is compacted **/
+static void alfHashTableDestroyKey(AlfHashTable* table, void* key)
+{
+	if (table->keySize)
+	{
+		return;
+	}
+	if (table->keyStorage == ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)
+	{
+		table->arenaDeadBytes += 
+			alfHashTableArenaEntrySize(alfHashTableArenaKeyLength(key));
+		return;
+	}
+	table->keyDestructor(key);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Setup the key and value offsets and the bucket size of a table from the 
+ * size of its keys and values **/
+static void alfHashTableSetupLayout(AlfHashTable* table)
+{
+	table->keyOffset = offsetof(AlfHashTableBucket, key);
+	table->valueOffset = ALF_ALIGN_POWER_OF_TWO(
+		table->keySize ? table->keyOffset + table->keySize : 
+		sizeof(AlfHashTableBucket), ALF_HASH_TABLE_VALUE_ALIGNMENT);
+	table->bucketSize = ALF_ALIGN_POWER_OF_TWO(
+		table->valueOffset + table->valueSize, ALF_HASH_TABLE_VALUE_ALIGNMENT);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Setup the settings of a table from a descriptor. The table is left without
+ * buckets and entries **/
+static void alfHashTableSetupSettings(
+	AlfHashTable* table, 
+	const AlfHashTableDesc* desc)
+{
+	// Keys and values
+	table->automaticShrink = ALF_FALSE;
+	table->valueSize = desc->valueSize;
+	table->keySize = desc->keySize;
+	table->keyStorage = desc->keyStorage;
+	table->arenaChunks = NULL;
+	table->arenaUsedBytes = 0;
+	table->arenaDeadBytes = 0;
+	table->hashFunction = desc->hashFunction;
+	table->hashFunction64 = desc->hashFunction64;
+	table->hashSeed = desc->hashSeed;
+	table->keyBase = 0;
+	table->mapping = NULL;
+	table->mappingSize = 0;
+	table->keyEqual = desc->keyEqual;
+	table->keyCopy = desc->keyCopy;
+	table->keyDestructor = 
+		desc->keyDestructor ? desc->keyDestructor : alfDefaultDestructor;
+	table->valueCleaner = 
+		desc->valueCleaner ? desc->valueCleaner : alfDefaultCleaner;
+
+	// Layout
+	table->maxLoadFactor = ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_RESIZE;
+	table->minLoadFactor = ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_SHRINK;
+	table->layout = desc->layout;
+	table->pages = desc->pages;
+	table->filter = NULL;
+	table->filterStaleCount = 0;
+	table->allocator = alfAllocatorOrDefault(desc->allocator);
+	table->size = 0;
+	table->bucketCount = 0;
+	table->buckets = NULL;
+	table->control = NULL;
+	table->deletedCount = 0;
+	alfHashTableSetupLayout(table);
+
+	// Incremental resizing is disabled by default
+	table->migrateStep = 0;
+	table->oldBucketCount = 0;
+	table->oldBuckets = NULL;
+	table->oldControl = NULL;
+#if defined(ALF_COLLECTION_STATISTICS)
+	memset(&table->statistics, 0, sizeof(AlfHashTableStatistics));
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether an array of the specified size in bytes is placed on huge
+ * pages by a table **/
+static AlfBool alfHashTableUsesHugePages(AlfHashTable* table, uint64_t size)
+{
+#if defined(ALF_COLLECTION_TARGET_WINDOWS) || defined(MAP_ANONYMOUS)
+	return table->pages == ALF_HASH_TABLE_PAGES_HUGE && 
+		size >= ALF_HASH_TABLE_HUGE_PAGE_SIZE;
+#else
+	// Anonymous mappings are not available
+	(void)table;
+	(void)size;
+	return ALF_FALSE;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Allocate an array of buckets or control bytes. Large arrays of tables that
+ * use huge pages are mapped directly, rounded up to whole huge pages. Explicit
+ * huge pages are tried first, then ordinary pages that the system is advised 
+ * to back with transparent huge pages **/
+static uint8_t* alfHashTableAllocatePages(AlfHashTable* table, uint64_t size)
+{
+	if (!alfHashTableUsesHugePages(table, size))
+	{
+		return alfAllocatorAlloc(&table->allocator, size);
+	}
+	size = ALF_ALIGN_POWER_OF_TWO(size, ALF_HASH_TABLE_HUGE_PAGE_SIZE);
+
+#if defined(ALF_COLLECTION_TARGET_WINDOWS)
+	// Large pages require the 'lock pages in memory' privilege
+	void* memory = NULL;
+	const SIZE_T largePageSize = GetLargePageMinimum();
+	if (largePageSize)
+	{
+		memory = VirtualAlloc(NULL, 
+			(SIZE_T)ALF_ALIGN_POWER_OF_TWO(size, (uint64_t)largePageSize),
+			MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+	}
+	if (!memory)
+	{
+		memory = VirtualAlloc(
+			NULL, (SIZE_T)size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+	return memory;
+#elif defined(MAP_ANONYMOUS)
+	void* memory = MAP_FAILED;
+#	if defined(MAP_HUGETLB)
+	memory = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, 
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#	endif
+	if (memory == MAP_FAILED)
+	{
+		memory = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, 
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED) { return NULL; }
+#	if defined(MADV_HUGEPAGE)
+		madvise(memory, (size_t)size, MADV_HUGEPAGE);
+#	endif
+	}
+	return memory;
+#else
+	return NULL;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Free an array that was allocated with alfHashTableAllocatePages **/
+static void alfHashTableFreePages(
+	AlfHashTable* table, 
+	uint8_t* memory, 
+	uint64_t size)
+{
+	if (!alfHashTableUsesHugePages(table, size))
+	{
+		alfAllocatorFree(&table->allocator, memory, size);
+		return;
+	}
+	if (!memory) { return; }
+
+#if defined(ALF_COLLECTION_TARGET_WINDOWS)
+	VirtualFree(memory, 0, MEM_RELEASE);
+#else
+	munmap(memory, 
+		(size_t)ALF_ALIGN_POWER_OF_TWO(size, ALF_HASH_TABLE_HUGE_PAGE_SIZE));
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Allocate buckets, and control bytes if used by the layout, to match the 
+ * bucket count. The buckets are not cleared. If memory cannot be allocated 
+ * then the table keeps its current buckets and false is returned **/
+static AlfBool alfHashTableAllocateBuckets(
+	AlfHashTable* table, 
+	uint64_t bucketCount)
+{
+	const uint64_t bucketsSize = (uint64_t)table->bucketSize * bucketCount;
+	uint8_t* buckets = alfHashTableAllocatePages(table, bucketsSize);
+	uint8_t* control = NULL;
+	if (buckets && table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		control = alfHashTableAllocatePages(table, bucketCount);
+		if (!control)
+		{
+			alfHashTableFreePages(table, buckets, bucketsSize);
+			buckets = NULL;
+		}
+	}
+	if (!buckets) { return ALF_FALSE; }
+
+	table->bucketCount = bucketCount;
+	table->buckets = buckets;
+	table->control = control;
+	table->deletedCount = 0;
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Free buckets and control bytes that were allocated with 
+ * alfHashTableAllocateBuckets for the specified bucket count **/
+static void alfHashTableFreeBuckets(
+	AlfHashTable* table,
+	uint8_t* buckets,
+	uint8_t* control,
+	uint64_t bucketCount)
+{
+	alfHashTableFreePages(table, control, bucketCount);
+	alfHashTableFreePages(
+		table, buckets, (uint64_t)table->bucketSize * bucketCount);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Clear a range of buckets. Bucket hashes are cleared to 0 and control bytes,
+ * if used by the layout, are marked as empty **/
+static void alfHashTableClearBuckets(
+	AlfHashTable* table, 
+	uint64_t first, 
+	uint64_t count)
+{
+	for (uint64_t i = first; i < first + count; i++)
+	{
+		AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, i);
+		bucket->hash = 0;
+	}
+	if (table->control)
+	{
+		memset(table->control + first, ALF_HASH_TABLE_CONTROL_EMPTY, count);
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Setup buckets to match the bucket count. Bucket hashes are cleared to 0 and
+ * control bytes, if used by the layout, are all marked as empty. If memory 
+ * cannot be allocated then the table keeps its current buckets **/
+static AlfBool alfHashTableSetupBuckets(
+	AlfHashTable* table, 
+	uint64_t bucketCount)
+{
+	if (!alfHashTableAllocateBuckets(table, bucketCount)) { return ALF_FALSE; }
+	alfHashTableClearBuckets(table, 0, bucketCount);
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the bucket count clamped to the minimum that the layout of a table
+ * supports. The control byte layout needs at least one full group **/
+static uint64_t alfHashTableClampBucketCount(
+	AlfHashTable* table, 
+	uint64_t bucketCount)
+{
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES &&
+		bucketCount < ALF_HASH_TABLE_GROUP_WIDTH)
+	{
+		return ALF_HASH_TABLE_GROUP_WIDTH;
+	}
+	return bucketCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the distance from the current index to the index that the hash 
+ * value corresponds to. This is used to determine the probing distance **/
+static uint64_t alfHashTableDistanceFromWantedIndex(
+	uint64_t bucketCount,
+	uint64_t hash,
+	uint64_t currentIndex)
+{
+	const uint64_t otherIndex = 
+		ALF_MOD_POWER_OF_TWO(hash, bucketCount);
+	return ALF_MOD_POWER_OF_TWO(
+		currentIndex + bucketCount - otherIndex, 
+		bucketCount
+	);
+}
+
+// ========================================================================== //
+// HashTable Private Statistics Functions
+// ========================================================================== //
+
+/** Returns the number of probe steps from the wanted position of a hash to 
+ * the bucket at an index. Steps are buckets for the robin-hood layout and
+ * groups for the control byte layout **/
+static uint64_t alfHashTableGetDisplacement(
+	AlfHashTable* table,
+	uint64_t bucketCount,
+	uint64_t hash,
+	uint64_t index)
+{
+	if (table->layout != ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		return alfHashTableDistanceFromWantedIndex(bucketCount, hash, index);
+	}
+
+	// Follow the probe sequence of the hash to the group of the bucket
+	const uint64_t groupCount = bucketCount / ALF_HASH_TABLE_GROUP_WIDTH;
+	const uint64_t wantedGroup = index / ALF_HASH_TABLE_GROUP_WIDTH;
+	uint64_t group = ALF_MOD_POWER_OF_TWO(hash, groupCount);
+	uint64_t step = 0;
+	while (group != wantedGroup)
+	{
+		group = ALF_MOD_POWER_OF_TWO(group + ++step, groupCount);
+	}
+	return step;
+}
+
+// -------------------------------------------------------------------------- //
+
+#if defined(ALF_COLLECTION_STATISTICS)
+
+/** Returns the current time in nanoseconds **/
+static uint64_t alfHashTableGetTime()
+{
+	struct timespec time;
+	timespec_get(&time, TIME_UTC);
+	return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Increment a statistics counter. The increment is atomic, since lookups in
+ * a concurrent hash table record their probe lengths while holding only the 
+ * read lock of a shard. No ordering is needed for a counter **/
+static void alfHashTableIncrementCounter(uint64_t* counter)
+{
+#if defined(_MSC_VER)
+	_InterlockedIncrement64((volatile __int64*)counter);
+#else
+	__atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Record the probe length of a lookup. Lengths past the end of the histogram
+ * are recorded in the last entry **/
+static void alfHashTableRecordProbe(
+	AlfHashTable* table, 
+	AlfBool hit, 
+	uint64_t length)
+{
+	if (length >= ALF_HASH_TABLE_STATISTICS_PROBE_LENGTHS)
+	{
+		length = ALF_HASH_TABLE_STATISTICS_PROBE_LENGTHS - 1;
+	}
+	uint64_t* histogram = hit ? 
+		table->statistics.hitProbeLengths : table->statistics.missProbeLengths;
+	alfHashTableIncrementCounter(&histogram[length]);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Record the number of resizes that started and the time spent since the 
+ * start time **/
+static void alfHashTableRecordResize(
+	AlfHashTable* table, 
+	uint64_t startTime, 
+	uint64_t count)
+{
+	table->statistics.resizeCount += count;
+	table->statistics.resizeNanoseconds += alfHashTableGetTime() - startTime;
+}
+
+#endif // defined(ALF_COLLECTION_STATISTICS)
+
+// ========================================================================== //
+// HashTable Private Control Byte Functions
+// ========================================================================== //
+
+/** Returns the 7-bit control byte tag of a hash. The tag is taken from the high
+ * bits as the low bits are used to select the group **/
+static uint8_t alfHashTableControlTag(uint64_t hash)
+{
+	return (uint8_t)(hash >> 57);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns a mask with one bit set for each control byte in a group that is 
+ * equal to the specified control byte **/
+static uint32_t alfHashTableGroupMatch(const uint8_t* group, uint8_t control)
+{
+#if defined(ALF_COLLECTION_SSE2)
+	const __m128i bytes = _mm_loadu_si128((const __m128i*)group);
+	return (uint32_t)_mm_movemask_epi8(
+		_mm_cmpeq_epi8(bytes, _mm_set1_epi8((char)control)));
+#else
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < ALF_HASH_TABLE_GROUP_WIDTH; i++)
+	{
+		mask |= (uint32_t)(group[i] == control) << i;
+	}
+	return mask;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns a mask with one bit set for each control byte in a group that is
+ * either empty or deleted. These are the only control bytes with the MSB set **/
+static uint32_t alfHashTableGroupMatchFree(const uint8_t* group)
+{
+#if defined(ALF_COLLECTION_SSE2)
+	return (uint32_t)_mm_movemask_epi8(
+		_mm_loadu_si128((const __m128i*)group));
+#else
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < ALF_HASH_TABLE_GROUP_WIDTH; i++)
+	{
+		mask |= (uint32_t)(group[i] >> 7) << i;
+	}
+	return mask;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Find the first bucket that is either empty or deleted in the probe sequence
+ * of a hash, in a table that uses the control byte layout. Groups are probed 
+ * with triangular steps, which visits each group once when the group count is 
+ * a power of two **/
+static AlfBool alfHashTableControlFindFree(
+	AlfHashTable* table,
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	const uint64_t groupCount = table->bucketCount / ALF_HASH_TABLE_GROUP_WIDTH;
+	uint64_t group = ALF_MOD_POWER_OF_TWO(hash, groupCount);
+	for (uint64_t step = 1; step <= groupCount; step++)
+	{
+		const uint32_t free = alfHashTableGroupMatchFree(
+			table->control + group * ALF_HASH_TABLE_GROUP_WIDTH);
+		if (free)
+		{
+			*indexOut = group * ALF_HASH_TABLE_GROUP_WIDTH +
+				alfCountTrailingZeros32(free);
+			return ALF_TRUE;
+		}
+		group = ALF_MOD_POWER_OF_TWO(group + step, groupCount);
+	}
+	return ALF_FALSE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Mark a free bucket in a table that uses the control byte layout as used by
+ * an entry with the specified hash, and return the bucket **/
+static AlfHashTableBucket* alfHashTableControlClaim(
+	AlfHashTable* table,
+	uint64_t index,
+	uint64_t hash)
+{
+	if (table->control[index] == ALF_HASH_TABLE_CONTROL_DELETED)
+	{
+		table->deletedCount--;
+	}
+	table->control[index] = alfHashTableControlTag(hash);
+	return alfHashTableGetBucketAtIndex(
+		table->buckets, table->bucketSize, index);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns object corresponding to key or NULL if key was not found in bucket
+ * and control arrays of the control byte layout. Buckets are only read when the
+ * control byte matches the tag of the key **/
+static void* alfHashTableControlProbe(
+	AlfHashTable* table,
+	uint8_t* buckets,
+	const uint8_t* controlBytes,
+	uint64_t bucketCount,
+	const void* key,
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	const uint8_t tag = alfHashTableControlTag(hash);
+	const uint64_t groupCount = bucketCount / ALF_HASH_TABLE_GROUP_WIDTH;
+	uint64_t group = ALF_MOD_POWER_OF_TWO(hash, groupCount);
+	for (uint64_t step = 1; step <= groupCount; step++)
+	{
+		// Check each bucket with a matching tag
+		const uint8_t* control = controlBytes + group * ALF_HASH_TABLE_GROUP_WIDTH;
+		uint32_t match = alfHashTableGroupMatch(control, tag);
+		while (match)
+		{
+			const uint64_t index = group * ALF_HASH_TABLE_GROUP_WIDTH +
+				alfCountTrailingZeros32(match);
+			AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+				buckets, table->bucketSize, index);
+			if (bucket->hash == hash && alfHashTableKeyEqual(table, key, bucket))
+			{
+				*indexOut = index;
+				ALF_HASH_TABLE_RECORD_PROBE(table, ALF_TRUE, step - 1);
+				return alfHashTableGetBucketValue(table, bucket);
+			}
+			match &= match - 1;
+		}
+
+		// The key would have been placed in this group if it had an empty
+		// bucket, therefore return NULL immediately.
+		if (alfHashTableGroupMatch(control, ALF_HASH_TABLE_CONTROL_EMPTY))
+		{
+			ALF_HASH_TABLE_RECORD_PROBE(table, ALF_FALSE, step - 1);
+			return NULL;
+		}
+
+		group = ALF_MOD_POWER_OF_TWO(group + step, groupCount);
+	}
+	ALF_HASH_TABLE_RECORD_PROBE(table, ALF_FALSE, groupCount - 1);
+	return NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns object corresponding to key in the current buckets of a table that
+ * uses the control byte layout. If the key was not found then NULL is returned
+ * and 'indexOut' is set to the first free bucket in the probe sequence, which 
+ * is where the key would be inserted **/
+static void* alfHashTableControlLocate(
+	AlfHashTable* table,
+	const void* key,
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	const uint8_t tag = alfHashTableControlTag(hash);
+	const uint64_t groupCount = table->bucketCount / ALF_HASH_TABLE_GROUP_WIDTH;
+	uint64_t group = ALF_MOD_POWER_OF_TWO(hash, groupCount);
+	AlfBool foundFree = ALF_FALSE;
+	for (uint64_t step = 1; step <= groupCount; step++)
+	{
+		// Check each bucket with a matching tag
+		const uint8_t* control = 
+			table->control + group * ALF_HASH_TABLE_GROUP_WIDTH;
+		uint32_t match = alfHashTableGroupMatch(control, tag);
+		while (match)
+		{
+			const uint64_t index = group * ALF_HASH_TABLE_GROUP_WIDTH +
+				alfCountTrailingZeros32(match);
+			AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+				table->buckets, table->bucketSize, index);
+			if (bucket->hash == hash && alfHashTableKeyEqual(table, key, bucket))
+			{
+				*indexOut = index;
+				ALF_HASH_TABLE_RECORD_PROBE(table, ALF_TRUE, step - 1);
+				return alfHashTableGetBucketValue(table, bucket);
+			}
+			match &= match - 1;
+		}
+
+		// Remember the first free bucket
+		const uint32_t free = alfHashTableGroupMatchFree(control);
+		if (free && !foundFree)
+		{
+			*indexOut = group * ALF_HASH_TABLE_GROUP_WIDTH + 
+				alfCountTrailingZeros32(free);
+			foundFree = ALF_TRUE;
+		}
+		if (alfHashTableGroupMatch(control, ALF_HASH_TABLE_CONTROL_EMPTY))
+		{
+			ALF_HASH_TABLE_RECORD_PROBE(table, ALF_FALSE, step - 1);
+			return NULL;
+		}
+
+		group = ALF_MOD_POWER_OF_TWO(group + step, groupCount);
+	}
+	ALF_HASH_TABLE_RECORD_PROBE(table, ALF_FALSE, groupCount - 1);
+	return NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Erase the bucket at the specified index in a table that uses the control 
+ * byte layout. The bucket can be marked as empty if its group already has an
+ * empty bucket, as no probe has then ever continued past the group **/
+static void alfHashTableControlErase(AlfHashTable* table, uint64_t index)
+{
+	const uint8_t* group = table->control + 
+		(index / ALF_HASH_TABLE_GROUP_WIDTH) * ALF_HASH_TABLE_GROUP_WIDTH;
+	if (alfHashTableGroupMatch(group, ALF_HASH_TABLE_CONTROL_EMPTY))
+	{
+		table->control[index] = ALF_HASH_TABLE_CONTROL_EMPTY;
+	}
+	else
+	{
+		table->control[index] = ALF_HASH_TABLE_CONTROL_DELETED;
+		table->deletedCount++;
+	}
+
+	AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+		table->buckets, table->bucketSize, index);
+	bucket->hash = 0;
+}
+
+// ========================================================================== //
+// HashTable Private Robin-Hood Functions
+// ========================================================================== //
+
+/** Find the index where an entry with the specified hash should be inserted.
+ * For robin-hood buckets this is the first bucket that is either empty or 
+ * holds an entry that has probed a shorter distance **/
+static AlfBool alfHashTableFindInsertIndex(
+	AlfHashTable* table,
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		return alfHashTableControlFindFree(table, hash, indexOut);
+	}
+
+	uint64_t index = ALF_MOD_POWER_OF_TWO(hash, table->bucketCount);
+	uint64_t distance = 0;
+	while (ALF_TRUE)
+	{
+		const AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, index);
+		if (bucket->hash == 0 || alfHashTableDistanceFromWantedIndex(
+			table->bucketCount, bucket->hash, index) < distance)
+		{
+			*indexOut = index;
+			return ALF_TRUE;
+		}
+		index = ALF_MOD_POWER_OF_TWO(index + 1, table->bucketCount);
+		distance++;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Make the bucket at an index, as returned by alfHashTableFindInsertIndex or
+ * alfHashTableLocate, free for a new entry with the specified hash and return
+ * it. The caller must then set the bucket.
+ * 
+ * Robin-hood buckets from the index up to the next empty bucket are shifted 
+ * one step forward. This keeps the entries of each cluster ordered by wanted
+ * index, just like swapping entries while probing would, but each entry is 
+ * only moved once and no temporary copies are needed **/
+static AlfHashTableBucket* alfHashTableClaimBucket(
+	AlfHashTable* table,
+	uint64_t index,
+	uint64_t hash)
+{
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		return alfHashTableControlClaim(table, index, hash);
+	}
+
+	// Find the end of the cluster
+	uint64_t emptyIndex = index;
+	while (alfHashTableGetBucketAtIndex(
+		table->buckets, table->bucketSize, emptyIndex)->hash != 0)
+	{
+		emptyIndex = ALF_MOD_POWER_OF_TWO(emptyIndex + 1, table->bucketCount);
+	}
+
+	// Shift buckets forward, starting from the end
+	while (emptyIndex != index)
+	{
+		const uint64_t previousIndex = ALF_MOD_POWER_OF_TWO(
+			emptyIndex + table->bucketCount - 1, table->bucketCount);
+		memcpy(
+			alfHashTableGetBucketAtIndex(
+				table->buckets, table->bucketSize, emptyIndex),
+			alfHashTableGetBucketAtIndex(
+				table->buckets, table->bucketSize, previousIndex),
+			table->bucketSize);
+		emptyIndex = previousIndex;
+	}
+	return alfHashTableGetBucketAtIndex(
+		table->buckets, table->bucketSize, index);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a copy of a bucket into a hash table. This is part of the private 
+ * implementation and does not check load factor or update the size **/
+static AlfBool alfHashTableInsertBucket(
+	AlfHashTable* table,
+	const AlfHashTableBucket* bucket)
+{
+	uint64_t index;
+	if (!alfHashTableFindInsertIndex(table, bucket->hash, &index))
+	{
+		return ALF_FALSE;
+	}
+	memcpy(alfHashTableClaimBucket(table, index, bucket->hash), bucket, 
+		table->bucketSize);
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a key-value pair into a hash table. This is part of the private 
+ * implementation and does not check load factor. alfHashTableInsert should be
+ * used instead (It uses this function). The hash must be the hash of the key as
+ * returned by alfHashTableGetKeyHash **/
+static AlfBool alfHashTableInsertKeyValue(
+	AlfHashTable* table,
+	void* key,
+	uint64_t hash,
+	const void* value)
+{
+	uint64_t index;
+	if (!alfHashTableFindInsertIndex(table, hash, &index))
+	{
+		return ALF_FALSE;
+	}
+	alfHashTableSetBucket(
+		table, alfHashTableClaimBucket(table, index, hash), key, hash, value);
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns object corresponding to key or NULL if key was not found in a 
+ * robin-hood bucket array. Probing starts at 'index' where the key would have
+ * probed 'distance' buckets. If the key was found then the 'indexOut' parameter
+ * is also set to the index **/
+static void* alfHashTableProbe(
+	AlfHashTable* table,
+	uint8_t* buckets,
+	uint64_t bucketCount,
+	uint64_t index,
+	uint64_t distance,
+	const void* key,
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	const uint64_t startDistance = distance;
+	while (ALF_TRUE)
+	{
+		// Retrieve bucket
+		AlfHashTableBucket* otherBucket = alfHashTableGetBucketAtIndex(
+			buckets, table->bucketSize, index);
+
+		// Return NULL if bucket is empty
+		if (otherBucket->hash == 0)
+		{
+			ALF_HASH_TABLE_RECORD_PROBE(
+				table, ALF_FALSE, distance - startDistance);
+			return NULL;
+		}
+
+		// Value cannot be further away than what the object at the current
+		// position is, therefore return NULL immediately.
+		const uint64_t slotDistance = alfHashTableDistanceFromWantedIndex(
+			bucketCount, otherBucket->hash, index);
+		if (distance > slotDistance)
+		{
+			ALF_HASH_TABLE_RECORD_PROBE(
+				table, ALF_FALSE, distance - startDistance);
+			return NULL;
+		}
+
+		// Check if object is the same
+		if (otherBucket->hash == hash &&
+			alfHashTableKeyEqual(table, key, otherBucket))
+		{
+			*indexOut = index;
+			ALF_HASH_TABLE_RECORD_PROBE(
+				table, ALF_TRUE, distance - startDistance);
+			return alfHashTableGetBucketValue(table, otherBucket);
+		}
+
+		index = ALF_MOD_POWER_OF_TWO(index + 1, bucketCount);
+		distance++;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns object corresponding to key or NULL if key was not found in the 
+ * current buckets of a table. If the key was found then the 'indexOut' 
+ * paramter is also set to the index **/
+void* alfHashTableFindIndex(
+	AlfHashTable* table, 
+	const void* key, 
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		return alfHashTableControlProbe(table, table->buckets, table->control, 
+			table->bucketCount, key, hash, indexOut);
+	}
+	return alfHashTableProbe(table, table->buckets, table->bucketCount,
+		ALF_MOD_POWER_OF_TWO(hash, table->bucketCount), 0, key, hash,
+		indexOut);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns object corresponding to key in the current buckets of a table. If 
+ * the key was not found then NULL is returned and 'indexOut' is set to the 
+ * index where the key would be inserted **/
+static void* alfHashTableLocate(
+	AlfHashTable* table,
+	const void* key,
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		return alfHashTableControlLocate(table, key, hash, indexOut);
+	}
+
+	uint64_t index = ALF_MOD_POWER_OF_TWO(hash, table->bucketCount);
+	uint64_t distance = 0;
+	while (ALF_TRUE)
+	{
+		// Key is not in table if bucket is empty or has probed less
+		AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, index);
+		if (bucket->hash == 0 || alfHashTableDistanceFromWantedIndex(
+			table->bucketCount, bucket->hash, index) < distance)
+		{
+			*indexOut = index;
+			ALF_HASH_TABLE_RECORD_PROBE(table, ALF_FALSE, distance);
+			return NULL;
+		}
+
+		// Check if object is the same
+		if (bucket->hash == hash && alfHashTableKeyEqual(table, key, bucket))
+		{
+			*indexOut = index;
+			ALF_HASH_TABLE_RECORD_PROBE(table, ALF_TRUE, distance);
+			return alfHashTableGetBucketValue(table, bucket);
+		}
+
+		index = ALF_MOD_POWER_OF_TWO(index + 1, table->bucketCount);
+		distance++;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Erase the bucket at the specified index by shifting each following bucket
+ * one step back, until a bucket that is empty or already at its wanted index is
+ * reached. This keeps probe sequences as short as if the erased key had never
+ * been inserted, without leaving any tombstone behind **/
+static void alfHashTableEraseBackwardShift(
+	AlfHashTable* table, 
+	uint8_t* buckets,
+	uint64_t bucketCount,
+	uint64_t index)
+{
+	AlfHashTableBucket* bucket = 
+		alfHashTableGetBucketAtIndex(buckets, table->bucketSize, index);
+	while (ALF_TRUE)
+	{
+		const uint64_t nextIndex = ALF_MOD_POWER_OF_TWO(index + 1, bucketCount);
+		AlfHashTableBucket* nextBucket = 
+			alfHashTableGetBucketAtIndex(buckets, table->bucketSize, nextIndex);
+		if (nextBucket->hash == 0 || alfHashTableDistanceFromWantedIndex(
+			bucketCount, nextBucket->hash, nextIndex) == 0)
+		{
+			bucket->hash = 0;
+			return;
+		}
+
+		memcpy(bucket, nextBucket, table->bucketSize);
+		bucket = nextBucket;
+		index = nextIndex;
+	}
+}
+
+// ========================================================================== //
+// HashTable Private Incremental Resize Functions
+// ========================================================================== //
+
+/** Returns object corresponding to key or NULL if key was not found in the old
+ * buckets of a table that is being resized incrementally.
+ * 
+ * Migration moves buckets in order, starting at 'migrateStart', and each moved
+ * bucket is left empty. For robin-hood buckets this would cut probe sequences
+ * short, therefore a probe whose wanted index has already been migrated starts
+ * at the first bucket that has not been migrated. For control bytes the moved
+ * buckets are marked as deleted so that probing continues past them **/
+static void* alfHashTableFindOldIndex(
+	AlfHashTable* table,
+	const void* key,
+	uint64_t hash,
+	uint64_t* indexOut)
+{
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		return alfHashTableControlProbe(table, table->oldBuckets, 
+			table->oldControl, table->oldBucketCount, key, hash, indexOut);
+	}
+
+	const uint64_t wantedIndex = 
+		ALF_MOD_POWER_OF_TWO(hash, table->oldBucketCount);
+	const uint64_t offset = ALF_MOD_POWER_OF_TWO(
+		wantedIndex + table->oldBucketCount - table->migrateStart,
+		table->oldBucketCount);
+	if (offset < table->migrateCount)
+	{
+		const uint64_t index = ALF_MOD_POWER_OF_TWO(
+			table->migrateStart + table->migrateCount, table->oldBucketCount);
+		return alfHashTableProbe(table, table->oldBuckets, 
+			table->oldBucketCount, index, table->migrateCount - offset, key, 
+			hash, indexOut);
+	}
+	return alfHashTableProbe(table, table->oldBuckets, table->oldBucketCount,
+		wantedIndex, 0, key, hash, indexOut);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Erase the bucket at the specified index in the old buckets of a table that
+ * is being resized incrementally. Backward shifting never moves a bucket into
+ * the migrated range, as the migrated buckets are all empty **/
+static void alfHashTableEraseOld(AlfHashTable* table, uint64_t index)
+{
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		table->oldControl[index] = ALF_HASH_TABLE_CONTROL_DELETED;
+		alfHashTableGetBucketAtIndex(
+			table->oldBuckets, table->bucketSize, index)->hash = 0;
+		return;
+	}
+	alfHashTableEraseBackwardShift(
+		table, table->oldBuckets, table->oldBucketCount, index);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Migrate up to 'bucketCount' of the old buckets of a table that is being
+ * resized incrementally. The old buckets are freed when all are migrated **/
+static void alfHashTableMigrate(AlfHashTable* table, uint64_t bucketCount)
+{
+	if (!table->oldBuckets) { return; }
+	ALF_HASH_TABLE_START_RESIZE_TIMER(startTime);
+	while (table->oldBuckets && bucketCount-- > 0)
+	{
+		// Move bucket to the current buckets using the cached hash
+		const uint64_t index = ALF_MOD_POWER_OF_TWO(
+			table->migrateStart + table->migrateCount, table->oldBucketCount);
+		AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			table->oldBuckets, table->bucketSize, index);
+		if (bucket->hash != 0)
+		{
+			alfHashTableInsertBucket(table, bucket);
+			bucket->hash = 0;
+			if (table->oldControl)
+			{
+				table->oldControl[index] = ALF_HASH_TABLE_CONTROL_DELETED;
+			}
+		}
+
+		// Free old buckets when done
+		if (++table->migrateCount == table->oldBucketCount)
+		{
+			alfHashTableFreeBuckets(table, table->oldBuckets, 
+				table->oldControl, table->oldBucketCount);
+			table->oldControl = NULL;
+			table->oldBuckets = NULL;
+			table->oldBucketCount = 0;
+		}
+	}
+	ALF_HASH_TABLE_RECORD_RESIZE(table, startTime, 0);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Move all entries of a table to new buckets of the specified count at once.
+ * If the buckets cannot be allocated then the table keeps its current buckets
+ * and false is returned **/
+static AlfBool alfHashTableRebuild(AlfHashTable* table, uint64_t bucketCount)
+{
+	// Complete any incremental resize, then store old and setup new
+	alfHashTableMigrate(table, UINT64_MAX);
+	ALF_HASH_TABLE_START_RESIZE_TIMER(startTime);
+	const uint64_t oldBucketCount = table->bucketCount;
+	uint8_t* oldBuckets = table->buckets;
+	uint8_t* oldControl = table->control;
+	if (!alfHashTableSetupBuckets(
+		table, alfHashTableClampBucketCount(table, bucketCount)))
+	{
+		return ALF_FALSE;
+	}
+
+	// Copy values from old, reusing the cached hashes
+	uint64_t moveSizeLeft = table->size;
+	for (uint64_t i = 0; i < oldBucketCount && moveSizeLeft > 0; i++)
+	{
+		AlfHashTableBucket* oldBucket = alfHashTableGetBucketAtIndex(
+			oldBuckets, table->bucketSize, i);
+		if (oldBucket->hash != 0)
+		{
+			alfHashTableInsertBucket(table, oldBucket);
+			moveSizeLeft--;
+		}
+	}
+
+	// Cleanup old
+	alfHashTableFreeBuckets(table, oldBuckets, oldControl, oldBucketCount);
+	ALF_HASH_TABLE_RECORD_RESIZE(table, startTime, 1);
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Resize a table to the specified bucket count. If incremental resizing is
+ * enabled then the current buckets are kept as the old buckets and are 
+ * migrated over the following operations, otherwise all entries are moved 
+ * immediately. If the new buckets cannot be allocated then the table keeps 
+ * its current buckets and false is returned **/
+static AlfBool alfHashTableGrow(AlfHashTable* table, uint64_t bucketCount)
+{
+	// A rehash at the same size or a shrink is deferred while an incremental
+	// resize is in progress, as completing it would move all remaining old 
+	// buckets in one operation. The condition is checked again by later 
+	// operations. It is only completed early when no empty bucket would be 
+	// left for probes to end at
+	if (table->oldBuckets && bucketCount <= table->bucketCount &&
+		table->size + table->deletedCount + 1 < table->bucketCount)
+	{
+		return ALF_TRUE;
+	}
+
+	// Any earlier resize must be completed first
+	alfHashTableMigrate(table, UINT64_MAX);
+	if (!table->migrateStep)
+	{
+		return alfHashTableRebuild(table, bucketCount);
+	}
+
+	// Robin-hood migration must start at an empty bucket so that no probe 
+	// sequence passes from the unmigrated buckets into the migrated ones
+	uint64_t start = 0;
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_ROBIN_HOOD)
+	{
+		while (start < table->bucketCount && alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, start)->hash != 0)
+		{
+			start++;
+		}
+		if (start == table->bucketCount)
+		{
+			return alfHashTableRebuild(table, bucketCount);
+		}
+	}
+
+	// Keep current buckets as old and setup new
+	ALF_HASH_TABLE_START_RESIZE_TIMER(startTime);
+	const uint64_t oldBucketCount = table->bucketCount;
+	uint8_t* oldBuckets = table->buckets;
+	uint8_t* oldControl = table->control;
+	if (!alfHashTableSetupBuckets(
+		table, alfHashTableClampBucketCount(table, bucketCount)))
+	{
+		return ALF_FALSE;
+	}
+	table->oldBucketCount = oldBucketCount;
+	table->oldBuckets = oldBuckets;
+	table->oldControl = oldControl;
+	table->migrateStart = start;
+	table->migrateCount = 0;
+	ALF_HASH_TABLE_RECORD_RESIZE(table, startTime, 1);
+	return ALF_TRUE;
+}
+
+// ========================================================================== //
+// HashTable Private Filter Functions
+// ========================================================================== //
+
+/** Replace the filter of a table with a filter of the specified type that has
+ * room for at least the specified number of keys, and insert the hashes of all
+ * entries. The capacity is doubled until all hashes fit. If the filter cannot
+ * be allocated, or the hashes do not fit in a filter that is a few times larger
+ * than the table, then the table is left without a filter **/
+static AlfBool alfHashTableBuildFilter(
+	AlfHashTable* table, 
+	AlfFilterType type,
+	uint64_t capacity)
+{
+	if (table->filter)
+	{
+		alfDestroyFilter(table->filter);
+		table->filter = NULL;
+	}
+	table->filterStaleCount = 0;
+
+	AlfFilterDesc desc = { 0 };
+	desc.type = type;
+	desc.capacity = capacity > table->size ? capacity : table->size;
+	desc.allocator = &table->allocator;
+	while (!table->filter)
+	{
+		table->filter = alfCreateFilter(&desc);
+		if (!table->filter) { return ALF_FALSE; }
+		AlfBool success = ALF_TRUE;
+		for (uint32_t n = 0; n < 2 && success; n++)
+		{
+			uint8_t* buckets = n == 0 ? table->buckets : table->oldBuckets;
+			const uint64_t bucketCount = 
+				n == 0 ? table->bucketCount : table->oldBucketCount;
+			for (uint64_t i = 0; i < bucketCount && success; i++)
+			{
+				AlfHashTableBucket* bucket =
+					alfHashTableGetBucketAtIndex(buckets, table->bucketSize, i);
+				if (bucket->hash != 0)
+				{
+					success = alfFilterInsertHash(table->filter, bucket->hash);
+				}
+			}
+		}
+		if (!success)
+		{
+			alfDestroyFilter(table->filter);
+			table->filter = NULL;
+			if (desc.capacity > 
+				table->size * ALF_HASH_TABLE_MAX_FILTER_CAPACITY_FACTOR)
+			{
+				return ALF_FALSE;
+			}
+			desc.capacity *= 2;
+		}
+	}
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a key with the specified hash may be in a table. This is 
+ * always true for tables without a filter **/
+static AlfBool alfHashTableFilterMayContain(AlfHashTable* table, uint64_t hash)
+{
+	return !table->filter || alfFilterMayContainHash(table->filter, hash);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Add the hash of an entry that has been inserted into a table to its filter.
+ * The filter is rebuilt with twice the capacity when it is full **/
+static void alfHashTableFilterInsert(AlfHashTable* table, uint64_t hash)
+{
+	if (!table->filter) { return; }
+	AlfFilter* filter = table->filter;
+	if (table->size > alfFilterGetCapacity(filter) || 
+		!alfFilterInsertHash(filter, hash))
+	{
+		alfHashTableBuildFilter(
+			table, filter->type, alfFilterGetCapacity(filter) * 2);
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Remove the hash of an entry that has been removed from a table from its 
+ * filter. Bloom filters keep the bits of removed entries, and are rebuilt when
+ * the removed entries outnumber the entries in the table **/
+static void alfHashTableFilterRemove(AlfHashTable* table, uint64_t hash)
+{
+	if (!table->filter) { return; }
+	AlfFilter* filter = table->filter;
+	if (filter->type == ALF_FILTER_TYPE_CUCKOO)
+	{
+		alfFilterRemoveHash(filter, hash);
+	}
+	else if (++table->filterStaleCount > table->size &&
+		table->filterStaleCount > ALF_HASH_TABLE_MIN_FILTER_STALE_COUNT)
+	{
+		alfHashTableBuildFilter(
+			table, filter->type, alfFilterGetCapacity(filter));
+	}
+}
+
+// ========================================================================== //
+// HashTable Private Hashed Functions
+// ========================================================================== //
+
+/** Insert a value with a key whose hash has already been computed **/
+static AlfBool alfHashTableInsertHashed(
+	AlfHashTable* table, 
+	const void* key, 
+	uint64_t hash,
+	const void* value)
+{
+	// Resize if load factor exceeds certain value. Deleted control bytes also
+	// lengthen probes so rehash at the same size when they push the table over
+	alfHashTableMigrate(table, table->migrateStep);
+	const float loadFactor = alfHashTableGetLoadFactor(table);
+	AlfBool grown = ALF_TRUE;
+	if (loadFactor >= table->maxLoadFactor)
+	{
+		grown = alfHashTableGrow(table, table->bucketCount << 1);
+	}
+	else if ((float)(table->size + table->deletedCount) / 
+		(float)table->bucketCount >= table->maxLoadFactor)
+	{
+		grown = alfHashTableGrow(table, table->bucketCount);
+	}
+
+	// A table that could not grow must keep an empty bucket for probes to end
+	if (!grown && table->size + 1 >= table->bucketCount) { return ALF_FALSE; }
+
+	// Insert
+	void* keyCopy = alfHashTableCopyKey(table, key);
+	if (!keyCopy) { return ALF_FALSE; }
+	const AlfBool success = 
+		alfHashTableInsertKeyValue(table, keyCopy, hash, value);
+	if (!success)
+	{
+		alfHashTableDestroyKey(table, keyCopy);
+		return ALF_FALSE;
+	}
+	table->size++;
+	alfHashTableFilterInsert(table, hash);
+	return success;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value for a key whose hash has already been computed **/
+static void* alfHashTableGetHashed(
+	AlfHashTable* table, 
+	const void* key, 
+	uint64_t hash)
+{
+	if (!alfHashTableFilterMayContain(table, hash)) { return NULL; }
+	uint64_t index;
+	void* value = alfHashTableFindIndex(table, key, hash, &index);
+	if (!value && table->oldBuckets)
+	{
+		value = alfHashTableFindOldIndex(table, key, hash, &index);
+	}
+	return value;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Remove the value for a key whose hash has already been computed **/
+static AlfBool alfHashTableRemoveHashed(
+	AlfHashTable* table, 
+	const void* key, 
+	uint64_t hash,
+	void* valueOut)
+{
+	// Find value and index, in the old buckets if not in the current. Return
+	// immediately if value was not found
+	alfHashTableMigrate(table, table->migrateStep);
+	if (!alfHashTableFilterMayContain(table, hash)) { return ALF_FALSE; }
+	uint64_t index;
+	AlfBool old = ALF_FALSE;
+	void* value = alfHashTableFindIndex(table, key, hash, &index);
+	if (!value && table->oldBuckets)
+	{
+		value = alfHashTableFindOldIndex(table, key, hash, &index);
+		old = ALF_TRUE;
+	}
+	if (!value)
+	{
+		return ALF_FALSE;
+	}
+
+	// Retrieve bucket, write value to user buffer and reset hash
+	AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+		old ? table->oldBuckets : table->buckets, table->bucketSize, index);
+	alfHashTableDestroyKey(table, bucket->key);
+	if (valueOut) 
+	{
+		memcpy(valueOut, value, table->valueSize);
+	}
+	if (old)
+	{
+		alfHashTableEraseOld(table, index);
+	}
+	else if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		alfHashTableControlErase(table, index);
+	}
+	else
+	{
+		alfHashTableEraseBackwardShift(
+			table, table->buckets, table->bucketCount, index);
+	}
+	table->size--;
+	alfHashTableFilterRemove(table, hash);
+	if (table->keyStorage == ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)
+	{
+		alfHashTableArenaCompact(table);
+	}
+
+	// Shrink if load factor falls below the minimum
+	if (table->automaticShrink &&
+		table->bucketCount > table->minBucketCount &&
+		alfHashTableGetLoadFactor(table) < table->minLoadFactor)
+	{
+		alfHashTableGrow(table, table->bucketCount >> 1);
+	}
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Find the value for a key whose hash has already been computed, or insert a
+ * zero-initialized value if the key was not found **/
+static void* alfHashTableFindOrInsertHashed(
+	AlfHashTable* table,
+	const void* key,
+	uint64_t hash,
+	AlfBool* insertedOut)
+{
+	// Find value in old or current buckets. The probe of the current buckets 
+	// also finds the index to insert at. Keys that the filter rejects are not
+	// looked up at all
+	alfHashTableMigrate(table, table->migrateStep);
+	const AlfBool mayContain = alfHashTableFilterMayContain(table, hash);
+	uint64_t index;
+	void* value = NULL;
+	if (table->oldBuckets && mayContain)
+	{
+		value = alfHashTableFindOldIndex(table, key, hash, &index);
+	}
+	if (!value && mayContain)
+	{
+		value = alfHashTableLocate(table, key, hash, &index);
+	}
+	if (insertedOut) { *insertedOut = value == NULL; }
+	if (value)
+	{
+		return value;
+	}
+
+	// Copy key. The table is grown if needed, after which the insert index
+	// must be found again
+	void* keyCopy = alfHashTableCopyKey(table, key);
+	if (!keyCopy) { return NULL; }
+	AlfBool grown = ALF_TRUE;
+	AlfBool full = ALF_FALSE;
+	if (alfHashTableGetLoadFactor(table) >= table->maxLoadFactor)
+	{
+		full = !alfHashTableGrow(table, table->bucketCount << 1);
+	}
+	else if ((float)(table->size + table->deletedCount) / 
+		(float)table->bucketCount >= table->maxLoadFactor)
+	{
+		full = !alfHashTableGrow(table, table->bucketCount);
+	}
+	else
+	{
+		grown = ALF_FALSE;
+	}
+	full = full && table->size + 1 >= table->bucketCount;
+	if (full || ((grown || !mayContain) && 
+		!alfHashTableFindInsertIndex(table, hash, &index)))
+	{
+		alfHashTableDestroyKey(table, keyCopy);
+		return NULL;
+	}
+
+	// Insert key with a zero value
+	AlfHashTableBucket* bucket = alfHashTableClaimBucket(table, index, hash);
+	bucket->hash = hash;
+	if (table->keySize)
+	{
+		memcpy((uint8_t*)bucket + table->keyOffset, key, table->keySize);
+	}
+	else
+	{
+		bucket->key = keyCopy;
+	}
+	value = alfHashTableGetBucketValue(table, bucket);
+	memset(value, 0, table->valueSize);
+	table->size++;
+	alfHashTableFilterInsert(table, hash);
+	return value;
+}
+
+// ========================================================================== //
+// HashTable Private Snapshot Functions
+// ========================================================================== //
+
+/** Returns the kind of hash function that a table uses. Zero for the built-in
+ * hash, one for a 32-bit and two for a 64-bit hash function **/
+static uint32_t alfHashTableGetHashKind(
+	PFN_AlfCollectionHash hashFunction,
+	PFN_AlfCollectionHash64 hashFunction64)
+{
+	return hashFunction64 ? 2 : hashFunction ? 1 : 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Write zero bytes to a file to pad the offset up to the alignment of the 
+ * sections of a snapshot **/
+static AlfBool alfHashTableWritePadding(FILE* file, uint64_t* offset)
+{
+	static const uint8_t zeros[ALF_HASH_TABLE_SNAPSHOT_ALIGNMENT] = { 0 };
+	const uint64_t padding = 
+		ALF_ALIGN_POWER_OF_TWO(*offset, ALF_HASH_TABLE_SNAPSHOT_ALIGNMENT) - 
+		*offset;
+	*offset += padding;
+	return fwrite(zeros, 1, (size_t)padding, file) == padding;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Write a snapshot of the current buckets of a table to a file. Buckets are
+ * written in batches, where keys that are not inline are replaced by the 
+ * offset that they are then written at in the key section **/
+static AlfBool alfHashTableWriteSnapshot(AlfHashTable* table, FILE* file)
+{
+	// Setup header
+	const uint64_t bucketBytes = (uint64_t)table->bucketCount * table->bucketSize;
+	AlfHashTableSnapshotHeader header = { 0 };
+	header.magic = ALF_HASH_TABLE_SNAPSHOT_MAGIC;
+	header.version = ALF_HASH_TABLE_SNAPSHOT_VERSION;
+	header.layout = table->layout;
+	header.bucketCount = table->bucketCount;
+	header.size = table->size;
+	header.bucketSize = table->bucketSize;
+	header.keySize = table->keySize;
+	header.valueSize = table->valueSize;
+	header.hashKind = 
+		alfHashTableGetHashKind(table->hashFunction, table->hashFunction64);
+	header.hashSeed = table->hashSeed;
+	header.bucketOffset = ALF_ALIGN_POWER_OF_TWO(
+		sizeof(AlfHashTableSnapshotHeader), ALF_HASH_TABLE_SNAPSHOT_ALIGNMENT);
+	header.keyOffset = header.bucketOffset + bucketBytes;
+	if (table->control)
+	{
+		header.controlOffset = ALF_ALIGN_POWER_OF_TWO(
+			header.keyOffset, ALF_HASH_TABLE_SNAPSHOT_ALIGNMENT);
+		header.keyOffset = header.controlOffset + table->bucketCount;
+	}
+	header.keyOffset = 
+		ALF_ALIGN_POWER_OF_TWO(header.keyOffset, ALF_HASH_TABLE_SNAPSHOT_ALIGNMENT);
+
+	// Write header
+	uint64_t offset = sizeof(AlfHashTableSnapshotHeader);
+	AlfBool success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+		alfHashTableWritePadding(file, &offset);
+
+	// Write buckets
+	const uint64_t batchSize = 
+		(uint64_t)table->bucketSize * ALF_HASH_TABLE_SNAPSHOT_BATCH_SIZE;
+	uint8_t* batch = alfAllocatorAlloc(&table->allocator, batchSize);
+	success = success && batch;
+	uint64_t keyOffset = header.keyOffset;
+	for (uint64_t first = 0; first < table->bucketCount && success;
+		first += ALF_HASH_TABLE_SNAPSHOT_BATCH_SIZE)
+	{
+		const uint64_t count = ALF_COLLECTION_MIN(
+			table->bucketCount - first, ALF_HASH_TABLE_SNAPSHOT_BATCH_SIZE);
+		for (uint64_t i = 0; i < count; i++)
+		{
+			AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+				table->buckets, table->bucketSize, first + i);
+			AlfHashTableBucket* copy = 
+				alfHashTableGetBucketAtIndex(batch, table->bucketSize, i);
+			if (bucket->hash == 0)
+			{
+				memset(copy, 0, table->bucketSize);
+				continue;
+			}
+			memcpy(copy, bucket, table->bucketSize);
+			if (!table->keySize)
+			{
+				copy->key = (void*)(uintptr_t)keyOffset;
+				keyOffset += 
+					strlen(alfHashTableGetBucketKey(table, bucket)) + 1;
+			}
+		}
+		success = fwrite(batch, table->bucketSize, count, file) == count;
+	}
+	alfAllocatorFree(&table->allocator, batch, batchSize);
+	offset += bucketBytes;
+
+	// Write control bytes
+	if (table->control)
+	{
+		success = success && alfHashTableWritePadding(file, &offset) &&
+			fwrite(table->control, 1, table->bucketCount, file) == 
+			table->bucketCount;
+		offset += table->bucketCount;
+	}
+
+	// Write keys, in the same order as their offsets were assigned
+	success = success && alfHashTableWritePadding(file, &offset);
+	for (uint64_t i = 0; i < table->bucketCount && success && !table->keySize; 
+		i++)
+	{
+		AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, i);
+		if (bucket->hash != 0)
+		{
+			const char* key = alfHashTableGetBucketKey(table, bucket);
+			const size_t length = strlen(key) + 1;
+			success = fwrite(key, 1, length, file) == length;
+		}
+	}
+	return success;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Map a file read-only into memory. Returns NULL if the file could not be 
+ * opened or is empty, otherwise 'sizeOut' is set to the size of the file **/
+static uint8_t* alfHashTableMapFile(const char* path, uint64_t* sizeOut)
+{
+	uint8_t* data = NULL;
+#if defined(ALF_COLLECTION_TARGET_WINDOWS)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, 
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) { return NULL; }
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		HANDLE mapping = 
+			CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping)
+		{
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+		*sizeOut = (uint64_t)size.QuadPart;
+	}
+	CloseHandle(file);
+#else
+	const int file = open(path, O_RDONLY);
+	if (file < 0) { return NULL; }
+	struct stat info;
+	if (fstat(file, &info) == 0 && info.st_size > 0)
+	{
+		void* mapping = 
+			mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+		data = mapping == MAP_FAILED ? NULL : mapping;
+		*sizeOut = (uint64_t)info.st_size;
+	}
+	close(file);
+#endif
+	return data;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Unmap memory that was mapped with alfHashTableMapFile **/
+static void alfHashTableUnmapFile(uint8_t* data, uint64_t size)
+{
+#if defined(ALF_COLLECTION_TARGET_WINDOWS)
+	UnmapViewOfFile(data);
+#else
+	munmap(data, (size_t)size);
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether the header of a mapped snapshot is valid and describes a 
+ * table that matches the descriptor, if any. Every section must lie within the
+ * file, and for keys that are not inline each occupied bucket must reference a
+ * null-terminated string in the key section **/
+static AlfBool alfHashTableValidateSnapshot(
+	const uint8_t* data,
+	uint64_t size,
+	const AlfHashTableDesc* desc)
+{
+	// Validate header and sections, written to avoid overflow on corrupt sizes
+	const AlfHashTableSnapshotHeader* header = 
+		(const AlfHashTableSnapshotHeader*)data;
+	if (size < sizeof(AlfHashTableSnapshotHeader) ||
+		header->magic != ALF_HASH_TABLE_SNAPSHOT_MAGIC ||
+		header->version != ALF_HASH_TABLE_SNAPSHOT_VERSION ||
+		header->layout > ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES ||
+		!ALF_IS_POWER_OF_TWO(header->bucketCount) ||
+		header->bucketSize < sizeof(AlfHashTableBucket) ||
+		header->bucketSize % ALF_HASH_TABLE_VALUE_ALIGNMENT != 0 ||
+		header->bucketOffset % ALF_HASH_TABLE_SNAPSHOT_ALIGNMENT != 0 ||
+		header->bucketOffset > size ||
+		header->bucketCount > 
+		(size - header->bucketOffset) / header->bucketSize ||
+		header->keyOffset > size)
+	{
+		return ALF_FALSE;
+	}
+	if (header->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES && 
+		(!header->controlOffset || header->controlOffset > size ||
+		header->bucketCount > size - header->controlOffset))
+	{
+		return ALF_FALSE;
+	}
+	if (desc && (header->keySize != desc->keySize || 
+		header->valueSize != desc->valueSize ||
+		header->hashKind != 
+		alfHashTableGetHashKind(desc->hashFunction, desc->hashFunction64)))
+	{
+		return ALF_FALSE;
+	}
+	if (!desc && header->hashKind != 0)
+	{
+		return ALF_FALSE;
+	}
+
+	// Validate key offsets of keys that are not inline
+	for (uint64_t i = 0; i < header->bucketCount && !header->keySize; i++)
+	{
+		const AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			(uint8_t*)data + header->bucketOffset, header->bucketSize, i);
+		const uint64_t offset = (uint64_t)(uintptr_t)bucket->key;
+		if (bucket->hash != 0 && (offset < header->keyOffset || 
+			offset >= size || 
+			!memchr(data + offset, 0, (size_t)(size - offset))))
+		{
+			return ALF_FALSE;
+		}
+	}
+	return ALF_TRUE;
+}
+
+// ========================================================================== //
+// HashTable Functions
+// ========================================================================== //
+
+AlfHashTable* alfCreateHashTable(const AlfHashTableDesc* desc)
+{
+	// Assert the preconditions
+	ALF_COLLECTION_ASSERT(
+		ALF_IS_POWER_OF_TWO(desc->bucketCount),
+		"Bucket count of hash table must be a power of two"
+	);
+	ALF_COLLECTION_ASSERT(
+		desc->keySize || (desc->keyEqual && (desc->keyCopy || 
+		desc->keyStorage == ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)),
+		"Hash table with keys stored by pointer requires key functions"
+	);
+	ALF_COLLECTION_ASSERT(
+		desc->keySize || desc->hashFunction || desc->hashFunction64 ||
+		desc->keyStorage == ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA,
+		"Hash table requires hash function unless keys are inline or strings"
+	);
+
+	// Allocate and setup table
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfHashTable* table = alfAllocatorAlloc(&allocator, sizeof(AlfHashTable));
+	if (!table) { return NULL; }
+	alfHashTableSetupSettings(table, desc);
+
+	// Setup buckets
+	table->minBucketCount = 
+		alfHashTableClampBucketCount(table, desc->bucketCount);
+	if (!alfHashTableSetupBuckets(table, table->minBucketCount))
+	{
+		alfAllocatorFree(&allocator, table, sizeof(AlfHashTable));
+		return NULL;
+	}
+
+	return table;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfHashTable* alfCreateHashTableSimple(
+	uint32_t valueSize, 
+	PFN_AlfCollectionCleaner valueCleaner)
+{
+	// Setup descriptor for hash table using strings as keys
+	AlfHashTableDesc desc = { 0 };
+	desc.bucketCount = ALF_DEFAULT_HASH_TABLE_BUCKET_COUNT;
+	desc.valueSize = valueSize;
+	desc.keyEqual = alfStringEqualFunction;
+	desc.keyStorage = ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA;
+	desc.valueCleaner = valueCleaner;
+	return alfCreateHashTable(&desc);
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfDestroyHashTable(AlfHashTable* table)
+{
+	// Keys and values of a mapped table belong to the snapshot
+	if (table->mapping)
+	{
+		alfHashTableUnmapFile(table->mapping, table->mappingSize);
+		alfAllocatorFree(&table->allocator, table, sizeof(AlfHashTable));
+		return;
+	}
+
+	// Cleanup all remaining buckets, both current and old
+	for (uint32_t n = 0; n < 2; n++)
+	{
+		uint8_t* buckets = n == 0 ? table->buckets : table->oldBuckets;
+		const uint64_t bucketCount = 
+			n == 0 ? table->bucketCount : table->oldBucketCount;
+		for (uint64_t i = 0; i < bucketCount; i++)
+		{
+			AlfHashTableBucket* bucket =
+				alfHashTableGetBucketAtIndex(buckets, table->bucketSize, i);
+			if (bucket->hash != 0)
+			{
+				if (table->keyStorage != ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)
+				{
+					alfHashTableDestroyKey(table, bucket->key);
+				}
+				table->valueCleaner(alfHashTableGetBucketValue(table, bucket));
+			}
+		}
+	}
+
+	// Free all keys in the string arena at once
+	alfHashTableArenaFree(table);
+
+	// Free table
+	alfHashTableDisableFilter(table);
+	alfHashTableFreeBuckets(
+		table, table->oldBuckets, table->oldControl, table->oldBucketCount);
+	alfHashTableFreeBuckets(
+		table, table->buckets, table->control, table->bucketCount);
+	const AlfAllocator allocator = table->allocator;
+	alfAllocatorFree(&allocator, table, sizeof(AlfHashTable));
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfHashTableInsert(
+	AlfHashTable* table, 
+	const void* key, 
+	const void* value)
+{
+	ALF_COLLECTION_ASSERT(!table->mapping, "Mapped hash tables are read-only");
+	if (table->mapping) { return ALF_FALSE; }
+	return alfHashTableInsertHashed(
+		table, key, alfHashTableGetKeyHash(table, key), value);
+}
+
+// -------------------------------------------------------------------------- //
+
+void* alfHashTableGet(AlfHashTable* table, const void* key)
+{
+	return alfHashTableGetHashed(table, key, alfHashTableGetKeyHash(table, key));
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t alfHashTableGetBatch(
+	AlfHashTable* table,
+	const void* const* keys,
+	uint32_t count,
+	void** valuesOut)
+{
+	uint64_t hashes[ALF_HASH_TABLE_BATCH_SIZE];
+	uint32_t foundCount = 0;
+	for (uint32_t first = 0; first < count; first += ALF_HASH_TABLE_BATCH_SIZE)
+	{
+		const uint32_t batchCount = count - first < ALF_HASH_TABLE_BATCH_SIZE ?
+			count - first : ALF_HASH_TABLE_BATCH_SIZE;
+
+		// Hash all keys and prefetch the first bucket or control group that 
+		// each probe reads
+		for (uint32_t i = 0; i < batchCount; i++)
+		{
+			const uint64_t hash = alfHashTableGetKeyHash(table, keys[first + i]);
+			hashes[i] = hash;
+			if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+			{
+				const uint64_t groupCount = 
+					table->bucketCount / ALF_HASH_TABLE_GROUP_WIDTH;
+				ALF_COLLECTION_PREFETCH(table->control + 
+					ALF_MOD_POWER_OF_TWO(hash, groupCount) * 
+					ALF_HASH_TABLE_GROUP_WIDTH);
+			}
+			else
+			{
+				ALF_COLLECTION_PREFETCH(alfHashTableGetBucketAtIndex(
+					table->buckets, table->bucketSize, 
+					ALF_MOD_POWER_OF_TWO(hash, table->bucketCount)));
+			}
+		}
+
+		// Resolve the probes
+		for (uint32_t i = 0; i < batchCount; i++)
+		{
+			void* value = 
+				alfHashTableGetHashed(table, keys[first + i], hashes[i]);
+			valuesOut[first + i] = value;
+			foundCount += value != NULL;
+		}
+	}
+	return foundCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+void* alfHashTableFindOrInsert(
+	AlfHashTable* table,
+	const void* key,
+	AlfBool* insertedOut)
+{
+	ALF_COLLECTION_ASSERT(!table->mapping, "Mapped hash tables are read-only");
+	if (table->mapping) { return NULL; }
+	return alfHashTableFindOrInsertHashed(
+		table, key, alfHashTableGetKeyHash(table, key), insertedOut);
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfHashTableRemove(AlfHashTable* table, const void* key, void* valueOut)
+{
+	ALF_COLLECTION_ASSERT(!table->mapping, "Mapped hash tables are read-only");
+	if (table->mapping) { return ALF_FALSE; }
+	return alfHashTableRemoveHashed(
+		table, key, alfHashTableGetKeyHash(table, key), valueOut);
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfHasKey(AlfHashTable* table, const void* key)
+{
+	return alfHashTableGet(table, key) != NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfHashTableResize(AlfHashTable* table, uint64_t size)
+{
+	// Assert the preconditions
+	ALF_COLLECTION_ASSERT(
+		ALF_IS_POWER_OF_TWO(size),
+		"Hash table can only be resized to power of two sizes"
+	);
+	ALF_COLLECTION_ASSERT(!table->mapping, "Mapped hash tables are read-only");
+	if (table->mapping) { return; }
+
+	alfHashTableRebuild(table, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfHashTableIterate(AlfHashTable* table, PFN_AlfHashTableIterate iterateFunction)
+{
+	// Iterate the current buckets and then the old buckets, if any remain
+	uint32_t index = 0;
+	for (uint32_t n = 0; n < 2; n++)
+	{
+		uint8_t* buckets = n == 0 ? table->buckets : table->oldBuckets;
+		const uint64_t bucketCount = 
+			n == 0 ? table->bucketCount : table->oldBucketCount;
+		for (uint64_t i = 0; i < bucketCount; i++)
+		{
+			// Retrieve bucket
+			AlfHashTableBucket* bucket = 
+				alfHashTableGetBucketAtIndex(buckets, table->bucketSize, i);
+
+			// Call the iterator function for key-value pair if hash is valid
+			if (bucket->hash != 0)
+			{
+				const AlfBool cont = iterateFunction(table, index, 
+					alfHashTableGetBucketKey(table, bucket), 
+					alfHashTableGetBucketValue(table, bucket));
+				if (!cont) { return ALF_FALSE; }
+				index++;
+			}
+		}
+	}
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfHashTableMerge(
+	AlfHashTable* destination,
+	AlfHashTable* source,
+	PFN_AlfHashTableCombine combine)
+{
+	// Assert the preconditions
+	ALF_COLLECTION_ASSERT(destination != source, "Table cannot merge itself");
+	ALF_COLLECTION_ASSERT(
+		destination->keySize == source->keySize &&
+		destination->valueSize == source->valueSize &&
+		destination->hashFunction == source->hashFunction &&
+		destination->hashFunction64 == source->hashFunction64 &&
+		destination->hashSeed == source->hashSeed,
+		"Merged hash tables must have the same keys, values and hash function"
+	);
+	ALF_COLLECTION_ASSERT(
+		!destination->mapping, 
+		"Mapped hash tables are read-only"
+	);
+	if (destination->mapping) { return ALF_FALSE; }
+
+	// Make room for all source entries, so that the destination is resized at
+	// most once during the merge
+	uint64_t bucketCount = destination->bucketCount;
+	while ((float)(destination->size + source->size) >= 
+		(float)bucketCount * destination->maxLoadFactor && 
+		bucketCount < (1ull << 63))
+	{
+		bucketCount <<= 1;
+	}
+	if (bucketCount != destination->bucketCount)
+	{
+		alfHashTableResize(destination, bucketCount);
+	}
+
+	// Insert or combine the entries of the current and old source buckets,
+	// reusing the cached hashes
+	for (uint32_t n = 0; n < 2; n++)
+	{
+		uint8_t* buckets = n == 0 ? source->buckets : source->oldBuckets;
+		const uint64_t count = 
+			n == 0 ? source->bucketCount : source->oldBucketCount;
+		for (uint64_t i = 0; i < count; i++)
+		{
+			AlfHashTableBucket* bucket = 
+				alfHashTableGetBucketAtIndex(buckets, source->bucketSize, i);
+			if (bucket->hash == 0) { continue; }
+			AlfBool inserted;
+			void* value = alfHashTableFindOrInsertHashed(destination, 
+				alfHashTableGetBucketKey(source, bucket), bucket->hash, 
+				&inserted);
+			if (!value) { return ALF_FALSE; }
+			const void* sourceValue = 
+				alfHashTableGetBucketValue(source, bucket);
+			if (inserted || !combine)
+			{
+				memcpy(value, sourceValue, destination->valueSize);
+			}
+			else
+			{
+				combine(value, sourceValue);
+			}
+		}
+	}
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfHashTableSetMaxLoadFactor(AlfHashTable* table, float loadFactor)
+{
+	table->maxLoadFactor = loadFactor;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfHashTableSetMinLoadFactor(AlfHashTable* table, float loadFactor)
+{
+	table->minLoadFactor = loadFactor;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfHashTableSetAutomaticShrink(AlfHashTable* table, AlfBool enabled)
+{
+	table->automaticShrink = enabled;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfHashTableSetIncrementalResize(
+	AlfHashTable* table, 
+	uint32_t bucketsPerStep)
+{
+	// Complete any incremental resize in progress if disabled
+	if (!bucketsPerStep)
+	{
+		alfHashTableMigrate(table, UINT64_MAX);
+	}
+
+	// Two buckets per step guarantees that the migration completes before the
+	// new buckets reach the maximum load factor
+	if (bucketsPerStep && bucketsPerStep < ALF_HASH_TABLE_MIN_MIGRATE_STEP)
+	{
+		bucketsPerStep = ALF_HASH_TABLE_MIN_MIGRATE_STEP;
+	}
+	table->migrateStep = bucketsPerStep;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfHashTableEnableFilter(AlfHashTable* table, AlfFilterType type)
+{
+	ALF_COLLECTION_ASSERT(!table->mapping, "Mapped hash tables are read-only");
+	if (table->mapping) { return ALF_FALSE; }
+	return alfHashTableBuildFilter(table, type, table->bucketCount);
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfHashTableDisableFilter(AlfHashTable* table)
+{
+	if (table->filter)
+	{
+		alfDestroyFilter(table->filter);
+		table->filter = NULL;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+float alfHashTableGetLoadFactor(AlfHashTable* table)
+{
+	return (float)table->size / (float)table->bucketCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfHashTableGetSize(AlfHashTable* table)
+{
+	return table->size;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfHashTableGetStatistics(
+	AlfHashTable* table,
+	AlfHashTableStatistics* statisticsOut)
+{
+	// Counters are gathered by the operations, if enabled
+#if defined(ALF_COLLECTION_STATISTICS)
+	*statisticsOut = table->statistics;
+#else
+	memset(statisticsOut, 0, sizeof(AlfHashTableStatistics));
+#endif
+
+	// Compute occupancy and displacement from the buckets
+	statisticsOut->size = table->size;
+	statisticsOut->bucketCount = 
+		(uint64_t)table->bucketCount + table->oldBucketCount;
+	statisticsOut->tombstoneCount = table->deletedCount;
+	statisticsOut->maxDisplacement = 0;
+	for (uint32_t n = 0; n < 2; n++)
+	{
+		uint8_t* buckets = n == 0 ? table->buckets : table->oldBuckets;
+		const uint64_t bucketCount = 
+			n == 0 ? table->bucketCount : table->oldBucketCount;
+		for (uint64_t i = 0; i < bucketCount; i++)
+		{
+			AlfHashTableBucket* bucket =
+				alfHashTableGetBucketAtIndex(buckets, table->bucketSize, i);
+			if (bucket->hash != 0)
+			{
+				const uint64_t displacement = alfHashTableGetDisplacement(
+					table, bucketCount, bucket->hash, i);
+				if (displacement > statisticsOut->maxDisplacement)
+				{
+					statisticsOut->maxDisplacement = displacement;
+				}
+			}
+		}
+	}
+
+	// Compute allocated bytes. Buckets of mapped tables are not allocated
+	uint64_t allocatedBytes = sizeof(AlfHashTable);
+	if (!table->mapping)
+	{
+		allocatedBytes += statisticsOut->bucketCount * table->bucketSize;
+		allocatedBytes += table->control ? table->bucketCount : 0;
+		allocatedBytes += table->oldControl ? table->oldBucketCount : 0;
+	}
+	for (AlfHashTableArenaChunk* chunk = table->arenaChunks; chunk; 
+		chunk = chunk->next)
+	{
+		allocatedBytes += sizeof(AlfHashTableArenaChunk) + chunk->capacity;
+	}
+	statisticsOut->allocatedBytes = allocatedBytes;
+
+#if defined(ALF_COLLECTION_STATISTICS)
+	return ALF_TRUE;
+#else
+	return ALF_FALSE;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfHashTableResetStatistics(AlfHashTable* table)
+{
+#if defined(ALF_COLLECTION_STATISTICS)
+	memset(&table->statistics, 0, sizeof(AlfHashTableStatistics));
+#else
+	(void)table;
+#endif
+}
+
+// ========================================================================== //
+// HashTable Snapshot Functions
+// ========================================================================== //
+
+AlfBool alfHashTableSave(AlfHashTable* table, const char* path)
+{
+	// Only the current buckets are saved, so complete any incremental resize
+	alfHashTableMigrate(table, UINT64_MAX);
+
+	// Write snapshot, and remove the file if it could not be written in full
+	FILE* file = fopen(path, "wb");
+	if (!file) { return ALF_FALSE; }
+	AlfBool success = alfHashTableWriteSnapshot(table, file);
+	success = fclose(file) == 0 && success;
+	if (!success)
+	{
+		remove(path);
+	}
+	return success;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfHashTable* alfHashTableMap(const char* path, const AlfHashTableDesc* desc)
+{
+	// Map and validate snapshot
+	uint64_t size = 0;
+	uint8_t* data = alfHashTableMapFile(path, &size);
+	if (!data) { return NULL; }
+	const AlfHashTableSnapshotHeader* header = 
+		(const AlfHashTableSnapshotHeader*)data;
+	AlfHashTable* table = NULL;
+	const AlfAllocator allocator = 
+		alfAllocatorOrDefault(desc ? desc->allocator : NULL);
+	if (alfHashTableValidateSnapshot(data, size, desc))
+	{
+		table = alfAllocatorAlloc(&allocator, sizeof(AlfHashTable));
+	}
+	if (!table)
+	{
+		alfHashTableUnmapFile(data, size);
+		return NULL;
+	}
+
+	// Setup table settings
+	table->automaticShrink = ALF_FALSE;
+	table->valueSize = header->valueSize;
+	table->keySize = header->keySize;
+	table->keyStorage = ALF_HASH_TABLE_KEY_STORAGE_COPY;
+	table->arenaChunks = NULL;
+	table->arenaUsedBytes = 0;
+	table->arenaDeadBytes = 0;
+	table->hashFunction = desc ? desc->hashFunction : NULL;
+	table->hashFunction64 = desc ? desc->hashFunction64 : NULL;
+	table->hashSeed = header->hashSeed;
+	table->keyEqual = desc && desc->keyEqual ? desc->keyEqual : 
+		table->keySize ? NULL : alfStringEqualFunction;
+	table->keyCopy = NULL;
+	table->keyDestructor = alfDefaultDestructor;
+	table->valueCleaner = alfDefaultCleaner;
+
+	// Point buckets, control bytes and keys into the mapped memory
+	table->maxLoadFactor = ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_RESIZE;
+	table->minLoadFactor = ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_SHRINK;
+	table->layout = header->layout;
+	table->pages = ALF_HASH_TABLE_PAGES_DEFAULT;
+	table->filter = NULL;
+	table->filterStaleCount = 0;
+	table->allocator = allocator;
+	table->size = header->size;
+	alfHashTableSetupLayout(table);
+	table->bucketCount = header->bucketCount;
+	table->minBucketCount = header->bucketCount;
+	table->buckets = data + header->bucketOffset;
+	table->control = 
+		header->controlOffset ? data + header->controlOffset : NULL;
+	table->deletedCount = 0;
+	table->keyBase = (uintptr_t)data;
+	table->mapping = data;
+	table->mappingSize = size;
+	table->migrateStep = 0;
+	table->oldBucketCount = 0;
+	table->oldBuckets = NULL;
+	table->oldControl = NULL;
+#if defined(ALF_COLLECTION_STATISTICS)
+	memset(&table->statistics, 0, sizeof(AlfHashTableStatistics));
+#endif
+
+	// Bucket size differs if the snapshot was saved on another platform
+	if (table->bucketSize != header->bucketSize)
+	{
+		alfDestroyHashTable(table);
+		return NULL;
+	}
+	return table;
+}
+
+// ========================================================================== //
+// FrozenHashTable Structures
+// ========================================================================== //
+
+/** Average number of keys in each displacement bucket of a frozen table **/
+#define ALF_FROZEN_HASH_TABLE_KEYS_PER_BUCKET 4
+
+// -------------------------------------------------------------------------- //
+
+/** Flag of a displacement that directly holds the slot of a single key **/
+#define ALF_FROZEN_HASH_TABLE_DIRECT_SLOT 0x80000000u
+
+// -------------------------------------------------------------------------- //
+
+/** Number of displacements that are tried for a bucket before freezing fails.
+ * With mixed hashes a bucket is almost always placed in a handful of tries **/
+#define ALF_FROZEN_HASH_TABLE_MAX_DISPLACEMENT (1u << 20)
+
+// -------------------------------------------------------------------------- //
+
+/** Frozen hash table structure **/
+typedef struct tag_AlfFrozenHashTable
+{
+	/** Hash table that the frozen table was created from. Only the settings
+	 * and the key storage are used, the bucket arrays are released **/
+	AlfHashTable table;
+	/** Number of slots, one for each entry **/
+	uint32_t slotCount;
+	/** Slots, with the same layout as the buckets of the hash table **/
+	uint8_t* slots;
+	/** Number of displacements **/
+	uint32_t displacementCount;
+	/** Displacement of each bucket of keys **/
+	uint32_t* displacements;
+	/** Number of overflow entries **/
+	uint32_t overflowCount;
+	/** Entries whose hashes collide with another entry **/
+	uint8_t* overflow;
+} tag_AlfFrozenHashTable;
+
+// ========================================================================== //
+// FrozenHashTable Private Functions
+// ========================================================================== //
+
+/** Map a 32-bit number uniformly to the range [0, count) **/
+static uint32_t alfFrozenHashTableReduce(uint32_t value, uint32_t count)
+{
+	return (uint32_t)(((uint64_t)value * count) >> 32);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Mix the hash of a key before it picks a bucket and a slot. Hash functions
+ * are free to return values with few significant bits, such as the identity 
+ * of an integer key, which would otherwise all map to the same bucket **/
+static uint64_t alfFrozenHashTableMixHash(uint64_t hash)
+{
+	return alfHashMix(hash ^ ALF_HASH_SECRET_0, ALF_HASH_SECRET_2);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the displacement bucket of a mixed hash. The high bits are used so
+ * that the bucket does not correlate with the slot **/
+static uint32_t alfFrozenHashTableGetBucket(
+	AlfFrozenHashTable* table,
+	uint64_t mixed)
+{
+	return alfFrozenHashTableReduce(
+		(uint32_t)(mixed >> 32), table->displacementCount);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the slot of a mixed hash for a displacement. The displacement 
+ * either holds the slot directly or is mixed with the hash to find the slot **/
+static uint32_t alfFrozenHashTableGetSlot(
+	AlfFrozenHashTable* table,
+	uint64_t mixed,
+	uint32_t displacement)
+{
+	if (displacement & ALF_FROZEN_HASH_TABLE_DIRECT_SLOT)
+	{
+		return displacement & ~ALF_FROZEN_HASH_TABLE_DIRECT_SLOT;
+	}
+	const uint64_t slotHash = 
+		alfHashMix(mixed ^ displacement, ALF_HASH_SECRET_3);
+	return alfFrozenHashTableReduce(
+		(uint32_t)(slotHash >> 32), table->slotCount);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a slot is taken in a bit set of taken slots **/
+static AlfBool alfFrozenHashTableIsTaken(const uint64_t* taken, uint32_t slot)
+{
+	return (taken[slot >> 6] >> (slot & 63)) & 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Set whether a slot is taken in a bit set of taken slots **/
+static void alfFrozenHashTableSetTaken(
+	uint64_t* taken,
+	uint32_t slot,
+	AlfBool isTaken)
+{
+	if (isTaken) { taken[slot >> 6] |= 1ull << (slot & 63); }
+	else { taken[slot >> 6] &= ~(1ull << (slot & 63)); }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Group the entries of a table by displacement bucket with a counting sort. 
+ * Entries with the same hash always end up in the same bucket, where all but 
+ * the first are moved to the overflow. The 'bucketStart' array receives the 
+ * start of each bucket in 'sorted', followed by the total count **/
+static AlfBool alfFrozenHashTableGroup(
+	AlfFrozenHashTable* table,
+	AlfHashTableBucket** entries,
+	uint32_t entryCount,
+	AlfHashTableBucket** sorted,
+	uint32_t* bucketStart)
+{
+	// Sort entries by bucket
+	const uint32_t bucketCount = table->displacementCount;
+	memset(bucketStart, 0, sizeof(uint32_t) * (bucketCount + 1));
+	for (uint32_t i = 0; i < entryCount; i++)
+	{
+		const uint64_t mixed = alfFrozenHashTableMixHash(entries[i]->hash);
+		bucketStart[alfFrozenHashTableGetBucket(table, mixed) + 1]++;
+	}
+	for (uint32_t i = 1; i <= bucketCount; i++)
+	{
+		bucketStart[i] += bucketStart[i - 1];
+	}
+	for (uint32_t i = 0; i < entryCount; i++)
+	{
+		const uint64_t mixed = alfFrozenHashTableMixHash(entries[i]->hash);
+		const uint32_t bucket = alfFrozenHashTableGetBucket(table, mixed);
+		sorted[bucketStart[bucket]++] = entries[i];
+	}
+
+	// Move entries with colliding hashes to the end, and compact buckets
+	uint32_t overflowStart = entryCount;
+	uint32_t count = 0;
+	uint32_t first = 0;
+	for (uint32_t bucket = 0; bucket < bucketCount; bucket++)
+	{
+		const uint32_t end = bucketStart[bucket];
+		bucketStart[bucket] = count;
+		for (uint32_t i = first; i < end; i++)
+		{
+			AlfBool collides = ALF_FALSE;
+			for (uint32_t j = bucketStart[bucket]; j < count && !collides; j++)
+			{
+				collides = sorted[j]->hash == sorted[i]->hash;
+			}
+			if (collides) { entries[--overflowStart] = sorted[i]; }
+			else { sorted[count++] = sorted[i]; }
+		}
+		first = end;
+	}
+	bucketStart[bucketCount] = count;
+
+	// Allocate slots and copy overflow
+	table->slotCount = count;
+	table->overflowCount = entryCount - count;
+	const uint32_t bucketSize = table->table.bucketSize;
+	table->slots = alfAllocatorAlloc(
+		&table->table.allocator, (uint64_t)bucketSize * count + 1);
+	table->overflow = alfAllocatorAlloc(&table->table.allocator, 
+		(uint64_t)bucketSize * table->overflowCount + 1);
+	if (!table->slots || !table->overflow)
+	{
+		return ALF_FALSE;
+	}
+	for (uint32_t i = 0; i < table->overflowCount; i++)
+	{
+		memcpy(alfHashTableGetBucketAtIndex(table->overflow, bucketSize, i),
+			entries[overflowStart + i], bucketSize);
+	}
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Free the slots, overflow and displacements of a frozen table **/
+static void alfFrozenHashTableFreeArrays(AlfFrozenHashTable* table)
+{
+	const AlfAllocator* allocator = &table->table.allocator;
+	const uint64_t bucketSize = table->table.bucketSize;
+	alfAllocatorFree(allocator, table->overflow, 
+		bucketSize * table->overflowCount + 1);
+	alfAllocatorFree(allocator, table->displacements, 
+		sizeof(uint32_t) * table->displacementCount);
+	alfAllocatorFree(
+		allocator, table->slots, bucketSize * table->slotCount + 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Place the entries of a table in the slots of a frozen table. The entries are
+ * grouped into buckets by hash and the buckets are placed from the largest to
+ * the smallest. For each bucket the first displacement that maps all of its
+ * entries to free slots is chosen. Buckets with a single entry are given a 
+ * free slot directly, which means that placement never fails at the end when
+ * few slots remain (CHD, compress-hash-displace). Placement fails if no 
+ * displacement is found for a bucket within a bounded number of tries **/
+static AlfBool alfFrozenHashTablePlace(
+	AlfFrozenHashTable* table,
+	AlfHashTableBucket** entries,
+	uint32_t entryCount)
+{
+	const uint32_t bucketCount = table->displacementCount;
+	const AlfAllocator* allocator = &table->table.allocator;
+	uint32_t* bucketStart = 
+		alfAllocatorAlloc(allocator, sizeof(uint32_t) * (bucketCount + 1));
+	AlfHashTableBucket** sorted = alfAllocatorAlloc(
+		allocator, sizeof(AlfHashTableBucket*) * ((uint64_t)entryCount + 1));
+	uint32_t* order = 
+		alfAllocatorAlloc(allocator, sizeof(uint32_t) * bucketCount);
+	uint32_t* slotsOut = 
+		alfAllocatorAlloc(allocator, sizeof(uint32_t) * ((uint64_t)entryCount + 1));
+	uint64_t* taken = 
+		alfAllocatorAlloc(allocator, sizeof(uint64_t) * (entryCount / 64 + 1));
+	AlfBool success = bucketStart && sorted && order && slotsOut && taken &&
+		alfFrozenHashTableGroup(table, entries, entryCount, sorted, bucketStart);
+	if (success)
+	{
+		// Order buckets from largest to smallest with a counting sort
+		uint32_t maxSize = 0;
+		for (uint32_t i = 0; i < bucketCount; i++)
+		{
+			const uint32_t size = bucketStart[i + 1] - bucketStart[i];
+			maxSize = size > maxSize ? size : maxSize;
+		}
+		uint32_t orderCount = 0;
+		for (uint32_t size = maxSize; size > 0; size--)
+		{
+			for (uint32_t i = 0; i < bucketCount; i++)
+			{
+				if (bucketStart[i + 1] - bucketStart[i] == size)
+				{
+					order[orderCount++] = i;
+				}
+			}
+		}
+		memset(table->displacements, 0, sizeof(uint32_t) * bucketCount);
+		memset(taken, 0, sizeof(uint64_t) * (entryCount / 64 + 1));
+
+		// Place each bucket
+		uint32_t nextFree = 0;
+		for (uint32_t n = 0; n < orderCount && success; n++)
+		{
+			const uint32_t bucket = order[n];
+			const uint32_t first = bucketStart[bucket];
+			const uint32_t size = bucketStart[bucket + 1] - first;
+			if (size == 1)
+			{
+				while (alfFrozenHashTableIsTaken(taken, nextFree)) { nextFree++; }
+				alfFrozenHashTableSetTaken(taken, nextFree, ALF_TRUE);
+				table->displacements[bucket] = 
+					nextFree | ALF_FROZEN_HASH_TABLE_DIRECT_SLOT;
+				slotsOut[first] = nextFree;
+				continue;
+			}
+
+			// Search for a displacement that maps all entries to free slots
+			success = ALF_FALSE;
+			for (uint32_t displacement = 0; 
+				displacement < ALF_FROZEN_HASH_TABLE_MAX_DISPLACEMENT && 
+				!success; displacement++)
+			{
+				uint32_t placed = 0;
+				for (; placed < size; placed++)
+				{
+					const uint64_t mixed = 
+						alfFrozenHashTableMixHash(sorted[first + placed]->hash);
+					const uint32_t slot = 
+						alfFrozenHashTableGetSlot(table, mixed, displacement);
+					if (alfFrozenHashTableIsTaken(taken, slot)) { break; }
+					alfFrozenHashTableSetTaken(taken, slot, ALF_TRUE);
+					slotsOut[first + placed] = slot;
+				}
+				success = placed == size;
+				if (success)
+				{
+					table->displacements[bucket] = displacement;
+				}
+				while (!success && placed-- > 0)
+				{
+					alfFrozenHashTableSetTaken(
+						taken, slotsOut[first + placed], ALF_FALSE);
+				}
+			}
+		}
+
+		// Copy entries into their slots
+		for (uint32_t i = 0; i < table->slotCount && success; i++)
+		{
+			memcpy(
+				alfHashTableGetBucketAtIndex(
+					table->slots, table->table.bucketSize, slotsOut[i]),
+				sorted[i],
+				table->table.bucketSize);
+		}
+	}
+
+	alfAllocatorFree(allocator, taken, sizeof(uint64_t) * (entryCount / 64 + 1));
+	alfAllocatorFree(
+		allocator, slotsOut, sizeof(uint32_t) * ((uint64_t)entryCount + 1));
+	alfAllocatorFree(allocator, order, sizeof(uint32_t) * bucketCount);
+	alfAllocatorFree(
+		allocator, sorted, sizeof(AlfHashTableBucket*) * ((uint64_t)entryCount + 1));
+	alfAllocatorFree(
+		allocator, bucketStart, sizeof(uint32_t) * (bucketCount + 1));
+	return success;
+}
+
+// ========================================================================== //
+// FrozenHashTable Functions
+// ========================================================================== //
+
+AlfFrozenHashTable* alfHashTableFreeze(AlfHashTable* table)
+{
+	// Entries of mapped tables are not owned by the table. Frozen tables are
+	// indexed with 31 bits, as the top bit of a displacement marks a direct slot
+	if (table->mapping || table->size >= ALF_FROZEN_HASH_TABLE_DIRECT_SLOT)
+	{
+		return NULL;
+	}
+
+	// Collect all entries
+	const uint32_t entryCount = (uint32_t)table->size;
+	const AlfAllocator allocator = table->allocator;
+	const uint64_t entriesSize = 
+		sizeof(AlfHashTableBucket*) * ((uint64_t)entryCount + 1);
+	AlfHashTableBucket** entries = alfAllocatorAlloc(&allocator, entriesSize);
+	if (!entries) { return NULL; }
+	uint32_t collected = 0;
+	for (uint32_t n = 0; n < 2; n++)
+	{
+		uint8_t* buckets = n == 0 ? table->buckets : table->oldBuckets;
+		const uint64_t bucketCount = 
+			n == 0 ? table->bucketCount : table->oldBucketCount;
+		for (uint64_t i = 0; i < bucketCount; i++)
+		{
+			AlfHashTableBucket* bucket =
+				alfHashTableGetBucketAtIndex(buckets, table->bucketSize, i);
+			if (bucket->hash != 0)
+			{
+				entries[collected++] = bucket;
+			}
+		}
+	}
+
+	// Allocate frozen table and place entries
+	AlfFrozenHashTable* frozen = 
+		alfAllocatorAlloc(&allocator, sizeof(AlfFrozenHashTable));
+	if (!frozen)
+	{
+		alfAllocatorFree(&allocator, entries, entriesSize);
+		return NULL;
+	}
+	frozen->table = *table;
+	frozen->slots = NULL;
+	frozen->overflow = NULL;
+	frozen->slotCount = 0;
+	frozen->overflowCount = 0;
+	frozen->displacementCount = 
+		1 + entryCount / ALF_FROZEN_HASH_TABLE_KEYS_PER_BUCKET;
+	frozen->displacements = alfAllocatorAlloc(
+		&allocator, sizeof(uint32_t) * frozen->displacementCount);
+	const AlfBool success = frozen->displacements && 
+		alfFrozenHashTablePlace(frozen, entries, entryCount);
+	alfAllocatorFree(&allocator, entries, entriesSize);
+	if (!success)
+	{
+		alfFrozenHashTableFreeArrays(frozen);
+		alfAllocatorFree(&allocator, frozen, sizeof(AlfFrozenHashTable));
+		return NULL;
+	}
+
+	// The entries, and the key storage, now belong to the frozen table
+	frozen->table.buckets = NULL;
+	frozen->table.control = NULL;
+	frozen->table.oldBuckets = NULL;
+	frozen->table.oldControl = NULL;
+	frozen->table.filter = NULL;
+	alfHashTableDisableFilter(table);
+	alfHashTableFreeBuckets(
+		table, table->oldBuckets, table->oldControl, table->oldBucketCount);
+	alfHashTableFreeBuckets(
+		table, table->buckets, table->control, table->bucketCount);
+	alfAllocatorFree(&allocator, table, sizeof(AlfHashTable));
+	return frozen;
+}
+
+// -------------------------------------------------------------------------- //
+
+void alfDestroyFrozenHashTable(AlfFrozenHashTable* table)
+{
+	// Cleanup all entries, both in slots and overflow
+	AlfHashTable* settings = &table->table;
+	for (uint32_t n = 0; n < 2; n++)
+	{
+		uint8_t* entries = n == 0 ? table->slots : table->overflow;
+		const uint32_t count = n == 0 ? table->slotCount : table->overflowCount;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			AlfHashTableBucket* entry =
+				alfHashTableGetBucketAtIndex(entries, settings->bucketSize, i);
+			if (settings->keyStorage != ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)
+			{
+				alfHashTableDestroyKey(settings, entry->key);
+			}
+			settings->valueCleaner(alfHashTableGetBucketValue(settings, entry));
+		}
+	}
+
+	// Free table
+	alfHashTableArenaFree(settings);
+	alfFrozenHashTableFreeArrays(table);
+	const AlfAllocator allocator = settings->allocator;
+	alfAllocatorFree(&allocator, table, sizeof(AlfFrozenHashTable));
+}
+
+// -------------------------------------------------------------------------- //
+
+void* alfFrozenHashTableGet(AlfFrozenHashTable* table, const void* key)
+{
+	AlfHashTable* settings = &table->table;
+	const uint64_t hash = alfHashTableGetKeyHash(settings, key);
+
+	// Check the single slot that the key can be in
+	if (table->slotCount)
+	{
+		const uint64_t mixed = alfFrozenHashTableMixHash(hash);
+		const uint32_t displacement = 
+			table->displacements[alfFrozenHashTableGetBucket(table, mixed)];
+		AlfHashTableBucket* slot = alfHashTableGetBucketAtIndex(table->slots, 
+			settings->bucketSize, 
+			alfFrozenHashTableGetSlot(table, mixed, displacement));
+		if (slot->hash == hash && alfHashTableKeyEqual(settings, key, slot))
+		{
+			return alfHashTableGetBucketValue(settings, slot);
+		}
+	}
+
+	// Check the overflow
+	for (uint32_t i = 0; i < table->overflowCount; i++)
+	{
+		AlfHashTableBucket* entry = alfHashTableGetBucketAtIndex(
+			table->overflow, settings->bucketSize, i);
+		if (entry->hash == hash && alfHashTableKeyEqual(settings, key, entry))
+		{
+			return alfHashTableGetBucketValue(settings, entry);
+		}
+	}
+	return NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfFrozenHashTableHasKey(AlfFrozenHashTable* table, const void* key)
+{
+	return alfFrozenHashTableGet(table, key) != NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t alfFrozenHashTableGetSize(AlfFrozenHashTable* table)
+{
+	return (uint64_t)table->slotCount + table->overflowCount;
+}
+
+// ========================================================================== //
+// HashTable Parallel Structures
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Maximum number of threads used by a parallel hash table operation **/
+#define ALF_HASH_TABLE_PARALLEL_MAX_THREAD_COUNT 256
+
+// -------------------------------------------------------------------------- //
+
+/** Minimum number of buckets in each region of a parallel hash table 
+ * operation. Tables with fewer buckets are built on fewer threads **/
+#define ALF_HASH_TABLE_PARALLEL_MIN_REGION_SIZE 4096
+
+// -------------------------------------------------------------------------- //
+
+/** Step of a parallel hash table operation **/
+typedef enum AlfHashTableParallelStep
+{
+	/** Create source buckets from keys and values **/
+	ALF_HASH_TABLE_PARALLEL_STEP_STAGE,
+	/** Clear the buckets of the table and count the entries of each region **/
+	ALF_HASH_TABLE_PARALLEL_STEP_COUNT,
+	/** Order entries by region **/
+	ALF_HASH_TABLE_PARALLEL_STEP_SCATTER,
+	/** Place the entries of each region in the table **/
+	ALF_HASH_TABLE_PARALLEL_STEP_PLACE
+} AlfHashTableParallelStep;
+
+// -------------------------------------------------------------------------- //
+
+/** Work of a single thread in a parallel hash table operation. The buckets of
+ * the table are divided into regions, that each thread fills with the entries
+ * whose wanted index is in the region **/
+typedef struct AlfHashTableParallelTask
+{
+	/** Table to place entries in **/
+	AlfHashTable* table;
+	/** Step to perform **/
+	AlfHashTableParallelStep step;
+	/** Index of the thread of the task **/
+	uint32_t threadIndex;
+	/** Number of threads **/
+	uint32_t threadCount;
+
+	/** Source buckets, empty buckets are skipped **/
+	uint8_t* sources;
+	/** Number of source buckets **/
+	uint64_t sourceCount;
+	/** Number of regions, always a power of two **/
+	uint32_t regionCount;
+	/** Base-2 logarithm of the number of buckets in each region **/
+	uint32_t regionShift;
+	/** Offset in the entry order of the next entry of each region, with one row
+	 * of 'regionCount' offsets for each thread **/
+	uint64_t* offsets;
+	/** Entries ordered by region **/
+	AlfHashTableBucket** order;
+	/** Start of each region in the entry order, followed by the entry count **/
+	uint64_t* regionStart;
+	/** Number of entries of each region that did not fit in the region **/
+	uint64_t* overflowCounts;
+
+	/** Keys to create source buckets from **/
+	const void* const* keys;
+	/** Values to create source buckets from **/
+	const void* const* values;
+	/** Settings of the table, with a string arena that is local to the task **/
+	AlfHashTable arena;
+	/** Whether a key could not be copied **/
+	AlfBool failed;
+} AlfHashTableParallelTask;
+
+// ========================================================================== //
+// HashTable Private Parallel Functions
+// ========================================================================== //
+
+/** Returns the number of regions to divide a bucket array into for the 
+ * specified number of threads. A region count below 2 means that the work is
+ * not worth dividing **/
+static uint32_t alfHashTableGetParallelRegionCount(
+	uint64_t bucketCount,
+	uint32_t threadCount)
+{
+	uint32_t regionCount = 1;
+	while (regionCount < threadCount)
+	{
+		regionCount <<= 1;
+	}
+	while (regionCount > 1 && 
+		bucketCount / regionCount < ALF_HASH_TABLE_PARALLEL_MIN_REGION_SIZE)
+	{
+		regionCount >>= 1;
+	}
+	return regionCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the first index of the part of a range that belongs to a thread **/
+static uint64_t alfHashTableGetParallelSlice(
+	uint64_t count,
+	uint32_t threadIndex,
+	uint32_t threadCount)
+{
+	return count / threadCount * threadIndex + 
+		count % threadCount * threadIndex / threadCount;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the region that contains the wanted index of a hash **/
+static uint32_t alfHashTableGetParallelRegion(
+	const AlfHashTableParallelTask* task,
+	uint64_t hash)
+{
+	const AlfHashTable* table = task->table;
+	uint64_t index;
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		const uint64_t groupCount = 
+			table->bucketCount / ALF_HASH_TABLE_GROUP_WIDTH;
+		index = ALF_MOD_POWER_OF_TWO(hash, groupCount) * 
+			ALF_HASH_TABLE_GROUP_WIDTH;
+	}
+	else
+	{
+		index = ALF_MOD_POWER_OF_TWO(hash, table->bucketCount);
+	}
+	return (uint32_t)(index >> task->regionShift);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Place a copy of a bucket in the region of its wanted index, that ends at the
+ * specified bucket index. Robin-hood buckets are shifted forward like in 
+ * alfHashTableClaimBucket, but never past the end of the region, and control
+ * byte buckets are only placed in the first group of their probe sequence. 
+ * Returns false if the bucket does not fit, in which case it must be inserted
+ * once all regions have been filled **/
+static AlfBool alfHashTablePlaceInRegion(
+	AlfHashTable* table,
+	const AlfHashTableBucket* entry,
+	uint64_t regionEnd)
+{
+	uint64_t index;
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		const uint64_t groupCount = 
+			table->bucketCount / ALF_HASH_TABLE_GROUP_WIDTH;
+		const uint64_t group = ALF_MOD_POWER_OF_TWO(entry->hash, groupCount);
+		const uint32_t free = alfHashTableGroupMatchFree(
+			table->control + group * ALF_HASH_TABLE_GROUP_WIDTH);
+		if (!free) { return ALF_FALSE; }
+		index = group * ALF_HASH_TABLE_GROUP_WIDTH + 
+			alfCountTrailingZeros32(free);
+		table->control[index] = alfHashTableControlTag(entry->hash);
+	}
+	else
+	{
+		// Find the insert index and the end of the cluster within the region
+		index = ALF_MOD_POWER_OF_TWO(entry->hash, table->bucketCount);
+		for (uint64_t distance = 0; index < regionEnd; index++, distance++)
+		{
+			const AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+				table->buckets, table->bucketSize, index);
+			if (bucket->hash == 0 || alfHashTableDistanceFromWantedIndex(
+				table->bucketCount, bucket->hash, index) < distance)
+			{
+				break;
+			}
+		}
+		uint64_t emptyIndex = index;
+		while (emptyIndex < regionEnd && alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, emptyIndex)->hash != 0)
+		{
+			emptyIndex++;
+		}
+		if (emptyIndex == regionEnd) { return ALF_FALSE; }
+
+		// Shift the cluster forward, it never wraps within a region
+		AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, index);
+		memmove((uint8_t*)bucket + table->bucketSize, bucket,
+			(uint64_t)(emptyIndex - index) * table->bucketSize);
+	}
+	memcpy(alfHashTableGetBucketAtIndex(table->buckets, table->bucketSize, 
+		index), entry, table->bucketSize);
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Create source buckets from the keys and values of the part of the sources
+ * that belongs to the thread of a task **/
+static void alfHashTableParallelStage(AlfHashTableParallelTask* task)
+{
+	AlfHashTable* table = task->table;
+	const uint64_t first = alfHashTableGetParallelSlice(
+		task->sourceCount, task->threadIndex, task->threadCount);
+	const uint64_t last = alfHashTableGetParallelSlice(
+		task->sourceCount, task->threadIndex + 1, task->threadCount);
+	for (uint64_t i = first; i < last; i++)
+	{
+		AlfHashTableBucket* bucket = 
+			alfHashTableGetBucketAtIndex(task->sources, table->bucketSize, i);
+		void* keyCopy = alfHashTableCopyKey(&task->arena, task->keys[i]);
+		if (!keyCopy)
+		{
+			bucket->hash = 0;
+			task->failed = ALF_TRUE;
+			continue;
+		}
+		alfHashTableSetBucket(table, bucket, keyCopy, 
+			alfHashTableGetKeyHash(table, task->keys[i]), task->values[i]);
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Clear the part of the buckets of the table that belongs to the thread of a
+ * task. Then count or order, depending on the step, the entries of each region
+ * in the part of the sources that belongs to the thread **/
+static void alfHashTableParallelCountOrScatter(AlfHashTableParallelTask* task)
+{
+	AlfHashTable* table = task->table;
+	uint64_t* offsets = 
+		task->offsets + (uint64_t)task->threadIndex * task->regionCount;
+	if (task->step == ALF_HASH_TABLE_PARALLEL_STEP_COUNT)
+	{
+		const uint64_t firstBucket = alfHashTableGetParallelSlice(
+			table->bucketCount, task->threadIndex, task->threadCount);
+		const uint64_t lastBucket = alfHashTableGetParallelSlice(
+			table->bucketCount, task->threadIndex + 1, task->threadCount);
+		alfHashTableClearBuckets(table, firstBucket, lastBucket - firstBucket);
+		memset(offsets, 0, sizeof(uint64_t) * task->regionCount);
+	}
+
+	const uint64_t first = alfHashTableGetParallelSlice(
+		task->sourceCount, task->threadIndex, task->threadCount);
+	const uint64_t last = alfHashTableGetParallelSlice(
+		task->sourceCount, task->threadIndex + 1, task->threadCount);
+	for (uint64_t i = first; i < last; i++)
+	{
+		AlfHashTableBucket* bucket = 
+			alfHashTableGetBucketAtIndex(task->sources, table->bucketSize, i);
+		if (bucket->hash == 0) { continue; }
+		const uint32_t region = alfHashTableGetParallelRegion(task, bucket->hash);
+		if (task->step == ALF_HASH_TABLE_PARALLEL_STEP_COUNT)
+		{
+			offsets[region]++;
+		}
+		else
+		{
+			task->order[offsets[region]++] = bucket;
+		}
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Place the entries of the regions that belong to the thread of a task. The
+ * entries that do not fit are moved to the start of the region in the entry
+ * order **/
+static void alfHashTableParallelPlace(AlfHashTableParallelTask* task)
+{
+	for (uint32_t region = task->threadIndex; region < task->regionCount; 
+		region += task->threadCount)
+	{
+		const uint64_t regionEnd = (uint64_t)(region + 1) << task->regionShift;
+		const uint64_t first = task->regionStart[region];
+		uint64_t overflowCount = 0;
+		for (uint64_t i = first; i < task->regionStart[region + 1]; i++)
+		{
+			if (!alfHashTablePlaceInRegion(
+				task->table, task->order[i], regionEnd))
+			{
+				task->order[first + overflowCount++] = task->order[i];
+			}
+		}
+		task->overflowCounts[region] = overflowCount;
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Thread function of a parallel hash table task **/
+static uint32_t alfHashTableParallelWork(void* argument)
+{
+	AlfHashTableParallelTask* task = argument;
+	switch (task->step)
+	{
+		case ALF_HASH_TABLE_PARALLEL_STEP_STAGE:
+			alfHashTableParallelStage(task);
+			break;
+		case ALF_HASH_TABLE_PARALLEL_STEP_COUNT:
+		case ALF_HASH_TABLE_PARALLEL_STEP_SCATTER:
+			alfHashTableParallelCountOrScatter(task);
+			break;
+		case ALF_HASH_TABLE_PARALLEL_STEP_PLACE:
+			alfHashTableParallelPlace(task);
+			break;
+	}
+	return 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Run a step of each task on its own thread. The first task is run on the 
+ * calling thread, as is any task whose thread could not be created **/
+static void alfHashTableRunParallel(
+	AlfHashTableParallelTask* tasks, 
+	AlfHashTableParallelStep step)
+{
+	AlfThread* threads[ALF_HASH_TABLE_PARALLEL_MAX_THREAD_COUNT];
+	for (uint32_t i = 0; i < tasks->threadCount; i++)
+	{
+		tasks[i].step = step;
+	}
+	for (uint32_t i = 1; i < tasks->threadCount; i++)
+	{
+		threads[i] = alfCreateThread(alfHashTableParallelWork, &tasks[i]);
+	}
+	alfHashTableParallelWork(&tasks[0]);
+	for (uint32_t i = 1; i < tasks->threadCount; i++)
+	{
+		if (threads[i]) { alfJoinThread(threads[i]); }
+		else { alfHashTableParallelWork(&tasks[i]); }
+	}
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy the tasks of a parallel hash table operation **/
+static void alfHashTableDestroyParallelTasks(AlfHashTableParallelTask* tasks)
+{
+	if (!tasks) { return; }
+	const AlfAllocator* allocator = &tasks->table->allocator;
+	alfAllocatorFree(allocator, tasks->overflowCounts, 
+		sizeof(uint64_t) * tasks->regionCount);
+	alfAllocatorFree(allocator, tasks->regionStart, 
+		sizeof(uint64_t) * (tasks->regionCount + 1));
+	alfAllocatorFree(allocator, tasks->order, 
+		sizeof(AlfHashTableBucket*) * (tasks->sourceCount + 1));
+	alfAllocatorFree(allocator, tasks->offsets, 
+		sizeof(uint64_t) * tasks->threadCount * tasks->regionCount);
+	alfAllocatorFree(allocator, tasks, 
+		sizeof(AlfHashTableParallelTask) * tasks->threadCount);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Create the tasks of a parallel operation that places the source buckets in
+ * a table with the specified bucket count. Returns NULL if the work is not 
+ * worth dividing or if memory could not be allocated **/
+static AlfHashTableParallelTask* alfHashTableCreateParallelTasks(
+	AlfHashTable* table,
+	uint64_t bucketCount,
+	uint8_t* sources,
+	uint64_t sourceCount,
+	uint32_t threadCount)
+{
+	// Divide buckets into at least one region per thread
+	if (!threadCount)
+	{
+		threadCount = alfGetHardwareThreadCount();
+	}
+	if (threadCount > ALF_HASH_TABLE_PARALLEL_MAX_THREAD_COUNT)
+	{
+		threadCount = ALF_HASH_TABLE_PARALLEL_MAX_THREAD_COUNT;
+	}
+	const uint32_t regionCount = 
+		alfHashTableGetParallelRegionCount(bucketCount, threadCount);
+	if (regionCount < 2) { return NULL; }
+	threadCount = regionCount < threadCount ? regionCount : threadCount;
+
+	// Allocate tasks and shared arrays. The counts of the first task are set 
+	// first so that the arrays can be freed if allocation fails
+	const AlfAllocator* allocator = &table->allocator;
+	AlfHashTableParallelTask* tasks = alfAllocatorAlloc(
+		allocator, sizeof(AlfHashTableParallelTask) * threadCount);
+	if (!tasks) { return NULL; }
+	tasks->table = table;
+	tasks->threadCount = threadCount;
+	tasks->sourceCount = sourceCount;
+	tasks->regionCount = regionCount;
+	tasks->offsets = alfAllocatorAlloc(
+		allocator, sizeof(uint64_t) * threadCount * regionCount);
+	tasks->order = alfAllocatorAlloc(
+		allocator, sizeof(AlfHashTableBucket*) * (sourceCount + 1));
+	tasks->regionStart = 
+		alfAllocatorAlloc(allocator, sizeof(uint64_t) * (regionCount + 1));
+	tasks->overflowCounts = 
+		alfAllocatorAlloc(allocator, sizeof(uint64_t) * regionCount);
+	if (!tasks->offsets || !tasks->order || !tasks->regionStart || 
+		!tasks->overflowCounts)
+	{
+		alfHashTableDestroyParallelTasks(tasks);
+		return NULL;
+	}
+
+	// Setup each task
+	uint32_t regionShift = 0;
+	while (((uint64_t)1 << regionShift) < bucketCount / regionCount)
+	{
+		regionShift++;
+	}
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		AlfHashTableParallelTask* task = &tasks[i];
+		task->table = table;
+		task->threadIndex = i;
+		task->threadCount = threadCount;
+		task->sources = sources;
+		task->sourceCount = sourceCount;
+		task->regionCount = regionCount;
+		task->regionShift = regionShift;
+		task->offsets = tasks->offsets;
+		task->order = tasks->order;
+		task->regionStart = tasks->regionStart;
+		task->overflowCounts = tasks->overflowCounts;
+		task->keys = NULL;
+		task->values = NULL;
+		task->arena = *table;
+		task->arena.arenaChunks = NULL;
+		task->arena.arenaUsedBytes = 0;
+		task->failed = ALF_FALSE;
+	}
+	return tasks;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Place the source buckets of parallel tasks in the buckets of the table, 
+ * which must be allocated but need not be cleared. Entries are first ordered 
+ * by region and each thread then fills its regions. The entries that did not 
+ * fit in their region are finally inserted on the calling thread **/
+static void alfHashTablePlaceParallel(AlfHashTableParallelTask* tasks)
+{
+	// Count entries of each region, and turn the counts into offsets
+	alfHashTableRunParallel(tasks, ALF_HASH_TABLE_PARALLEL_STEP_COUNT);
+	const uint32_t threadCount = tasks->threadCount;
+	const uint32_t regionCount = tasks->regionCount;
+	uint64_t offset = 0;
+	for (uint32_t region = 0; region < regionCount; region++)
+	{
+		tasks->regionStart[region] = offset;
+		for (uint32_t thread = 0; thread < threadCount; thread++)
+		{
+			uint64_t* count = 
+				&tasks->offsets[(uint64_t)thread * regionCount + region];
+			const uint64_t regionCountOfThread = *count;
+			*count = offset;
+			offset += regionCountOfThread;
+		}
+	}
+	tasks->regionStart[regionCount] = offset;
+
+	// Order entries and place them
+	alfHashTableRunParallel(tasks, ALF_HASH_TABLE_PARALLEL_STEP_SCATTER);
+	alfHashTableRunParallel(tasks, ALF_HASH_TABLE_PARALLEL_STEP_PLACE);
+	for (uint32_t region = 0; region < regionCount; region++)
+	{
+		for (uint64_t i = 0; i < tasks->overflowCounts[region]; i++)
+		{
+			alfHashTableInsertBucket(
+				tasks->table, tasks->order[tasks->regionStart[region] + i]);
+		}
+	}
+}
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// HashTable Parallel Functions
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+void alfHashTableResizeParallel(
+	AlfHashTable* table, 
+	uint64_t size, 
+	uint32_t threadCount)
+{
+	// Assert the preconditions
+	ALF_COLLECTION_ASSERT(
+		ALF_IS_POWER_OF_TWO(size),
+		"Hash table can only be resized to power of two sizes"
+	);
+	ALF_COLLECTION_ASSERT(!table->mapping, "Mapped hash tables are read-only");
+	if (table->mapping) { return; }
+
+	// Small tables are resized on the calling thread
+	alfHashTableMigrate(table, UINT64_MAX);
+	const uint64_t bucketCount = alfHashTableClampBucketCount(table, size);
+	AlfHashTableParallelTask* tasks = alfHashTableCreateParallelTasks(table, 
+		bucketCount, table->buckets, table->bucketCount, threadCount);
+	if (!tasks)
+	{
+		alfHashTableResize(table, size);
+		return;
+	}
+
+	// Place entries of the old buckets in the new buckets
+	ALF_HASH_TABLE_START_RESIZE_TIMER(startTime);
+	const uint64_t oldBucketCount = table->bucketCount;
+	uint8_t* oldBuckets = table->buckets;
+	uint8_t* oldControl = table->control;
+	if (!alfHashTableAllocateBuckets(table, bucketCount))
+	{
+		alfHashTableDestroyParallelTasks(tasks);
+		return;
+	}
+	alfHashTablePlaceParallel(tasks);
+
+	// Cleanup old
+	alfHashTableDestroyParallelTasks(tasks);
+	alfHashTableFreeBuckets(table, oldBuckets, oldControl, oldBucketCount);
+	ALF_HASH_TABLE_RECORD_RESIZE(table, startTime, 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfHashTable* alfHashTableBuildParallel(
+	const AlfHashTableDesc* desc,
+	const void* const* keys,
+	const void* const* values,
+	uint64_t count,
+	uint32_t threadCount)
+{
+	// Create table and find the bucket count that fits all entries
+	AlfHashTable* table = alfCreateHashTable(desc);
+	if (!table) { return NULL; }
+	uint64_t bucketCount = table->bucketCount;
+	while ((float)count >= (float)bucketCount * table->maxLoadFactor && 
+		bucketCount < (1ull << 63))
+	{
+		bucketCount <<= 1;
+	}
+
+	// Small tables, or tables that memory could not be allocated for, are built
+	// on the calling thread
+	const uint64_t sourcesSize = (uint64_t)table->bucketSize * count + 1;
+	uint8_t* sources = alfAllocatorAlloc(&table->allocator, sourcesSize);
+	AlfHashTableParallelTask* tasks = sources ? alfHashTableCreateParallelTasks(
+		table, bucketCount, sources, count, threadCount) : NULL;
+	if (!tasks)
+	{
+		alfAllocatorFree(&table->allocator, sources, sourcesSize);
+		alfHashTableResize(table, bucketCount);
+		for (uint64_t i = 0; i < count; i++)
+		{
+			alfHashTableInsert(table, keys[i], values[i]);
+		}
+		return table;
+	}
+
+	// Stage the entries, copying keys to task arenas
+	for (uint32_t i = 0; i < tasks->threadCount; i++)
+	{
+		tasks[i].keys = keys;
+		tasks[i].values = values;
+	}
+	alfHashTableRunParallel(tasks, ALF_HASH_TABLE_PARALLEL_STEP_STAGE);
+	AlfBool failed = ALF_FALSE;
+	for (uint32_t i = 0; i < tasks->threadCount; i++)
+	{
+		failed |= tasks[i].failed;
+	}
+
+	// Allocate the new buckets. On failure the staged entries are released
+	const uint64_t oldBucketCount = table->bucketCount;
+	uint8_t* oldBuckets = table->buckets;
+	uint8_t* oldControl = table->control;
+	if (failed || !alfHashTableAllocateBuckets(table, bucketCount))
+	{
+		for (uint64_t i = 0; i < count; i++)
+		{
+			AlfHashTableBucket* bucket = 
+				alfHashTableGetBucketAtIndex(sources, table->bucketSize, i);
+			if (bucket->hash != 0)
+			{
+				alfHashTableDestroyKey(table, bucket->key);
+			}
+		}
+		for (uint32_t i = 0; i < tasks->threadCount; i++)
+		{
+			alfHashTableArenaFree(&tasks[i].arena);
+		}
+		alfHashTableDestroyParallelTasks(tasks);
+		alfAllocatorFree(&table->allocator, sources, sourcesSize);
+		alfDestroyHashTable(table);
+		return NULL;
+	}
+
+	// Place the entries in the new buckets
+	alfHashTableFreeBuckets(table, oldBuckets, oldControl, oldBucketCount);
+	alfHashTablePlaceParallel(tasks);
+	table->size = count;
+
+	// Move the chunks of the task arenas to the table
+	AlfHashTableArenaChunk** chunkTail = &table->arenaChunks;
+	for (uint32_t i = 0; i < tasks->threadCount; i++)
+	{
+		*chunkTail = tasks[i].arena.arenaChunks;
+		while (*chunkTail)
+		{
+			chunkTail = &(*chunkTail)->next;
+		}
+		table->arenaUsedBytes += tasks[i].arena.arenaUsedBytes;
+	}
+
+	// Cleanup
+	alfHashTableDestroyParallelTasks(tasks);
+	alfAllocatorFree(&table->allocator, sources, sourcesSize);
+	return table;
+}
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// PartitionedHashTable Structures
+// ========================================================================== //
+
+/** Default number of partitions of a partitioned hash table **/
+#define ALF_PARTITIONED_HASH_TABLE_DEFAULT_PARTITION_COUNT 64
+
+// -------------------------------------------------------------------------- //
+
+/** Maximum number of partitions of a partitioned hash table **/
+#define ALF_PARTITIONED_HASH_TABLE_MAX_PARTITION_COUNT (1u << 16)
 
 // -------------------------------------------------------------------------- //
 
-void alfArrayListSort(
-	AlfArrayList* list, 
-	PFN_AlfCollectionCompare compareFunction)
+/** Partitioned hash table structure **/
+typedef struct tag_AlfPartitionedHashTable
 {
-	alfArrayListQuickSort(list, compareFunction, 0, (uint32_t)(list->size - 1));
-}
+	/** Number of partitions, always a power of two **/
+	uint32_t partitionCount;
+	/** Tables of the partitions **/
+	AlfHashTable** partitions;
+	/** Allocator of the table and the partition array **/
+	AlfAllocator allocator;
+} tag_AlfPartitionedHashTable;
 
 // ========================================================================== //
-// Stack Structures
+// PartitionedHashTable Private Functions
 // ========================================================================== //
 
-typedef struct tag_AlfStack
+/** Returns the table of the partition that a hash maps to. The hash is mixed
+ * with a multiplicative hash so that the partition depends on all bits of the
+ * hash, as hash functions with low entropy may leave the high bits unset **/
+static AlfHashTable* alfPartitionedHashTableGetHashPartition(
+	AlfPartitionedHashTable* table,
+	uint64_t hash)
 {
-	/** Capacity **/
-	uint32_t capacity;
-	/** Stack size**/
-	uint32_t size;
-	/** Data buffer **/
-	uint8_t* buffer;
+	const uint64_t mixed = hash * 0x9e3779b97f4a7c15ull;
+	return table->partitions[ALF_MOD_POWER_OF_TWO(
+		(uint32_t)(mixed >> 32), table->partitionCount)];
+}
 
-	/** Object size**/
-	uint32_t objectSize;
+// -------------------------------------------------------------------------- //
 
-	/** Object cleaner **/
-	PFN_AlfCollectionCleaner objectCleaner;
-} tag_AlfStack;
+/** Merge the partitions of a source table, starting at the specified index 
+ * and stepping by 'step', into the destination table **/
+static AlfBool alfPartitionedHashTableMergePartitions(
+	AlfPartitionedHashTable* destination,
+	AlfPartitionedHashTable* source,
+	PFN_AlfHashTableCombine combine,
+	uint32_t index,
+	uint32_t step)
+{
+	AlfBool success = ALF_TRUE;
+	for (; index < destination->partitionCount; index += step)
+	{
+		success &= alfHashTableMerge(destination->partitions[index], 
+			source->partitions[index], combine);
+	}
+	return success;
+}
+
+// -------------------------------------------------------------------------- //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Work of a single thread in a parallel merge **/
+typedef struct AlfPartitionedHashTableMergeTask
+{
+	/** Table to merge into **/
+	AlfPartitionedHashTable* destination;
+	/** Table to merge from **/
+	AlfPartitionedHashTable* source;
+	/** Combine function **/
+	PFN_AlfHashTableCombine combine;
+	/** Index of the thread of the task **/
+	uint32_t threadIndex;
+	/** Number of threads **/
+	uint32_t threadCount;
+	/** Whether all entries of the partitions of the task were merged **/
+	AlfBool success;
+} AlfPartitionedHashTableMergeTask;
+
+// -------------------------------------------------------------------------- //
+
+/** Thread function of a parallel merge task **/
+static uint32_t alfPartitionedHashTableMergeWork(void* argument)
+{
+	AlfPartitionedHashTableMergeTask* task = argument;
+	task->success = alfPartitionedHashTableMergePartitions(task->destination,
+		task->source, task->combine, task->threadIndex, task->threadCount);
+	return 0;
+}
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
 
 // ========================================================================== //
-// Stack Functions
+// PartitionedHashTable Functions
 // ========================================================================== //
 
-AlfStack* alfCreateStack(const AlfStackDesc* desc)
+AlfPartitionedHashTable* alfCreatePartitionedHashTable(
+	const AlfHashTableDesc* desc,
+	uint32_t partitionCount)
 {
+	// Assert the preconditions
+	if (!partitionCount)
+	{
+		partitionCount = ALF_PARTITIONED_HASH_TABLE_DEFAULT_PARTITION_COUNT;
+	}
 	ALF_COLLECTION_ASSERT(
-		desc->objectSize != 0,
-		"Size of objects in stack must be greater than zero"
+		ALF_IS_POWER_OF_TWO(partitionCount) && 
+		partitionCount <= ALF_PARTITIONED_HASH_TABLE_MAX_PARTITION_COUNT,
+		"Partition count of partitioned hash table must be a power of two"
 	);
 
-	AlfStack* stack = ALF_COLLECTION_ALLOC(sizeof(AlfStack));
-	if (!stack) { return NULL; }
-
-	stack->capacity = desc->capacity;
-	stack->size = 0;
-	stack->objectSize = desc->objectSize;
-	stack->objectCleaner = desc->objectCleaner;
-	stack->buffer = ALF_COLLECTION_ALLOC(stack->objectSize * stack->capacity);
-	if (!stack->buffer)
+	// Allocate table
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfPartitionedHashTable* table = 
+		alfAllocatorAlloc(&allocator, sizeof(AlfPartitionedHashTable));
+	if (!table) { return NULL; }
+	table->allocator = allocator;
+	table->partitionCount = partitionCount;
+	table->partitions = 
+		alfAllocatorAlloc(&allocator, sizeof(AlfHashTable*) * partitionCount);
+	if (!table->partitions)
 	{
-		ALF_COLLECTION_FREE(stack);
+		alfAllocatorFree(&allocator, table, sizeof(AlfPartitionedHashTable));
 		return NULL;
 	}
 
-	return stack;
+	// Setup partitions, the initial buckets are divided between them
+	AlfHashTableDesc partitionDesc = *desc;
+	partitionDesc.bucketCount = desc->bucketCount > partitionCount ? 
+		desc->bucketCount / partitionCount : 1;
+	for (uint32_t i = 0; i < partitionCount; i++)
+	{
+		table->partitions[i] = alfCreateHashTable(&partitionDesc);
+		if (!table->partitions[i])
+		{
+			// Destroy the partitions that were created
+			while (i-- > 0)
+			{
+				alfDestroyHashTable(table->partitions[i]);
+			}
+			alfAllocatorFree(&allocator, table->partitions, 
+				sizeof(AlfHashTable*) * partitionCount);
+			alfAllocatorFree(&allocator, table, sizeof(AlfPartitionedHashTable));
+			return NULL;
+		}
+	}
+
+	return table;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfDestroyStack(AlfStack* stack)
+void alfDestroyPartitionedHashTable(AlfPartitionedHashTable* table)
 {
-	for (uint32_t i = 0; i < stack->size; i++)
+	for (uint32_t i = 0; i < table->partitionCount; i++)
 	{
-		void* object = stack->buffer + (stack->objectSize * i);
-		stack->objectCleaner(object);
+		alfDestroyHashTable(table->partitions[i]);
 	}
-	ALF_COLLECTION_FREE(stack->buffer);
-	ALF_COLLECTION_FREE(stack);
+	const AlfAllocator allocator = table->allocator;
+	alfAllocatorFree(&allocator, table->partitions, 
+		sizeof(AlfHashTable*) * table->partitionCount);
+	alfAllocatorFree(&allocator, table, sizeof(AlfPartitionedHashTable));
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfBool alfStackPush(AlfStack* stack, const void* object)
+AlfBool alfPartitionedHashTableInsert(
+	AlfPartitionedHashTable* table,
+	const void* key,
+	const void* value)
 {
-	if (stack->capacity <= stack->size)
-	{
-		const AlfBool success = alfStackResize(stack, stack->size * 2);
-		if (!success) { return ALF_FALSE; }
-	}
-	memcpy(
-		stack->buffer + (stack->objectSize * stack->size++), 
-		object, 
-		stack->objectSize
-	);
-	return ALF_TRUE;
+	const uint64_t hash = alfHashTableGetKeyHash(table->partitions[0], key);
+	return alfHashTableInsertHashed(
+		alfPartitionedHashTableGetHashPartition(table, hash), key, hash, value);
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfBool alfStackPop(AlfStack* stack, void* objectOut)
+void* alfPartitionedHashTableGet(
+	AlfPartitionedHashTable* table, 
+	const void* key)
 {
-	if (stack->size < 1) { return ALF_FALSE; }
-	memcpy(
-		objectOut,
-		stack->buffer + (stack->objectSize * --stack->size),
-		stack->objectSize
-	);
-	return ALF_TRUE;
+	const uint64_t hash = alfHashTableGetKeyHash(table->partitions[0], key);
+	return alfHashTableGetHashed(
+		alfPartitionedHashTableGetHashPartition(table, hash), key, hash);
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfBool alfStackResize(AlfStack* stack, uint32_t size)
+void* alfPartitionedHashTableFindOrInsert(
+	AlfPartitionedHashTable* table,
+	const void* key,
+	AlfBool* insertedOut)
+{
+	const uint64_t hash = alfHashTableGetKeyHash(table->partitions[0], key);
+	return alfHashTableFindOrInsertHashed(
+		alfPartitionedHashTableGetHashPartition(table, hash), key, hash, 
+		insertedOut);
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfPartitionedHashTableRemove(
+	AlfPartitionedHashTable* table,
+	const void* key,
+	void* valueOut)
 {
-	// Allocate block and copy data
-	uint8_t* buffer = ALF_COLLECTION_ALLOC(size * stack->objectSize);
-	if (!buffer) { return ALF_FALSE; }
-	const uint32_t sizeAfter = ALF_COLLECTION_MIN(size, stack->size);
-	memcpy(buffer, stack->buffer, sizeAfter * stack->objectSize);
+	const uint64_t hash = alfHashTableGetKeyHash(table->partitions[0], key);
+	return alfHashTableRemoveHashed(
+		alfPartitionedHashTableGetHashPartition(table, hash), key, hash, 
+		valueOut);
+}
+
+// -------------------------------------------------------------------------- //
 
-	// Clean object that are after end of old buffer
-	const int32_t freeCount = stack->size - sizeAfter;
-	for (int32_t i = 0; i < freeCount; i++)
+uint64_t alfPartitionedHashTableGetSize(AlfPartitionedHashTable* table)
+{
+	uint64_t size = 0;
+	for (uint32_t i = 0; i < table->partitionCount; i++)
 	{
-		void* object = stack->buffer + (stack->objectSize * (sizeAfter + i));
-		stack->objectCleaner(object);
+		size += alfHashTableGetSize(table->partitions[i]);
 	}
+	return size;
+}
 
-	stack->size = sizeAfter;
-	return ALF_TRUE;
+// -------------------------------------------------------------------------- //
+
+uint32_t alfPartitionedHashTableGetPartitionCount(
+	AlfPartitionedHashTable* table)
+{
+	return table->partitionCount;
 }
 
 // -------------------------------------------------------------------------- //
 
-uint32_t alfStackGetSize(AlfStack* stack)
+AlfHashTable* alfPartitionedHashTableGetPartition(
+	AlfPartitionedHashTable* table,
+	uint32_t index)
 {
-	return stack->size;
+	ALF_COLLECTION_ASSERT(
+		index < table->partitionCount, 
+		"Partition index out of bounds"
+	);
+	return table->partitions[index];
 }
 
-// ========================================================================== //
-// HashTable Structures
-// ========================================================================== //
+// -------------------------------------------------------------------------- //
 
-/** A single hash table bucket **/
-typedef struct AlfHashTableBucket
+AlfBool alfPartitionedHashTableMerge(
+	AlfPartitionedHashTable* destination,
+	AlfPartitionedHashTable* source,
+	PFN_AlfHashTableCombine combine)
 {
-	/** Cached hash value **/
-	uint32_t hash;
-	/** Key **/
-	void* key;
-	/** value data **/
-	uint8_t value[];
-} AlfHashTableBucket;
+	ALF_COLLECTION_ASSERT(
+		destination->partitionCount == source->partitionCount,
+		"Merged partitioned hash tables must have the same partition count"
+	);
+	return alfPartitionedHashTableMergePartitions(
+		destination, source, combine, 0, 1);
+}
 
 // -------------------------------------------------------------------------- //
 
-/** Hash table structure **/
-typedef struct tag_AlfHashTable
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+AlfBool alfPartitionedHashTableMergeParallel(
+	AlfPartitionedHashTable* destination,
+	AlfPartitionedHashTable* source,
+	PFN_AlfHashTableCombine combine,
+	uint32_t threadCount)
 {
-	/** Bucket count **/
-	uint32_t bucketCount;
-	/** Current entry count**/
-	uint32_t size;
-	/** buckets **/
-	uint8_t* buckets;
-	/** Size of a bucket in bytes **/
-	uint32_t bucketSize;
-	/** Maximum load factor **/
-	float maxLoadFactor;
+	// Assert the preconditions
+	ALF_COLLECTION_ASSERT(
+		destination->partitionCount == source->partitionCount,
+		"Merged partitioned hash tables must have the same partition count"
+	);
 
-	/** Size of value object in bytes **/
-	uint32_t valueSize;
+	// Determine thread count, no thread is given less than one partition
+	if (!threadCount)
+	{
+		threadCount = alfGetHardwareThreadCount();
+	}
+	if (threadCount > destination->partitionCount)
+	{
+		threadCount = destination->partitionCount;
+	}
+	const AlfAllocator* allocator = &destination->allocator;
+	const uint64_t tasksSize = 
+		sizeof(AlfPartitionedHashTableMergeTask) * threadCount;
+	AlfPartitionedHashTableMergeTask* tasks = threadCount > 1 ? 
+		alfAllocatorAlloc(allocator, tasksSize) : NULL;
+	AlfThread** threads = tasks ? 
+		alfAllocatorAlloc(allocator, sizeof(AlfThread*) * threadCount) : NULL;
+	if (!threads)
+	{
+		alfAllocatorFree(allocator, tasks, tasksSize);
+		return alfPartitionedHashTableMerge(destination, source, combine);
+	}
 
-	/** Whether automatic shrinking is enabled **/
-	AlfBool automaticShrink;
+	// Merge partitions on each thread. The first task is run on the calling
+	// thread, as is any task whose thread could not be created
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		tasks[i].destination = destination;
+		tasks[i].source = source;
+		tasks[i].combine = combine;
+		tasks[i].threadIndex = i;
+		tasks[i].threadCount = threadCount;
+		threads[i] = i == 0 ? NULL : 
+			alfCreateThread(alfPartitionedHashTableMergeWork, &tasks[i]);
+	}
+	alfPartitionedHashTableMergeWork(&tasks[0]);
+	AlfBool success = tasks[0].success;
+	for (uint32_t i = 1; i < threadCount; i++)
+	{
+		if (threads[i]) { alfJoinThread(threads[i]); }
+		else { alfPartitionedHashTableMergeWork(&tasks[i]); }
+		success &= tasks[i].success;
+	}
 
-	/** Hash function  **/
-	PFN_AlfCollectionHash hashFunction;
-	/** Key equality function **/
-	PFN_AlfCollectionEqual keyEqual;
-	/** Key copy function **/
-	PFN_AlfCollectionCopy keyCopy;
-	/** Key destructor **/
-	PFN_AlfCollectionDestructor keyDestructor;
-	/** Value cleaner **/
-	PFN_AlfCollectionCleaner valueCleaner;
-} tag_AlfHashTable;
+	// Cleanup
+	alfAllocatorFree(allocator, threads, sizeof(AlfThread*) * threadCount);
+	alfAllocatorFree(allocator, tasks, tasksSize);
+	return success;
+}
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
 
 // ========================================================================== //
-// HashTable Macro Declarations
+// BoundedCache Structures
 // ========================================================================== //
 
-/** Default hash-table bucket count **/
-#define ALF_DEFAULT_HASH_TABLE_BUCKET_COUNT (1 << 5)
+/** Entry metadata that is stored in front of each value in the buckets of the
+ * table of a bounded cache. Its size keeps the value aligned **/
+typedef struct AlfBoundedCacheEntry
+{
+	/** Whether the entry has been used since the clock hand last passed it **/
+	uint32_t referenced;
+	/** Weight of the entry **/
+	uint32_t weight;
+} AlfBoundedCacheEntry;
 
 // -------------------------------------------------------------------------- //
 
-/** Default load factor to trigger resize of hash-table **/
-#define ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_RESIZE 0.8f
+/** Bounded cache structure **/
+typedef struct tag_AlfBoundedCache
+{
+	/** Table with the entries. Each value starts with the entry metadata **/
+	AlfHashTable* table;
+	/** Maximum sum of the weights of the entries **/
+	uint64_t capacity;
+	/** Sum of the weights of the entries **/
+	uint64_t weight;
+	/** Bucket index of the clock hand **/
+	uint64_t hand;
+	/** Cleaner of the values that are evicted **/
+	PFN_AlfCollectionCleaner valueCleaner;
+	/** Counters **/
+	AlfBoundedCacheStatistics statistics;
+} tag_AlfBoundedCache;
 
-// -------------------------------------------------------------------------- //
+// ========================================================================== //
+// BoundedCache Private Functions
+// ========================================================================== //
 
-/** Macro to check if power of two **/
-#define ALF_IS_POWER_OF_TWO(num) (num && !(num & (num - 1)))
+/** Erase the bucket at an index of the current buckets of a table. Robin-hood
+ * buckets after it are shifted back, so the index then holds the next entry
+ * of the cluster, if any **/
+static void alfHashTableEraseAtIndex(AlfHashTable* table, uint64_t index)
+{
+	AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+		table->buckets, table->bucketSize, index);
+	const uint64_t hash = bucket->hash;
+	alfHashTableDestroyKey(table, bucket->key);
+	if (table->layout == ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES)
+	{
+		alfHashTableControlErase(table, index);
+	}
+	else
+	{
+		alfHashTableEraseBackwardShift(
+			table, table->buckets, table->bucketCount, index);
+	}
+	table->size--;
+	alfHashTableFilterRemove(table, hash);
+	if (table->keyStorage == ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)
+	{
+		alfHashTableArenaCompact(table);
+	}
+}
 
 // -------------------------------------------------------------------------- //
 
-/** Macro to perform modulo calculation where y is a power of two **/
-#define ALF_MOD_POWER_OF_TWO(x, y) ((x) & ((y) - 1))
+/** Evict a single entry from a bounded cache. The clock hand sweeps the bucket
+ * array and clears the reference bit of each entry that it passes, until it 
+ * finds an entry that has not been used since it was last passed. The cache 
+ * must not be empty.
+ * 
+ * The hand steps by a large odd stride, which visits every bucket once per lap
+ * of a power of two bucket array. Sweeping buckets in order would leave the 
+ * buckets just ahead of the hand the fullest, since they have gone longest 
+ * without eviction, and make robin-hood clusters there very long **/
+static void alfBoundedCacheEvict(AlfBoundedCache* cache)
+{
+	AlfHashTable* table = cache->table;
+	const uint64_t stride = ((table->bucketCount >> 32) * 0x9e3779b9ull + 
+		(((table->bucketCount & UINT32_MAX) * 0x9e3779b9ull) >> 32)) | 1;
+	while (ALF_TRUE)
+	{
+		cache->hand = ALF_MOD_POWER_OF_TWO(
+			cache->hand + stride, table->bucketCount);
+		AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
+			table->buckets, table->bucketSize, cache->hand);
+		if (bucket->hash == 0) { continue; }
+		AlfBoundedCacheEntry* entry = 
+			alfHashTableGetBucketValue(table, bucket);
+		if (entry->referenced)
+		{
+			entry->referenced = 0;
+			continue;
+		}
+		cache->valueCleaner(entry + 1);
+		cache->weight -= entry->weight;
+		cache->statistics.evictionCount++;
+		alfHashTableEraseAtIndex(table, cache->hand);
+		return;
+	}
+}
 
 // ========================================================================== //
-// HashTable Private String Functions
+// BoundedCache Functions
 // ========================================================================== //
 
-/** String copy **/
-void* alfStringCopyFunction(const void* object)
+AlfBoundedCache* alfCreateBoundedCache(
+	const AlfHashTableDesc* desc, 
+	uint64_t capacity)
 {
-	const char* str = (const void*)object;
-	const uint64_t size = strlen(str);
-	char* buffer = ALF_COLLECTION_ALLOC(size + 1);
-	buffer[size] = 0;
-	memcpy(buffer, str, size);
-	return buffer;
+	// Allocate cache
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfBoundedCache* cache = 
+		alfAllocatorAlloc(&allocator, sizeof(AlfBoundedCache));
+	if (!cache) { return NULL; }
+
+	// Values are stored after the entry metadata, and cleaned by the cache
+	AlfHashTableDesc tableDesc = *desc;
+	tableDesc.valueSize = desc->valueSize + sizeof(AlfBoundedCacheEntry);
+	tableDesc.valueCleaner = NULL;
+	cache->table = alfCreateHashTable(&tableDesc);
+	if (!cache->table)
+	{
+		alfAllocatorFree(&allocator, cache, sizeof(AlfBoundedCache));
+		return NULL;
+	}
+	cache->capacity = capacity;
+	cache->weight = 0;
+	cache->hand = 0;
+	cache->valueCleaner = 
+		desc->valueCleaner ? desc->valueCleaner : alfDefaultCleaner;
+	memset(&cache->statistics, 0, sizeof(AlfBoundedCacheStatistics));
+	return cache;
 }
 
 // -------------------------------------------------------------------------- //
 
-/** String destructor **/
-void alfStringDestructorFunction(void* object)
+void alfDestroyBoundedCache(AlfBoundedCache* cache)
 {
-	char* str = (char*)object;
-	ALF_COLLECTION_FREE(str);
+	AlfHashTable* table = cache->table;
+	const AlfAllocator allocator = table->allocator;
+	for (uint64_t i = 0; i < table->bucketCount; i++)
+	{
+		AlfHashTableBucket* bucket = 
+			alfHashTableGetBucketAtIndex(table->buckets, table->bucketSize, i);
+		if (bucket->hash != 0)
+		{
+			AlfBoundedCacheEntry* entry = 
+				alfHashTableGetBucketValue(table, bucket);
+			cache->valueCleaner(entry + 1);
+		}
+	}
+	alfDestroyHashTable(table);
+	alfAllocatorFree(&allocator, cache, sizeof(AlfBoundedCache));
 }
 
 // -------------------------------------------------------------------------- //
 
-/** String comparison **/
-AlfBool alfStringEqualFunction(const void* object0, const void* object1)
+AlfBool alfBoundedCacheInsert(
+	AlfBoundedCache* cache,
+	const void* key,
+	const void* value)
 {
-	const char* str0 = (const char*)object0;
-	const char* str1 = (const char*)object1;
-	return strcmp(str0, str1) == 0;
+	return alfBoundedCacheInsertWeighted(cache, key, value, 1);
 }
 
 // -------------------------------------------------------------------------- //
 
-/** FNV-32 hash for strings **/
-uint32_t alfStringHashFunction(const void* object)
+AlfBool alfBoundedCacheInsertWeighted(
+	AlfBoundedCache* cache,
+	const void* key,
+	const void* value,
+	uint32_t weight)
 {
-	const char* str = (const char*)object;
-	uint32_t index = 0;
-	uint32_t hash = 0x811c9dc5ul;
-	while (str[index])
+	AlfHashTable* table = cache->table;
+	if (weight > cache->capacity) { return ALF_FALSE; }
+
+	// Any value of the key is replaced. Then evict until the entry fits
+	const uint64_t hash = alfHashTableGetKeyHash(table, key);
+	AlfBoundedCacheEntry* entry = alfHashTableGetHashed(table, key, hash);
+	if (entry)
+	{
+		cache->valueCleaner(entry + 1);
+		cache->weight -= entry->weight;
+		alfHashTableRemoveHashed(table, key, hash, NULL);
+	}
+	while (cache->weight + weight > cache->capacity)
+	{
+		alfBoundedCacheEvict(cache);
+	}
+
+	// Insert entry, the table only grows if the bucket count was too small
+	AlfBool inserted;
+	entry = alfHashTableFindOrInsertHashed(table, key, hash, &inserted);
+	if (!entry) { return ALF_FALSE; }
+	entry->referenced = 1;
+	entry->weight = weight;
+	memcpy(entry + 1, value, table->valueSize - sizeof(AlfBoundedCacheEntry));
+	cache->weight += weight;
+	cache->statistics.insertCount++;
+	return ALF_TRUE;
+}
+
+// -------------------------------------------------------------------------- //
+
+void* alfBoundedCacheGet(AlfBoundedCache* cache, const void* key)
+{
+	AlfHashTable* table = cache->table;
+	AlfBoundedCacheEntry* entry = alfHashTableGetHashed(
+		table, key, alfHashTableGetKeyHash(table, key));
+	if (!entry)
 	{
-		hash = hash * 16777619ul;
-		hash = hash ^ str[index++];
+		cache->statistics.missCount++;
+		return NULL;
 	}
-	return hash;
+	cache->statistics.hitCount++;
+	entry->referenced = 1;
+	return entry + 1;
 }
 
-// ========================================================================== //
-// HashTable Private Functions
-// ========================================================================== //
+// -------------------------------------------------------------------------- //
 
-/** Returns pointer to bucket at specified index in bucket array **/
-static AlfHashTableBucket* alfHashTableGetBucketAtIndex(
-	uint8_t* buckets,
-	uint32_t bucketSize,
-	uint32_t index)
+AlfBool alfBoundedCacheRemove(
+	AlfBoundedCache* cache,
+	const void* key,
+	void* valueOut)
 {
-	return (AlfHashTableBucket*)(buckets + (index * bucketSize));
+	AlfHashTable* table = cache->table;
+	const uint64_t hash = alfHashTableGetKeyHash(table, key);
+	AlfBoundedCacheEntry* entry = alfHashTableGetHashed(table, key, hash);
+	if (!entry) { return ALF_FALSE; }
+	if (valueOut)
+	{
+		memcpy(valueOut, entry + 1, 
+			table->valueSize - sizeof(AlfBoundedCacheEntry));
+	}
+	cache->weight -= entry->weight;
+	return alfHashTableRemoveHashed(table, key, hash, NULL);
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Creates a hash that is valid for the hash table from the hash function that
- * the user specified at hash table creation. This function makes sure that the
- * MSB are always clear (Signifies tombstones) and that 0 is never returned as a
- * valid hash (Signifies empty bucket). **/
-static uint32_t alfHashTableGetKeyHash(AlfHashTable* table, const void* key)
-{
-	// Clear MSB and make sure hash is never 0 (Signifies empty bucket)
-	uint32_t hash = table->hashFunction(key);
-	hash &= 0x7FFFFFFF;
-	return hash ? hash : 1;
+uint64_t alfBoundedCacheGetSize(AlfBoundedCache* cache)
+{
+	return cache->table->size;
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Returns whether or not a hash value represents a tombstone **/
-static AlfBool alfHashTableIsTombstone(uint32_t hash)
+void alfBoundedCacheGetStatistics(
+	AlfBoundedCache* cache, 
+	AlfBoundedCacheStatistics* statisticsOut)
 {
-	return (hash & 0x80000000) != 0;
+	*statisticsOut = cache->statistics;
+	statisticsOut->size = cache->table->size;
+	statisticsOut->weight = cache->weight;
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Returns the tombstone value from a hash value **/
-static uint32_t alfHashTableMarkTombstone(uint32_t hash)
+void alfBoundedCacheResetStatistics(AlfBoundedCache* cache)
 {
-	return hash |= 0x80000000;
+	memset(&cache->statistics, 0, sizeof(AlfBoundedCacheStatistics));
 }
 
+// ========================================================================== //
+// OrderedHashTable Structures
+// ========================================================================== //
+
+/** Minimum entry capacity of an ordered hash table **/
+#define ALF_ORDERED_HASH_TABLE_MIN_CAPACITY 8
+
 // -------------------------------------------------------------------------- //
 
-/** Sets the value of a bucket by copying all bytes **/
-static void alfHashTableSetBucketValue(
-	AlfHashTable* table,
-	AlfHashTableBucket* bucket,
-	const void* value)
+/** Ordered hash table structure **/
+typedef struct tag_AlfOrderedHashTable
+{
+	/** Settings and key storage. The table itself has no buckets **/
+	AlfHashTable table;
+	/** Entries in insertion order, with the same layout as the buckets of a
+	 * hash table. Removed entries keep their place, with a hash of 0, until
+	 * the entries are compacted **/
+	uint8_t* entries;
+	/** Number of entries, including removed entries **/
+	uint32_t entryCount;
+	/** Capacity of the entry array **/
+	uint32_t entryCapacity;
+	/** Index of each entry plus one, at the position of its hash. Zero marks 
+	 * an empty index. Always at least twice the entry capacity **/
+	uint32_t* indices;
+	/** Number of indices, always a power of two **/
+	uint32_t indexCount;
+} tag_AlfOrderedHashTable;
+
+// ========================================================================== //
+// OrderedHashTable Private Functions
+// ========================================================================== //
+
+/** Returns pointer to the entry at an index **/
+static AlfHashTableBucket* alfOrderedHashTableGetEntry(
+	AlfOrderedHashTable* table,
+	uint32_t index)
 {
-	memcpy(
-		bucket->value, 
-		value, 
-		table->valueSize
-	);
+	return alfHashTableGetBucketAtIndex(
+		table->entries, table->table.bucketSize, index);
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Setup buckets to match the bucket count. Bucket hashes are cleared to 0 **/
-static void alfHashTableSetupBuckets(AlfHashTable* table, uint32_t bucketCount)
+/** Returns the position in the index array of the key with the specified hash,
+ * or of the empty index where it would be placed. The indices are probed 
+ * linearly, and only entries with a matching hash are compared **/
+static uint32_t alfOrderedHashTableProbe(
+	AlfOrderedHashTable* table,
+	const void* key,
+	uint64_t hash)
 {
-	// Allocate buckets
-	table->bucketCount = bucketCount;
-	table->buckets = ALF_COLLECTION_ALLOC(
-		table->bucketSize * table->bucketCount);
-
-	// Clear buckets
-	for (uint32_t i = 0; i < table->bucketCount; i++)
+	uint32_t position = (uint32_t)ALF_MOD_POWER_OF_TWO(hash, table->indexCount);
+	while (table->indices[position])
 	{
-		AlfHashTableBucket* bucket = alfHashTableGetBucketAtIndex(
-			table->buckets, table->bucketSize, i);
-		bucket->hash = 0;
+		AlfHashTableBucket* entry = 
+			alfOrderedHashTableGetEntry(table, table->indices[position] - 1);
+		if (entry->hash == hash && 
+			alfHashTableKeyEqual(&table->table, key, entry))
+		{
+			return position;
+		}
+		position = ALF_MOD_POWER_OF_TWO(position + 1, table->indexCount);
 	}
+	return position;
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Returns the distance from the current index to the index that the hash 
- * value corresponds to. This is used to determine the probing distance **/
-static uint32_t alfHashTableDistanceFromWantedIndex(
-	AlfHashTable* table,
-	uint32_t hash,
-	uint32_t currentIndex)
+/** Remove the index at a position. The indices after it are shifted back, so
+ * that no probe sequence is broken and no tombstones are needed **/
+static void alfOrderedHashTableEraseIndex(
+	AlfOrderedHashTable* table,
+	uint32_t position)
 {
-	const uint32_t otherIndex = ALF_MOD_POWER_OF_TWO(hash, table->bucketCount);
-	return ALF_MOD_POWER_OF_TWO(
-		currentIndex + table->bucketCount - otherIndex, 
-		table->bucketCount
-	);
+	uint32_t next = position;
+	while (ALF_TRUE)
+	{
+		next = ALF_MOD_POWER_OF_TWO(next + 1, table->indexCount);
+		if (!table->indices[next]) { break; }
+
+		// Move the index back unless its wanted position lies cyclically in
+		// (position, next], in which case the hole does not break its probe
+		const uint32_t wanted = (uint32_t)ALF_MOD_POWER_OF_TWO(
+			alfOrderedHashTableGetEntry(table, table->indices[next] - 1)->hash,
+			table->indexCount);
+		if (ALF_MOD_POWER_OF_TWO(next - wanted, table->indexCount) >=
+			ALF_MOD_POWER_OF_TWO(next - position, table->indexCount))
+		{
+			table->indices[position] = table->indices[next];
+			position = next;
+		}
+	}
+	table->indices[position] = 0;
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Insert a key-value pair into a hash table. This is part of the private 
- * implementation and does not check load factor. alfHashTableInsert should be
- * used instead (It uses this function). **/
-static AlfBool alfHashTableInsertKeyValue(
-	AlfHashTable* table,
-	void* key,
-	const void* inValue)
+/** Reallocate the entries and indices of a table for the specified capacity.
+ * Removed entries are dropped, while the order of the remaining entries is 
+ * kept, and the indices are rebuilt. Entries without removed entries are not
+ * moved, so they are resized with the reallocation function of the allocator
+ * **/
+static AlfBool alfOrderedHashTableRebuild(
+	AlfOrderedHashTable* table,
+	uint32_t capacity)
 {
-	// Create local versions of key and value
-	void* value = alloca(table->valueSize);
-	memcpy(value, inValue, table->valueSize);
-
-	// Find index to place bucket data at
-	uint32_t hash = alfHashTableGetKeyHash(table, key);
-	uint32_t index = ALF_MOD_POWER_OF_TWO(hash, table->bucketCount);
-	int32_t distance = 0;
-	while (ALF_TRUE)
+	// Allocate arrays
+	const AlfAllocator* allocator = &table->table.allocator;
+	const uint32_t bucketSize = table->table.bucketSize;
+	const AlfBool inPlace = table->table.size == table->entryCount && 
+		capacity >= table->entryCount;
+	uint32_t indexCount = 1;
+	while (indexCount < capacity * 2) { indexCount <<= 1; }
+	uint32_t* indices = 
+		alfAllocatorAlloc(allocator, sizeof(uint32_t) * indexCount);
+	if (!indices) { return ALF_FALSE; }
+	uint8_t* entries = inPlace ? 
+		alfAllocatorRealloc(allocator, table->entries, 
+			(uint64_t)bucketSize * table->entryCapacity, 
+			(uint64_t)bucketSize * capacity) :
+		alfAllocatorAlloc(allocator, (uint64_t)bucketSize * capacity);
+	if (!entries)
 	{
-		// Retrieve bucket
-		AlfHashTableBucket* otherBucket = alfHashTableGetBucketAtIndex(
-			table->buckets, table->bucketSize, index);
+		alfAllocatorFree(allocator, indices, sizeof(uint32_t) * indexCount);
+		return ALF_FALSE;
+	}
+	memset(indices, 0, sizeof(uint32_t) * indexCount);
 
-		// If slot is empty then insert
-		if (otherBucket->hash == 0)
+	// Move the remaining entries and index them
+	uint8_t* source = inPlace ? entries : table->entries;
+	uint32_t entryCount = 0;
+	for (uint32_t i = 0; i < table->entryCount; i++)
+	{
+		AlfHashTableBucket* entry = 
+			alfHashTableGetBucketAtIndex(source, bucketSize, i);
+		if (entry->hash == 0) { continue; }
+		if (!inPlace)
 		{
-			otherBucket->hash = hash;
-			otherBucket->key = key;
-			alfHashTableSetBucketValue(table, otherBucket, value);
-			return ALF_TRUE;
+			memcpy(alfHashTableGetBucketAtIndex(entries, bucketSize, 
+				entryCount), entry, bucketSize);
 		}
-
-		// If element has probed less then insert
-		const int32_t slotDistance = alfHashTableDistanceFromWantedIndex(
-			table, otherBucket->hash, index);
-		if (slotDistance < distance)
+		uint32_t position = 
+			(uint32_t)ALF_MOD_POWER_OF_TWO(entry->hash, indexCount);
+		while (indices[position])
 		{
-			// If tombstone then replace
-			if (alfHashTableIsTombstone(otherBucket->hash))
-			{
-				otherBucket->hash = hash;
-				otherBucket->key = key;
-				alfHashTableSetBucketValue(table, otherBucket, value);
-				return ALF_TRUE;
-			}
-
-			// Store bucket entries temporarily
-			const uint32_t _hash = otherBucket->hash;
-			void* _key = otherBucket->key;
-			void* _value = alloca(table->valueSize);
-			memcpy(_value, otherBucket->value, table->valueSize);
-
-			// Insert values into bucket
-			otherBucket->hash = hash;
-			otherBucket->key = key;
-			alfHashTableSetBucketValue(table, otherBucket, value);
-
-			// Retrieve value from temp
-			hash = _hash;
-			key = _key;
-			memcpy(value, _value, table->valueSize);
-
-			// Update distance
-			distance = slotDistance;
+			position = ALF_MOD_POWER_OF_TWO(position + 1, indexCount);
 		}
+		indices[position] = ++entryCount;
+	}
 
-		// Go to next index and increase probing distance
-		index = ALF_MOD_POWER_OF_TWO(index + 1, table->bucketCount);
-		distance++;
+	// Replace arrays
+	alfAllocatorFree(
+		allocator, table->indices, sizeof(uint32_t) * table->indexCount);
+	if (!inPlace)
+	{
+		alfAllocatorFree(allocator, table->entries, 
+			(uint64_t)bucketSize * table->entryCapacity);
 	}
+	table->entries = entries;
+	table->entryCount = entryCount;
+	table->entryCapacity = capacity;
+	table->indices = indices;
+	table->indexCount = indexCount;
+	return ALF_TRUE;
 }
 
 // -------------------------------------------------------------------------- //
 
-/** Returns object corresponding to key or NULL if key was not found. If the
- * key was found then the 'indexOut' paramter is also set to the index **/
-void* alfHashTableFindIndex(
-	AlfHashTable* table, 
-	const void* key, 
-	uint32_t* indexOut)
+/** Make room for one more entry at the end of the entry array. The entries 
+ * are compacted in place of growing when enough of them have been removed **/
+static AlfBool alfOrderedHashTableReserve(AlfOrderedHashTable* table)
 {
-	const uint32_t hash = alfHashTableGetKeyHash(table, key);
-	uint32_t index = ALF_MOD_POWER_OF_TWO(hash, table->bucketCount);
-	int32_t distance = 0;
-	while (ALF_TRUE)
-	{
-		// Retrieve bucket
-		AlfHashTableBucket* otherBucket = alfHashTableGetBucketAtIndex(
-			table->buckets, table->bucketSize, index);
+	if (table->entryCount < table->entryCapacity) { return ALF_TRUE; }
+	const uint32_t size = (uint32_t)table->table.size;
+	const uint32_t capacity = size < table->entryCapacity / 2 ? 
+		table->entryCapacity : table->entryCapacity * 2;
+	return alfOrderedHashTableRebuild(table, capacity);
+}
 
-		// Return NULL if bucket is empty
-		if (otherBucket->hash == 0)
-		{
-			return NULL;
-		}
+// -------------------------------------------------------------------------- //
 
-		// Value cannot be further away than what the object at the current
-		// position is, therefore return NULL immediately.
-		const int32_t slotDistance = alfHashTableDistanceFromWantedIndex(
-			table, otherBucket->hash, index);
-		if (distance > slotDistance)
+/** Append an entry for a key that is not in a table, at the empty index that
+ * was found by alfOrderedHashTableProbe. The value is zero-initialized if it
+ * is NULL. Returns the entry or NULL if the key could not be copied **/
+static AlfHashTableBucket* alfOrderedHashTableAppend(
+	AlfOrderedHashTable* table,
+	const void* key,
+	uint64_t hash,
+	uint32_t position,
+	const void* value)
+{
+	// Reserving space can rebuild the indices, then the position changes
+	if (table->entryCount == table->entryCapacity)
+	{
+		if (!alfOrderedHashTableReserve(table)) { return NULL; }
+		position = alfOrderedHashTableProbe(table, key, hash);
+	}
+
+	// Copy key and append entry
+	void* keyCopy = alfHashTableCopyKey(&table->table, key);
+	if (!keyCopy) { return NULL; }
+	AlfHashTable* settings = &table->table;
+	AlfHashTableBucket* entry = 
+		alfOrderedHashTableGetEntry(table, table->entryCount);
+	if (value)
+	{
+		alfHashTableSetBucket(settings, entry, keyCopy, hash, value);
+	}
+	else
+	{
+		entry->hash = hash;
+		if (settings->keySize)
 		{
-			return NULL;
+			memcpy((uint8_t*)entry + settings->keyOffset, key, 
+				settings->keySize);
 		}
-
-		// Check if object is the same
-		if (otherBucket->hash == hash &&
-			table->keyEqual(key, otherBucket->key))
+		else
 		{
-			*indexOut = index;
-			return otherBucket->value;
+			entry->key = keyCopy;
 		}
-
-		index = ALF_MOD_POWER_OF_TWO(index + 1, table->bucketCount);
-		distance++;
+		memset(alfHashTableGetBucketValue(settings, entry), 0, 
+			settings->valueSize);
 	}
+	table->indices[position] = ++table->entryCount;
+	table->table.size++;
+	return entry;
 }
 
 // ========================================================================== //
-// HashTable Functions
+// OrderedHashTable Functions
 // ========================================================================== //
 
-AlfHashTable* alfCreateHashTable(const AlfHashTableDesc* desc)
+AlfOrderedHashTable* alfCreateOrderedHashTable(const AlfHashTableDesc* desc)
 {
 	// Assert the preconditions
 	ALF_COLLECTION_ASSERT(
-		ALF_IS_POWER_OF_TWO(desc->bucketCount),
-		"Bucket count of hash table must be a power of two"
+		desc->keySize || (desc->keyEqual && (desc->keyCopy || 
+		desc->keyStorage == ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA)),
+		"Hash table with keys stored by pointer requires key functions"
 	);
+	ALF_COLLECTION_ASSERT(desc->bucketCount <= UINT32_MAX / 4,
+		"Ordered hash tables index entries with 32 bits");
 
-	// Allocate and setup table
-	AlfHashTable* table = ALF_COLLECTION_ALLOC(sizeof(AlfHashTable));
+	// Allocate table and setup entries
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfOrderedHashTable* table = 
+		alfAllocatorAlloc(&allocator, sizeof(AlfOrderedHashTable));
 	if (!table) { return NULL; }
-	table->automaticShrink = ALF_FALSE;
-	table->valueSize = desc->valueSize;
-	table->hashFunction = desc->hashFunction;
-	table->keyEqual = desc->keyEqual;
-	table->keyCopy = desc->keyCopy;
-	table->keyDestructor = 
-		desc->keyDestructor ? desc->keyDestructor : alfDefaultDestructor;
-	table->valueCleaner = 
-		desc->valueCleaner ? desc->valueCleaner : alfDefaultCleaner;
-
-	// Setup buckets
-	table->maxLoadFactor = ALF_DEFAULT_HASH_TABLE_LOAD_FACTOR_TRIGGER_RESIZE;
-	table->size = 0;
-	table->bucketSize = 
-		sizeof(AlfHashTableBucket) + table->valueSize;
-	alfHashTableSetupBuckets(table, desc->bucketCount);
-
+	alfHashTableSetupSettings(&table->table, desc);
+	table->entries = NULL;
+	table->entryCount = 0;
+	table->entryCapacity = 0;
+	table->indices = NULL;
+	table->indexCount = 0;
+	const uint32_t capacity = (uint32_t)(
+		desc->bucketCount > ALF_ORDERED_HASH_TABLE_MIN_CAPACITY ? 
+		desc->bucketCount : ALF_ORDERED_HASH_TABLE_MIN_CAPACITY);
+	if (!alfOrderedHashTableRebuild(table, capacity))
+	{
+		alfAllocatorFree(&allocator, table, sizeof(AlfOrderedHashTable));
+		return NULL;
+	}
 	return table;
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfHashTable* alfCreateHashTableSimple(
-	uint32_t valueSize, 
-	PFN_AlfCollectionCleaner valueCleaner)
+void alfDestroyOrderedHashTable(AlfOrderedHashTable* table)
 {
-	// Setup descriptor for hash table using strings as keys
-	AlfHashTableDesc desc;
-	desc.bucketCount = ALF_DEFAULT_HASH_TABLE_BUCKET_COUNT;
-	desc.valueSize = valueSize;
-	desc.hashFunction = alfStringHashFunction;
-	desc.keyEqual = alfStringEqualFunction;
-	desc.keyCopy = alfStringCopyFunction;
-	desc.keyDestructor = alfStringDestructorFunction;
-	desc.valueCleaner = valueCleaner;
-	return alfCreateHashTable(&desc);
+	AlfHashTable* settings = &table->table;
+	for (uint32_t i = 0; i < table->entryCount; i++)
+	{
+		AlfHashTableBucket* entry = alfOrderedHashTableGetEntry(table, i);
+		if (entry->hash != 0)
+		{
+			alfHashTableDestroyKey(settings, entry->key);
+			settings->valueCleaner(alfHashTableGetBucketValue(settings, entry));
+		}
+	}
+	alfHashTableArenaFree(settings);
+	const AlfAllocator allocator = settings->allocator;
+	alfAllocatorFree(
+		&allocator, table->indices, sizeof(uint32_t) * table->indexCount);
+	alfAllocatorFree(&allocator, table->entries, 
+		(uint64_t)settings->bucketSize * table->entryCapacity);
+	alfAllocatorFree(&allocator, table, sizeof(AlfOrderedHashTable));
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfDestroyHashTable(AlfHashTable* table)
+AlfBool alfOrderedHashTableInsert(
+	AlfOrderedHashTable* table,
+	const void* key,
+	const void* value)
 {
-	// Cleanup all remaining buckets
-	for (uint32_t i = 0; i < table->bucketCount; i++)
+	// Replace the value of a key in the table, keeping its place in the order
+	AlfHashTable* settings = &table->table;
+	const uint64_t hash = alfHashTableGetKeyHash(settings, key);
+	const uint32_t position = alfOrderedHashTableProbe(table, key, hash);
+	if (table->indices[position])
 	{
-		const AlfHashTableBucket* bucket =
-			alfHashTableGetBucketAtIndex(table->buckets, table->bucketSize, i);
-		if (bucket->hash != 0 && !alfHashTableIsTombstone(bucket->hash))
-		{
-			table->keyDestructor(bucket->key);
-			table->valueCleaner(bucket->value);
-		}
+		void* oldValue = alfHashTableGetBucketValue(settings, 
+			alfOrderedHashTableGetEntry(table, table->indices[position] - 1));
+		settings->valueCleaner(oldValue);
+		memcpy(oldValue, value, settings->valueSize);
+		return ALF_TRUE;
 	}
+	return alfOrderedHashTableAppend(table, key, hash, position, value) != NULL;
+}
 
-	// Free table
-	ALF_COLLECTION_FREE(table->buckets);
-	ALF_COLLECTION_FREE(table);
+// -------------------------------------------------------------------------- //
+
+void* alfOrderedHashTableGet(AlfOrderedHashTable* table, const void* key)
+{
+	const uint32_t index = table->indices[alfOrderedHashTableProbe(
+		table, key, alfHashTableGetKeyHash(&table->table, key))];
+	if (!index) { return NULL; }
+	return alfHashTableGetBucketValue(
+		&table->table, alfOrderedHashTableGetEntry(table, index - 1));
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfBool alfHashTableInsert(
-	AlfHashTable* table, 
-	const void* key, 
-	const void* value)
+void* alfOrderedHashTableFindOrInsert(
+	AlfOrderedHashTable* table,
+	const void* key,
+	AlfBool* insertedOut)
 {
-	// Resize if load factor exceeds certain value
-	const float loadFactor = alfHashTableGetLoadFactor(table);
-	if (loadFactor >= table->maxLoadFactor)
+	// Return the value of a key in the table
+	AlfHashTable* settings = &table->table;
+	const uint64_t hash = alfHashTableGetKeyHash(settings, key);
+	const uint32_t position = alfOrderedHashTableProbe(table, key, hash);
+	if (insertedOut) { *insertedOut = table->indices[position] == 0; }
+	if (table->indices[position])
 	{
-		alfHashTableResize(table, table->bucketCount << 1);
+		return alfHashTableGetBucketValue(settings, 
+			alfOrderedHashTableGetEntry(table, table->indices[position] - 1));
 	}
 
-	// Insert
-	void* keyCopy = table->keyCopy(key);
-	const AlfBool success =  
-		alfHashTableInsertKeyValue(table, keyCopy, value);
-	if (!success)
+	// Append key with a zero value
+	AlfHashTableBucket* entry = 
+		alfOrderedHashTableAppend(table, key, hash, position, NULL);
+	return entry ? alfHashTableGetBucketValue(settings, entry) : NULL;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfOrderedHashTableRemove(
+	AlfOrderedHashTable* table,
+	const void* key,
+	void* valueOut)
+{
+	// Find entry
+	AlfHashTable* settings = &table->table;
+	const uint32_t position = alfOrderedHashTableProbe(
+		table, key, alfHashTableGetKeyHash(settings, key));
+	if (!table->indices[position]) { return ALF_FALSE; }
+
+	// Remove entry, it keeps its place in the entry array until compacted
+	AlfHashTableBucket* entry = 
+		alfOrderedHashTableGetEntry(table, table->indices[position] - 1);
+	if (valueOut)
 	{
-		table->keyDestructor(keyCopy);
-		return ALF_FALSE;
+		memcpy(valueOut, alfHashTableGetBucketValue(settings, entry), 
+			settings->valueSize);
 	}
-	table->size++;
-	return success;
+	alfHashTableDestroyKey(settings, entry->key);
+	entry->hash = 0;
+	alfOrderedHashTableEraseIndex(table, position);
+	settings->size--;
+
+	// Compact, and shrink, once most entries have been removed so that 
+	// iteration stays proportional to the size
+	if (table->entryCount > ALF_ORDERED_HASH_TABLE_MIN_CAPACITY &&
+		settings->size < table->entryCount / 4)
+	{
+		uint32_t capacity = table->entryCapacity;
+		while (capacity > ALF_ORDERED_HASH_TABLE_MIN_CAPACITY &&
+			settings->size < capacity / 4)
+		{
+			capacity >>= 1;
+		}
+		alfOrderedHashTableRebuild(table, capacity);
+	}
+	return ALF_TRUE;
 }
 
 // -------------------------------------------------------------------------- //
 
-void* alfHashTableGet(AlfHashTable* table, const void* key)
+AlfBool alfOrderedHashTableHasKey(AlfOrderedHashTable* table, const void* key)
 {
-	uint32_t index;
-	return alfHashTableFindIndex(table, key, &index);
+	return alfOrderedHashTableGet(table, key) != NULL;
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfBool alfHashTableRemove(AlfHashTable* table, const void* key, void* valueOut)
+uint64_t alfOrderedHashTableGetSize(AlfOrderedHashTable* table)
 {
-	// Find value and index, return immediately if value was not found
-	uint32_t index;
-	void* value =  alfHashTableFindIndex(table, key, &index);
-	if (!value)
-	{
-		return ALF_FALSE;
-	}
+	return table->table.size;
+}
 
-	// Retrieve bucket, reset hash and write value to user buffer
-	AlfHashTableBucket* bucket = 
-		alfHashTableGetBucketAtIndex(table->buckets, table->bucketSize, index);
-	bucket->hash = alfHashTableMarkTombstone(bucket->hash);
-	table->keyDestructor(bucket->key);
-	if (valueOut) 
+// -------------------------------------------------------------------------- //
+
+AlfBool alfOrderedHashTableIterate(
+	AlfOrderedHashTable* table,
+	PFN_AlfOrderedHashTableIterate iterateFunction)
+{
+	uint32_t index = 0;
+	for (uint32_t i = 0; i < table->entryCount; i++)
 	{
-		memcpy(valueOut, value, table->valueSize);
+		AlfHashTableBucket* entry = alfOrderedHashTableGetEntry(table, i);
+		if (entry->hash == 0) { continue; }
+		const AlfBool cont = iterateFunction(table, index++, 
+			alfHashTableGetBucketKey(&table->table, entry), 
+			alfHashTableGetBucketValue(&table->table, entry));
+		if (!cont) { return ALF_FALSE; }
 	}
-	table->size--;
 	return ALF_TRUE;
 }
 
+// ========================================================================== //
+// ConcurrentHashTable Structures
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Size of a cache line. Used to keep shards from sharing cache lines **/
+#define ALF_COLLECTION_CACHE_LINE_SIZE 64
+
 // -------------------------------------------------------------------------- //
 
-AlfBool alfHasKey(AlfHashTable* table, const void* key)
+/** Default number of shards for each hardware thread **/
+#define ALF_CONCURRENT_HASH_TABLE_SHARDS_PER_THREAD 4
+
+// -------------------------------------------------------------------------- //
+
+/** A single shard of a concurrent hash table. Each shard starts on its own
+ * cache line and is directly followed by the memory of its lock, so that the
+ * lock word that readers and writers of one shard update never shares a cache
+ * line with the lock of another shard **/
+typedef struct AlfConcurrentHashTableShard
+{
+	/** Lock for the table of the shard, placed after the shard **/
+	AlfReadWriteLock* lock;
+	/** Table with all entries whose hash maps to the shard **/
+	AlfHashTable* table;
+} AlfConcurrentHashTableShard;
+
+// -------------------------------------------------------------------------- //
+
+/** Concurrent hash table structure **/
+typedef struct tag_AlfConcurrentHashTable
+{
+	/** Number of shards, always a power of two **/
+	uint32_t shardCount;
+	/** Size of value object in bytes **/
+	uint32_t valueSize;
+	/** Distance between shards in bytes, a multiple of the cache line size **/
+	uint64_t shardStride;
+	/** Shards with their locks, aligned to a cache line **/
+	uint8_t* shards;
+	/** Memory of the shards, which the aligned shards are placed in **/
+	void* shardMemory;
+	/** Allocator of the table and the shard memory **/
+	AlfAllocator allocator;
+} tag_AlfConcurrentHashTable;
+
+// ========================================================================== //
+// ConcurrentHashTable Private Functions
+// ========================================================================== //
+
+/** Returns the shard at an index **/
+static AlfConcurrentHashTableShard* alfConcurrentHashTableGetShardAt(
+	AlfConcurrentHashTable* table,
+	uint32_t index)
 {
-	uint32_t index;
-	return alfHashTableFindIndex(table, key, &index) != NULL;
+	return (AlfConcurrentHashTableShard*)
+		(table->shards + (uint64_t)index * table->shardStride);
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfHashTableResize(AlfHashTable* table, uint32_t size)
+/** Returns the hash of a key. All shards share the same hash function **/
+static uint64_t alfConcurrentHashTableGetKeyHash(
+	AlfConcurrentHashTable* table,
+	const void* key)
 {
-	// Assert the preconditions
+	return alfHashTableGetKeyHash(
+		alfConcurrentHashTableGetShardAt(table, 0)->table, key);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the shard that a hash maps to. The hash is mixed with a 
+ * multiplicative hash so that the shard index depends on all bits of the hash,
+ * and not only the low bits that select buckets within the shard **/
+static AlfConcurrentHashTableShard* alfConcurrentHashTableGetShard(
+	AlfConcurrentHashTable* table,
+	uint64_t hash)
+{
+	const uint64_t mixed = hash * 0x9e3779b97f4a7c15ull;
+	return alfConcurrentHashTableGetShardAt(table, 
+		ALF_MOD_POWER_OF_TWO((uint32_t)(mixed >> 32), table->shardCount));
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy the first 'count' shards of a concurrent hash table **/
+static void alfConcurrentHashTableDestroyShards(
+	AlfConcurrentHashTable* table,
+	uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		AlfConcurrentHashTableShard* shard = 
+			alfConcurrentHashTableGetShardAt(table, i);
+		if (shard->table)
+		{
+			alfDestroyHashTable(shard->table);
+		}
+		if (shard->lock)
+		{
+			alfDeinitReadWriteLock(shard->lock);
+		}
+	}
+	alfAllocatorFree(&table->allocator, table->shardMemory, 
+		table->shardStride * table->shardCount + 
+		ALF_COLLECTION_CACHE_LINE_SIZE);
+}
+
+// ========================================================================== //
+// ConcurrentHashTable Functions
+// ========================================================================== //
+
+AlfConcurrentHashTable* alfCreateConcurrentHashTable(
+	const AlfHashTableDesc* desc,
+	uint32_t shardCount)
+{
+	// Determine shard count
+	if (!shardCount)
+	{
+		const uint32_t target = alfGetHardwareThreadCount() * 
+			ALF_CONCURRENT_HASH_TABLE_SHARDS_PER_THREAD;
+		shardCount = 1;
+		while (shardCount < target) { shardCount <<= 1; }
+	}
 	ALF_COLLECTION_ASSERT(
-		ALF_IS_POWER_OF_TWO(size),
-		"Hash table can only be resized to power of two sizes"
+		ALF_IS_POWER_OF_TWO(shardCount),
+		"Shard count of concurrent hash table must be a power of two"
 	);
 
-	// Store old and setup new
-	const uint32_t oldBucketCount = table->bucketCount;
-	uint8_t* oldBuckets = table->buckets;
-	alfHashTableSetupBuckets(table, size);
+	// Allocate table
+	const AlfAllocator allocator = alfAllocatorOrDefault(desc->allocator);
+	AlfConcurrentHashTable* table = 
+		alfAllocatorAlloc(&allocator, sizeof(AlfConcurrentHashTable));
+	if (!table) { return NULL; }
+	table->allocator = allocator;
+	table->shardCount = shardCount;
+	table->valueSize = desc->valueSize;
 
-	// Copy values from old
-	uint32_t moveSizeLeft = table->size;
-	for (uint32_t i = 0; i < oldBucketCount && moveSizeLeft > 0; i++)
+	// Each shard and its lock take up whole cache lines. The memory has room
+	// to align the first shard to a cache line
+	const uint64_t lockOffset = ALF_ALIGN_POWER_OF_TWO(
+		sizeof(AlfConcurrentHashTableShard), sizeof(void*) * 2);
+	table->shardStride = ALF_ALIGN_POWER_OF_TWO(
+		lockOffset + alfGetReadWriteLockSize(), ALF_COLLECTION_CACHE_LINE_SIZE);
+	table->shardMemory = alfAllocatorAlloc(&allocator, 
+		table->shardStride * shardCount + ALF_COLLECTION_CACHE_LINE_SIZE);
+	if (!table->shardMemory)
 	{
-		AlfHashTableBucket* oldBucket = alfHashTableGetBucketAtIndex(
-			oldBuckets, table->bucketSize, i);
-		const uint32_t hash = oldBucket->hash;
-		if (hash != 0 && !alfHashTableIsTombstone(hash))
+		alfAllocatorFree(&allocator, table, sizeof(AlfConcurrentHashTable));
+		return NULL;
+	}
+	table->shards = (uint8_t*)ALF_ALIGN_POWER_OF_TWO(
+		(uintptr_t)table->shardMemory, ALF_COLLECTION_CACHE_LINE_SIZE);
+
+	// Setup shards, the initial buckets are divided between them
+	AlfHashTableDesc shardDesc = *desc;
+	shardDesc.bucketCount = desc->bucketCount > shardCount ? 
+		desc->bucketCount / shardCount : 1;
+	for (uint32_t i = 0; i < shardCount; i++)
+	{
+		AlfConcurrentHashTableShard* shard = 
+			alfConcurrentHashTableGetShardAt(table, i);
+		shard->table = alfCreateHashTable(&shardDesc);
+		shard->lock = alfInitReadWriteLock((uint8_t*)shard + lockOffset);
+		if (!shard->table || !shard->lock)
 		{
-			void* key = oldBucket->key;
-			void* value = oldBucket->value;
-			alfHashTableInsertKeyValue(table, key, value);
-			moveSizeLeft--;
+			alfConcurrentHashTableDestroyShards(table, i + 1);
+			alfAllocatorFree(&allocator, table, sizeof(AlfConcurrentHashTable));
+			return NULL;
 		}
 	}
 
-	// Cleanup old
-	ALF_COLLECTION_FREE(oldBuckets);
+	return table;
 }
 
 // -------------------------------------------------------------------------- //
 
-AlfBool alfHashTableIterate(AlfHashTable* table, PFN_AlfHashTableIterate iterateFunction)
+void alfDestroyConcurrentHashTable(AlfConcurrentHashTable* table)
 {
-	uint32_t index = 0;
-	for (uint32_t i = 0; i < table->bucketCount; i++)
-	{
-		// Retrieve bucket
-		const AlfHashTableBucket* bucket = 
-			alfHashTableGetBucketAtIndex(table->buckets, table->bucketSize, i);
+	const AlfAllocator allocator = table->allocator;
+	alfConcurrentHashTableDestroyShards(table, table->shardCount);
+	alfAllocatorFree(&allocator, table, sizeof(AlfConcurrentHashTable));
+}
 
-		// Call the iterator function for key-value pair if hash is valid
-		if (bucket->hash != 0 && !alfHashTableIsTombstone(bucket->hash))
-		{
-			const AlfBool cont = iterateFunction(
-				table, index, bucket->key, (void*)bucket->value);
-			if (!cont) { return ALF_FALSE; }
-			index++;
-		}
+// -------------------------------------------------------------------------- //
+
+AlfBool alfConcurrentHashTableInsert(
+	AlfConcurrentHashTable* table,
+	const void* key,
+	const void* value)
+{
+	const uint64_t hash = alfConcurrentHashTableGetKeyHash(table, key);
+	AlfConcurrentHashTableShard* shard = 
+		alfConcurrentHashTableGetShard(table, hash);
+	alfAcquireWriteLock(shard->lock);
+	const AlfBool success = 
+		alfHashTableInsertHashed(shard->table, key, hash, value);
+	alfReleaseWriteLock(shard->lock);
+	return success;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool alfConcurrentHashTableGet(
+	AlfConcurrentHashTable* table,
+	const void* key,
+	void* valueOut)
+{
+	const uint64_t hash = alfConcurrentHashTableGetKeyHash(table, key);
+	AlfConcurrentHashTableShard* shard = 
+		alfConcurrentHashTableGetShard(table, hash);
+	alfAcquireReadLock(shard->lock);
+	const void* value = alfHashTableGetHashed(shard->table, key, hash);
+	if (value && valueOut)
+	{
+		memcpy(valueOut, value, table->valueSize);
 	}
-	return ALF_TRUE;
+	alfReleaseReadLock(shard->lock);
+	return value != NULL;
 }
 
 // -------------------------------------------------------------------------- //
 
-void alfHashTableSetMaxLoadFactor(AlfHashTable* table, float loadFactor)
+AlfBool alfConcurrentHashTableRemove(
+	AlfConcurrentHashTable* table,
+	const void* key,
+	void* valueOut)
 {
-	table->maxLoadFactor = loadFactor;
+	const uint64_t hash = alfConcurrentHashTableGetKeyHash(table, key);
+	AlfConcurrentHashTableShard* shard = 
+		alfConcurrentHashTableGetShard(table, hash);
+	alfAcquireWriteLock(shard->lock);
+	const AlfBool success = 
+		alfHashTableRemoveHashed(shard->table, key, hash, valueOut);
+	alfReleaseWriteLock(shard->lock);
+	return success;
 }
 
 // -------------------------------------------------------------------------- //
 
-float alfHashTableGetLoadFactor(AlfHashTable* table)
+AlfBool alfConcurrentHashTableHasKey(
+	AlfConcurrentHashTable* table,
+	const void* key)
 {
-	return (float)table->size / (float)table->bucketCount;
+	return alfConcurrentHashTableGet(table, key, NULL);
 }
 
 // -------------------------------------------------------------------------- //
 
-uint64_t alfHashTableGetSize(AlfHashTable* table)
+uint64_t alfConcurrentHashTableGetSize(AlfConcurrentHashTable* table)
 {
-	return table->size;
+	uint64_t size = 0;
+	for (uint32_t i = 0; i < table->shardCount; i++)
+	{
+		AlfConcurrentHashTableShard* shard = 
+			alfConcurrentHashTableGetShardAt(table, i);
+		alfAcquireReadLock(shard->lock);
+		size += alfHashTableGetSize(shard->table);
+		alfReleaseReadLock(shard->lock);
+	}
+	return size;
 }
 
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
 // ========================================================================== //
 // End of Implementation
 // ========================================================================== //
@@ -33,6 +33,7 @@ extern "C" {
 
 // Standard headers
 #include <stdint.h>
+#include <string.h>
 
 // ========================================================================== //
 // Types and Values
@@ -62,6 +63,11 @@ typedef uint32_t AlfBool;
 #	include <stdlib.h>
 	/** Allocation function **/
 #	define ALF_COLLECTION_ALLOC(size) malloc(size)
+#	if !defined(ALF_COLLECTION_REALLOC)
+	/** Reallocation function. Only defined by default together with the 
+	 * allocation function, otherwise reallocation allocates and copies **/
+#		define ALF_COLLECTION_REALLOC(mem, size) realloc(mem, size)
+#	endif
 #endif
 
 // -------------------------------------------------------------------------- //
@@ -137,11 +143,281 @@ typedef uint32_t(*PFN_AlfCollectionHash)(const void* object);
 
 // -------------------------------------------------------------------------- //
 
+/** Prototype of a function to compute the 64-bit hash for an object.
+ * \param object Object to compute hash from.
+ */
+typedef uint64_t(*PFN_AlfCollectionHash64)(const void* object);
+
+// -------------------------------------------------------------------------- //
+
 /** Prototype of a function to create a copy of an object.
  * \param object Object to create copy of.
  */
 typedef void*(*PFN_AlfCollectionCopy)(const void* object);
 
+// -------------------------------------------------------------------------- //
+
+/** Prototype of a function that tests an object in a collection.
+ * \param object Object to test.
+ * \param user User pointer that was passed along with the function.
+ * \return True if the object passes the test, otherwise false.
+ */
+typedef AlfBool(*PFN_AlfCollectionPredicate)(const void* object, void* user);
+
+// -------------------------------------------------------------------------- //
+
+/** Prototype of a function that allocates memory for an allocator.
+ * \param user User pointer of the allocator.
+ * \param size Size of the allocation in bytes.
+ * \return Memory aligned to at least 16 bytes, or NULL on failure.
+ */
+typedef void*(*PFN_AlfAllocatorAlloc)(void* user, uint64_t size);
+
+// -------------------------------------------------------------------------- //
+
+/** Prototype of a function that resizes an allocation of an allocator. The
+ * contents are kept up to the smaller of the two sizes.
+ * \param user User pointer of the allocator.
+ * \param memory Memory to resize.
+ * \param oldSize Size of the memory in bytes.
+ * \param size New size in bytes.
+ * \return Resized memory, or NULL on failure in which case the memory is left
+ * unchanged.
+ */
+typedef void*(*PFN_AlfAllocatorRealloc)(
+	void* user, 
+	void* memory, 
+	uint64_t oldSize,
+	uint64_t size);
+
+// -------------------------------------------------------------------------- //
+
+/** Prototype of a function that frees memory of an allocator.
+ * \param user User pointer of the allocator.
+ * \param memory Memory to free, never NULL.
+ * \param size Size of the memory in bytes, as it was allocated.
+ */
+typedef void(*PFN_AlfAllocatorFree)(void* user, void* memory, uint64_t size);
+
+// ========================================================================== //
+// Allocator Structures
+// ========================================================================== //
+
+/** \struct AlfAllocator
+ * \author Filip Björklund
+ * \date 17 oktober 2026 - 09:10
+ * \brief Allocator.
+ * \details
+ * Structure that represents an allocator that a collection allocates all of 
+ * its memory with, including the collection itself. The allocator is copied
+ * into the collection at creation, but the memory that the user pointer 
+ * refers to must outlive the collection.
+ * 
+ * Collections that are created without an allocator, or with an allocator 
+ * whose allocation function is NULL, use ALF_COLLECTION_ALLOC, 
+ * ALF_COLLECTION_REALLOC and ALF_COLLECTION_FREE. If the reallocation function
+ * is NULL then memory is instead reallocated by allocating, copying and 
+ * freeing. If the free function is NULL then memory is never freed, which 
+ * suits allocators that release all memory at once.
+ * 
+ * Allocators are called from every thread that uses the collection. The
+ * built-in allocators are not thread-safe, so they must not be used by 
+ * concurrent hash tables or by the parallel hash table functions.
+ */
+typedef struct AlfAllocator
+{
+	/** Allocation function **/
+	PFN_AlfAllocatorAlloc alloc;
+	/** Reallocation function **/
+	PFN_AlfAllocatorRealloc realloc;
+	/** Free function **/
+	PFN_AlfAllocatorFree free;
+	/** User pointer that is passed to each function **/
+	void* user;
+} AlfAllocator;
+
+// -------------------------------------------------------------------------- //
+
+/** \struct AlfAllocatorStatistics
+ * \author Filip Björklund
+ * \date 17 oktober 2026 - 09:10
+ * \brief Allocator statistics.
+ * \details
+ * Structure that represents the counters of a counting allocator.
+ */
+typedef struct AlfAllocatorStatistics
+{
+	/** Number of allocations **/
+	uint64_t allocationCount;
+	/** Number of reallocations **/
+	uint64_t reallocationCount;
+	/** Number of frees **/
+	uint64_t freeCount;
+	/** Number of bytes that are currently allocated **/
+	uint64_t currentBytes;
+	/** Largest number of bytes that have been allocated at once **/
+	uint64_t peakBytes;
+	/** Number of bytes that have been allocated in total, including the new
+	 * sizes of reallocations **/
+	uint64_t totalBytes;
+} AlfAllocatorStatistics;
+
+// -------------------------------------------------------------------------- //
+
+/** \struct AlfArenaAllocator
+ * \author Filip Björklund
+ * \date 17 oktober 2026 - 09:10
+ * \brief Arena allocator.
+ * \details
+ * Structure that represents an allocator that hands out memory by bumping a 
+ * pointer through large blocks. Memory is only returned when the arena is 
+ * reset or destroyed, except for the latest allocation, which can also be 
+ * freed and grown in place. This makes a collection that grows by 
+ * reallocation, such as an array-list that is only added to, extend its 
+ * buffer without copying.
+ */
+typedef struct tag_AlfArenaAllocator AlfArenaAllocator;
+
+// -------------------------------------------------------------------------- //
+
+/** \struct AlfPoolAllocator
+ * \author Filip Björklund
+ * \date 17 oktober 2026 - 09:10
+ * \brief Pool allocator.
+ * \details
+ * Structure that represents an allocator of fixed-size objects, which are 
+ * allocated and freed in constant time from a free list. Allocations that are
+ * larger than the object size are passed on to the parent allocator.
+ */
+typedef struct tag_AlfPoolAllocator AlfPoolAllocator;
+
+// -------------------------------------------------------------------------- //
+
+/** \struct AlfCountingAllocator
+ * \author Filip Björklund
+ * \date 17 oktober 2026 - 09:10
+ * \brief Counting allocator.
+ * \details
+ * Structure that represents an allocator that passes every call on to its 
+ * parent allocator and counts the calls and bytes, for finding out how much
+ * memory a collection uses.
+ */
+typedef struct tag_AlfCountingAllocator AlfCountingAllocator;
+
+// ========================================================================== //
+// Allocator Functions
+// ========================================================================== //
+
+/** Create an arena allocator.
+ * \brief Create arena allocator.
+ * \param[in] parent Allocator that blocks are allocated with, or NULL for the
+ * default allocation functions.
+ * \param[in] blockSize Size of each block in bytes, or zero for 64 kB. Larger
+ * allocations get a block of their own.
+ * \return Arena allocator or NULL on failure.
+ */
+AlfArenaAllocator* alfCreateArenaAllocator(
+	const AlfAllocator* parent, 
+	uint64_t blockSize);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy an arena allocator and free all memory that was allocated from it.
+ * \brief Destroy arena allocator.
+ * \param[in] arena Arena allocator to destroy.
+ */
+void alfDestroyArenaAllocator(AlfArenaAllocator* arena);
+
+// -------------------------------------------------------------------------- //
+
+/** Reset an arena allocator, which frees all memory that was allocated from it
+ * at once. The first block is kept for the following allocations.
+ * \brief Reset arena allocator.
+ * \param[in] arena Arena allocator to reset.
+ */
+void alfArenaAllocatorReset(AlfArenaAllocator* arena);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns an allocator that allocates from an arena allocator.
+ * \brief Returns allocator of arena allocator.
+ * \param[in] arena Arena allocator.
+ * \return Allocator.
+ */
+AlfAllocator alfArenaAllocatorGetAllocator(AlfArenaAllocator* arena);
+
+// -------------------------------------------------------------------------- //
+
+/** Create a pool allocator.
+ * \brief Create pool allocator.
+ * \param[in] parent Allocator that blocks of objects and large allocations are
+ * allocated with, or NULL for the default allocation functions.
+ * \param[in] objectSize Largest size in bytes that is allocated from the pool.
+ * \param[in] objectsPerBlock Number of objects that are allocated at once when
+ * the pool is empty, or zero for 64.
+ * \return Pool allocator or NULL on failure.
+ */
+AlfPoolAllocator* alfCreatePoolAllocator(
+	const AlfAllocator* parent, 
+	uint64_t objectSize,
+	uint32_t objectsPerBlock);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a pool allocator and free all objects that were allocated from it.
+ * Large allocations that were passed on to the parent must already be freed.
+ * \brief Destroy pool allocator.
+ * \param[in] pool Pool allocator to destroy.
+ */
+void alfDestroyPoolAllocator(AlfPoolAllocator* pool);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns an allocator that allocates from a pool allocator.
+ * \brief Returns allocator of pool allocator.
+ * \param[in] pool Pool allocator.
+ * \return Allocator.
+ */
+AlfAllocator alfPoolAllocatorGetAllocator(AlfPoolAllocator* pool);
+
+// -------------------------------------------------------------------------- //
+
+/** Create a counting allocator.
+ * \brief Create counting allocator.
+ * \param[in] parent Allocator that calls are passed on to, or NULL for the
+ * default allocation functions.
+ * \return Counting allocator or NULL on failure.
+ */
+AlfCountingAllocator* alfCreateCountingAllocator(const AlfAllocator* parent);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a counting allocator. Memory that is still allocated is not freed.
+ * \brief Destroy counting allocator.
+ * \param[in] counting Counting allocator to destroy.
+ */
+void alfDestroyCountingAllocator(AlfCountingAllocator* counting);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns an allocator that allocates through a counting allocator.
+ * \brief Returns allocator of counting allocator.
+ * \param[in] counting Counting allocator.
+ * \return Allocator.
+ */
+AlfAllocator alfCountingAllocatorGetAllocator(AlfCountingAllocator* counting);
+
+// -------------------------------------------------------------------------- //
+
+/** Retrieve the counters of a counting allocator.
+ * \brief Retrieve counting allocator statistics.
+ * \param[in] counting Counting allocator.
+ * \param[out] statisticsOut Statistics.
+ */
+void alfCountingAllocatorGetStatistics(
+	AlfCountingAllocator* counting,
+	AlfAllocatorStatistics* statisticsOut);
+
 // ========================================================================== //
 // Structures
 // ========================================================================== //
@@ -167,6 +443,8 @@ typedef struct AlfListDesc
 	uint64_t capacity;
 	/** Object destructor **/
 	PFN_AlfCollectionDestructor destructor;
+	/** Allocator, or NULL for the default allocation functions **/
+	const AlfAllocator* allocator;
 } AlfListDesc;
 
 // -------------------------------------------------------------------------- //
@@ -283,6 +561,66 @@ void* alfListRemoveObjectEqual(
 
 // -------------------------------------------------------------------------- //
 
+/** Add a number of objects to the end of a list. The list grows at most once.
+ * \brief Add objects to end of list.
+ * \param[in] list List to add objects to.
+ * \param[in] objects Array of objects to add.
+ * \param[in] count Number of objects to add.
+ */
+void alfListAddRange(AlfList* list, void* const* objects, uint64_t count);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a number of objects at the specified index in a list. The objects 
+ * after the index are moved once for all the objects. If the index is larger 
+ * than the highest index the objects are added to the end of the list.
+ * \brief Insert objects into list.
+ * \param[in] list List to insert objects into.
+ * \param[in] objects Array of objects to insert.
+ * \param[in] count Number of objects to insert.
+ * \param[in] index Index to insert the first object at.
+ */
+void alfListInsertRange(
+	AlfList* list, 
+	void* const* objects, 
+	uint64_t count, 
+	uint64_t index);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove a number of consecutive objects from a list. The objects after the
+ * range are moved once. Objects past the end of the list are ignored.
+ * \brief Remove objects from list.
+ * \param[in] list List to remove objects from.
+ * \param[in] index Index of the first object to remove.
+ * \param[in] count Number of objects to remove.
+ * \param[out] objectsOut Array that the removed objects are written to, or 
+ * NULL in which case the destructor is called for each removed object.
+ */
+void alfListRemoveRange(
+	AlfList* list, 
+	uint64_t index, 
+	uint64_t count, 
+	void** objectsOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove all objects from a list that pass a test, in a single pass over the
+ * list. The remaining objects keep their order and the destructor is called 
+ * for each removed object.
+ * \brief Remove objects from list that pass test.
+ * \param[in] list List to remove objects from.
+ * \param[in] predicate Function that returns true for objects to remove.
+ * \param[in] user User pointer that is passed to the function.
+ * \return Number of objects that were removed.
+ */
+uint64_t alfListRemoveIf(
+	AlfList* list, 
+	PFN_AlfCollectionPredicate predicate, 
+	void* user);
+
+// -------------------------------------------------------------------------- //
+
 /** Returns the object at the specified index in a list. The index will be
  * asserted to be valid.
  * \pre The index must be a valid index, meaning it must point to an object
@@ -389,6 +727,8 @@ typedef struct AlfArrayListDesc
 
 	/** Function for cleaning objects **/
 	PFN_AlfCollectionCleaner cleaner;
+	/** Allocator, or NULL for the default allocation functions **/
+	const AlfAllocator* allocator;
 } AlfArrayListDesc;
 
 // -------------------------------------------------------------------------- //
@@ -404,6 +744,28 @@ typedef struct AlfArrayListDesc
  */
 typedef struct tag_AlfArrayList AlfArrayList;
 
+// -------------------------------------------------------------------------- //
+
+/** \enum AlfArrayListKeyType
+ * \author Filip Björklund
+ * \date 17 oktober 2026 - 10:05
+ * \brief Array-list key type.
+ * \details
+ * Enumeration of the types of keys that an array-list can be radix sorted by.
+ * Keys are read in the byte order of the machine.
+ */
+typedef enum AlfArrayListKeyType
+{
+	/** Unsigned integer of 1, 2, 4 or 8 bytes **/
+	ALF_ARRAY_LIST_KEY_TYPE_UNSIGNED = 0,
+	/** Two's complement signed integer of 1, 2, 4 or 8 bytes **/
+	ALF_ARRAY_LIST_KEY_TYPE_SIGNED,
+	/** IEEE 754 floating-point number of 4 or 8 bytes. Negative zero is 
+	 * ordered before positive zero and NaN values are ordered after infinity,
+	 * or before negative infinity if their sign bit is set **/
+	ALF_ARRAY_LIST_KEY_TYPE_FLOAT
+} AlfArrayListKeyType;
+
 // ========================================================================== //
 // ArrayList Functions
 // ========================================================================== //
@@ -507,6 +869,73 @@ void alfArrayListRemoveObject(
 
 // -------------------------------------------------------------------------- //
 
+/** Add a number of objects to the end of an array-list. The list grows at most
+ * once.
+ * \brief Add objects to end of array-list.
+ * \param[in] list List to add objects to.
+ * \param[in] objects Array of objects to add, each the object size of the 
+ * list.
+ * \param[in] count Number of objects to add.
+ */
+void alfArrayListAddRange(
+	AlfArrayList* list, 
+	const void* objects, 
+	uint64_t count);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a number of objects at the specified index in an array-list. The 
+ * objects after the index are moved once for all the objects. If the index is
+ * larger than the highest index the objects are added to the end of the list.
+ * \brief Insert objects into array-list.
+ * \param[in] list List to insert objects into.
+ * \param[in] objects Array of objects to insert, each the object size of the
+ * list.
+ * \param[in] count Number of objects to insert.
+ * \param[in] index Index to insert the first object at.
+ */
+void alfArrayListInsertRange(
+	AlfArrayList* list, 
+	const void* objects, 
+	uint64_t count, 
+	uint64_t index);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove a number of consecutive objects from an array-list. The objects 
+ * after the range are moved once. Objects past the end of the list are 
+ * ignored. Like alfArrayListRemove the removed objects are not cleaned.
+ * \brief Remove objects from array-list.
+ * \param[in] list List to remove objects from.
+ * \param[in] index Index of the first object to remove.
+ * \param[in] count Number of objects to remove.
+ * \param[in,out] objects Removed objects are written to this buffer if 
+ * non-NULL.
+ */
+void alfArrayListRemoveRange(
+	AlfArrayList* list, 
+	uint64_t index, 
+	uint64_t count, 
+	void* objects);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove all objects from an array-list that pass a test, in a single pass 
+ * over the list. The remaining objects keep their order and the cleaner is 
+ * called for each removed object.
+ * \brief Remove objects from array-list that pass test.
+ * \param[in] list List to remove objects from.
+ * \param[in] predicate Function that returns true for objects to remove.
+ * \param[in] user User pointer that is passed to the function.
+ * \return Number of objects that were removed.
+ */
+uint64_t alfArrayListRemoveIf(
+	AlfArrayList* list, 
+	PFN_AlfCollectionPredicate predicate, 
+	void* user);
+
+// -------------------------------------------------------------------------- //
+
 /** Returns the object at the specified index in an array-list.
  * \pre Index must not be out of bounds.
  * \brief Returns object at index in array-list.
@@ -580,7 +1009,9 @@ const uint8_t* alfArrayListGetData(const AlfArrayList* list);
 
 /** Sort an array list in ascending order. The 'compareFunction' is used to 
  * compare two objects to see which should appear before the other. Ties are 
- * broken arbitrarily.
+ * broken arbitrarily. The sort is a pattern-defeating quicksort, which takes
+ * O(n log n) time in the worst case and linear time for input that is already
+ * sorted.
  * \brief Sort array list.
  * \param list List to sort.
  * \param compareFunction Comparison function. 
@@ -589,6 +1020,260 @@ void alfArrayListSort(
 	AlfArrayList* list, 
 	PFN_AlfCollectionCompare compareFunction);
 
+// -------------------------------------------------------------------------- //
+
+/** Sort an array list in ascending order of a key that is embedded in each 
+ * object, without calling a comparison function. The sort is a stable least 
+ * significant digit radix sort, which makes one pass over the objects for 
+ * each byte of the key. Passes over bytes that are the same in all keys are
+ * skipped. The objects are moved through a scratch buffer of the same size as
+ * the list buffer, which is allocated with the allocator of the list.
+ * \brief Radix sort array list.
+ * \param[in] list List to sort.
+ * \param[in] keyOffset Offset of the key in each object in bytes.
+ * \param[in] keyWidth Size of the key in bytes, 1, 2, 4 or 8.
+ * \param[in] keyType Type of the key.
+ * \return True if the list was sorted, false if the scratch buffer could not 
+ * be allocated in which case the list is left unchanged.
+ */
+AlfBool alfArrayListRadixSort(
+	AlfArrayList* list,
+	uint32_t keyOffset,
+	uint32_t keyWidth,
+	AlfArrayListKeyType keyType);
+
+// ========================================================================== //
+// ArrayList Sorted Functions
+// ========================================================================== //
+
+/** Returns the index of the first object in a sorted array list that is not 
+ * ordered before an object. The search is a binary search without branches on
+ * the result of each comparison, which the processor would fail to predict.
+ * \brief Find lower bound in sorted array list.
+ * \param[in] list List sorted by the comparison function.
+ * \param[in] object Object to search for.
+ * \param[in] compareFunction Function to compare objects with.
+ * \return Index of the first object that is not less than the object, or the
+ * size of the list if there is none.
+ */
+uint64_t alfArrayListLowerBound(
+	const AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the index of the first object in a sorted array list that is 
+ * ordered after an object. Like alfArrayListLowerBound the search is 
+ * branchless.
+ * \brief Find upper bound in sorted array list.
+ * \param[in] list List sorted by the comparison function.
+ * \param[in] object Object to search for.
+ * \param[in] compareFunction Function to compare objects with.
+ * \return Index of the first object that is greater than the object, or the
+ * size of the list if there is none.
+ */
+uint64_t alfArrayListUpperBound(
+	const AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction);
+
+// -------------------------------------------------------------------------- //
+
+/** Search for an object in a sorted array list with a branchless binary 
+ * search.
+ * \brief Binary search sorted array list.
+ * \param[in] list List sorted by the comparison function.
+ * \param[in] object Object to search for.
+ * \param[in] compareFunction Function to compare objects with.
+ * \param[out] indexOut Set to the index of the first object that is equal to
+ * the object if found, otherwise to the index that the object would be 
+ * inserted at. May be NULL.
+ * \return True if an equal object was found, otherwise false.
+ */
+AlfBool alfArrayListBinarySearch(
+	const AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction,
+	uint64_t* indexOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert an object into a sorted array list so that the list stays sorted. 
+ * The object is inserted after any objects that are equal to it.
+ * \brief Insert object into sorted array list.
+ * \param[in] list List sorted by the comparison function.
+ * \param[in] object Object to insert.
+ * \param[in] compareFunction Function to compare objects with.
+ * \return Index that the object was inserted at.
+ */
+uint64_t alfArrayListInsertSorted(
+	AlfArrayList* list,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction);
+
+// -------------------------------------------------------------------------- //
+
+/** Merge a number of sorted array lists and append the result to an array 
+ * list. The next object of each list is kept in a binary heap, so merging N 
+ * objects from K lists takes O(N log K) time. Equal objects are appended in 
+ * the order of the lists they come from, which makes the merge stable. The 
+ * merged lists are left unchanged.
+ * \brief Merge sorted array lists.
+ * \param[in] list List to append the merged objects to. Must not be one of 
+ * the merged lists.
+ * \param[in] lists Lists to merge, each sorted by the comparison function and
+ * with the same object size as the list that is appended to.
+ * \param[in] listCount Number of lists to merge.
+ * \param[in] compareFunction Function to compare objects with.
+ * \return True if the lists were merged, false if memory could not be 
+ * allocated in which case the list is left unchanged.
+ */
+AlfBool alfArrayListMergeSorted(
+	AlfArrayList* list,
+	const AlfArrayList* const* lists,
+	uint32_t listCount,
+	PFN_AlfCollectionCompare compareFunction);
+
+// ========================================================================== //
+// ArrayList Parallel Functions
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Sort an array list using multiple threads. The list is divided into one run
+ * per thread, which are sorted in parallel with the same algorithm as 
+ * alfArrayListSort. The runs are then merged pairwise into a scratch buffer of
+ * the same size as the list buffer, with each merge divided between threads, 
+ * until a single run remains. Lists that are too small to divide are sorted 
+ * on the calling thread, as are lists for which the scratch buffer could not 
+ * be allocated.
+ * \note This is only available when ALF_COLLECTION_USE_THREAD is defined. The
+ * comparison function is called from multiple threads at the same time.
+ * \note alfThreadStartup must have been called before this function is used.
+ * \brief Sort array list using multiple threads.
+ * \param[in] list List to sort.
+ * \param[in] compareFunction Function to compare objects with.
+ * \param[in] threadCount Number of threads to use, or zero to use one thread 
+ * per hardware thread.
+ */
+void alfArrayListSortParallel(
+	AlfArrayList* list,
+	PFN_AlfCollectionCompare compareFunction,
+	uint32_t threadCount);
+
+// -------------------------------------------------------------------------- //
+
+/** Sort an array list using multiple threads, keeping objects that compare 
+ * equal in their original order. This works like alfArrayListSortParallel, 
+ * except that the runs are sorted with a stable merge sort. Small lists are 
+ * merge sorted on the calling thread.
+ * \note This is only available when ALF_COLLECTION_USE_THREAD is defined. The
+ * comparison function is called from multiple threads at the same time.
+ * \note alfThreadStartup must have been called before this function is used.
+ * \brief Stable sort array list using multiple threads.
+ * \param[in] list List to sort.
+ * \param[in] compareFunction Function to compare objects with.
+ * \param[in] threadCount Number of threads to use, or zero to use one thread 
+ * per hardware thread.
+ * \return True if the list was sorted, false if the scratch buffer could not
+ * be allocated in which case the list is left unchanged.
+ */
+AlfBool alfArrayListSortParallelStable(
+	AlfArrayList* list,
+	PFN_AlfCollectionCompare compareFunction,
+	uint32_t threadCount);
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// EytzingerArray Structures
+// ========================================================================== //
+
+/** \struct AlfEytzingerArray
+ * \author Filip Björklund
+ * \date 17 oktober 2026 - 11:20
+ * \brief Eytzinger array.
+ * \details
+ * Structure that represents an immutable copy of a sorted array list, with the
+ * objects stored in the breadth-first order of a binary search tree (the
+ * Eytzinger layout). The first levels of the tree are next to each other in
+ * memory and stay in cache. The objects that a search may visit a few levels 
+ * further down share a cache line, so they can be prefetched before they are 
+ * needed. For large lists this makes a search faster than a binary search of 
+ * the sorted list.
+ * 
+ * Searches return indices in the sorted list that the array was created 
+ * from. The array does not follow later changes to the list.
+ */
+typedef struct tag_AlfEytzingerArray AlfEytzingerArray;
+
+// ========================================================================== //
+// EytzingerArray Functions
+// ========================================================================== //
+
+/** Create an Eytzinger array from a sorted array list. The objects are copied,
+ * so the list can be changed or destroyed afterwards. The array is allocated 
+ * with the allocator of the list.
+ * \brief Create Eytzinger array.
+ * \param[in] list List to create array from. The list must be sorted.
+ * \return Created array or NULL on failure.
+ */
+AlfEytzingerArray* alfCreateEytzingerArray(const AlfArrayList* list);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy an Eytzinger array. The objects are not cleaned, since they are 
+ * copies of the objects in the list.
+ * \brief Destroy Eytzinger array.
+ * \param[in] array Array to destroy.
+ */
+void alfDestroyEytzingerArray(AlfEytzingerArray* array);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the index in the sorted list of the first object that is not 
+ * ordered before an object.
+ * \brief Find lower bound in Eytzinger array.
+ * \param[in] array Array to search.
+ * \param[in] object Object to search for.
+ * \param[in] compareFunction Function to compare objects with. Must be the 
+ * function that the list was sorted with.
+ * \return Index of the first object that is not less than the object, or the
+ * size of the array if there is none.
+ */
+uint64_t alfEytzingerArrayLowerBound(
+	const AlfEytzingerArray* array,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction);
+
+// -------------------------------------------------------------------------- //
+
+/** Search for an object in an Eytzinger array.
+ * \brief Search Eytzinger array.
+ * \param[in] array Array to search.
+ * \param[in] object Object to search for.
+ * \param[in] compareFunction Function to compare objects with. Must be the 
+ * function that the list was sorted with.
+ * \param[out] indexOut Set to the index in the sorted list of the first object
+ * that is equal to the object if found. May be NULL.
+ * \return True if an equal object was found, otherwise false.
+ */
+AlfBool alfEytzingerArrayFind(
+	const AlfEytzingerArray* array,
+	const void* object,
+	PFN_AlfCollectionCompare compareFunction,
+	uint64_t* indexOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of objects in an Eytzinger array.
+ * \brief Returns size of Eytzinger array.
+ * \param[in] array Array to get size of.
+ * \return Number of objects.
+ */
+uint64_t alfEytzingerArrayGetSize(const AlfEytzingerArray* array);
+
 // ========================================================================== //
 // Stack Structures
 // ========================================================================== //
@@ -608,6 +1293,8 @@ typedef struct AlfStackDesc
 	uint32_t objectSize;
 	/** Object cleaner **/
 	PFN_AlfCollectionCleaner objectCleaner;
+	/** Allocator, or NULL for the default allocation functions **/
+	const AlfAllocator* allocator;
 } AlfStackDesc;
 
 // -------------------------------------------------------------------------- //
@@ -685,52 +1372,415 @@ AlfBool alfStackResize(AlfStack* stack, uint32_t size);
 uint32_t alfStackGetSize(AlfStack* stack);
 
 // ========================================================================== //
-// HashTable Forward Declarations
+// Hash Functions
 // ========================================================================== //
 
-typedef struct tag_AlfHashTable AlfHashTable;
+/** Compute a 64-bit hash of a block of memory. The memory is processed 16 
+ * bytes at a time, or 48 bytes at a time for large blocks, with 128-bit 
+ * multiplications. Different seeds give unrelated hashes, which can be used to
+ * stop an attacker from choosing keys that collide.
+ * \brief Compute hash of memory.
+ * \param[in] data Data to hash.
+ * \param[in] size Size of data in bytes.
+ * \param[in] seed Seed.
+ * \return Hash.
+ */
+uint64_t alfHash64(const void* data, uint64_t size, uint64_t seed);
 
-// ========================================================================== //
-// HashTable Callback Types
-// ========================================================================== //
+// -------------------------------------------------------------------------- //
 
-/** Prototype for a function that is used as a callback during hash table 
- * iteration.
- * \param table Hash table that is being iterated
- * \param index Index, in iteration, of key-value pair. This does NOT correspond
- * to any real index in the actual table implementation.
- * \param key Key.
- * \param value Value corresponding to key.
- * \return True should be returned to continue iteration. If false is returned
- * then the iteration stops and the iterate function in turn also returns false.
+/** Compute a 32-bit hash of a block of memory. This is the 64-bit hash folded
+ * to 32 bits.
+ * \brief Compute 32-bit hash of memory.
+ * \param[in] data Data to hash.
+ * \param[in] size Size of data in bytes.
+ * \param[in] seed Seed.
+ * \return Hash.
  */
-typedef AlfBool(*PFN_AlfHashTableIterate)(
-	AlfHashTable* table,
-	uint32_t index,
-	const void* key, 
-	void* value);
+uint32_t alfHash32(const void* data, uint64_t size, uint64_t seed);
+
+// -------------------------------------------------------------------------- //
+
+/** Compute the 64-bit hash of a null-terminated string. This can be used as a
+ * 64-bit hash function for a collection.
+ * \brief Compute hash of string.
+ * \param[in] string String to hash.
+ * \return Hash.
+ */
+uint64_t alfHashString64(const void* string);
+
+// -------------------------------------------------------------------------- //
+
+/** Compute the 32-bit hash of a null-terminated string. This can be used as a
+ * hash function for a collection.
+ * \brief Compute 32-bit hash of string.
+ * \param[in] string String to hash.
+ * \return Hash.
+ */
+uint32_t alfHashString(const void* string);
 
 // ========================================================================== //
-// HashTable Structures
+// Filter Enumerations
 // ========================================================================== //
 
-/** \struct AlfHashTableDesc
- * \author Filip Bj�rklund
- * \date 09 januari 2019 - 17:43
- * \brief Hash table descriptor.
+/** \enum AlfFilterType
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 23:20
+ * \brief Filter type.
  * \details
- * Structure that represents a descriptor for hash table creation.
+ * Enumeration of the kinds of filters that can be created.
  */
-typedef struct AlfHashTableDesc
+typedef enum AlfFilterType
 {
-	/** Initial bucket count **/
-	uint32_t bucketCount;
+	/** Bloom filter where all bits of a key are in a single 64-byte block, so a
+	 * query reads one cache line. Keys cannot be removed. This is the default
+	 * type **/
+	ALF_FILTER_TYPE_BLOCKED_BLOOM = 0,
+	/** Cuckoo filter that stores a 16-bit fingerprint of each key in one of two
+	 * buckets of four fingerprints. A query reads at most two buckets, and keys
+	 * can be removed **/
+	ALF_FILTER_TYPE_CUCKOO
+} AlfFilterType;
 
-	/** Size of value object in bytes **/
-	uint32_t valueSize;
+// ========================================================================== //
+// Filter Structures
+// ========================================================================== //
 
-	/** Hash function  **/
+/** \struct AlfFilterDesc
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 23:20
+ * \brief Filter descriptor.
+ * \details
+ * Structure that represents a descriptor for filter creation. Keys are hashed
+ * the same way as by a hash table with the same hash settings, so a hash from
+ * alfFilterGetKeyHash can be used for both.
+ */
+typedef struct AlfFilterDesc
+{
+	/** Type of filter **/
+	AlfFilterType type;
+	/** Number of keys that the filter is sized for **/
+	uint64_t capacity;
+	/** Bits per key of a blocked Bloom filter, or zero for the default of 12 
+	 * which gives about 0.5% false positives at capacity. Not used by cuckoo
+	 * filters, which have about 0.01% false positives **/
+	uint32_t bitsPerKey;
+
+	/** Size of keys in bytes, or zero for null-terminated string keys. Only
+	 * used when no hash function is set **/
+	uint32_t keySize;
+	/** Hash function **/
 	PFN_AlfCollectionHash hashFunction;
+	/** 64-bit hash function. Used instead of the hash function if set **/
+	PFN_AlfCollectionHash64 hashFunction64;
+	/** Seed of the built-in hash, used when no hash function is set **/
+	uint64_t hashSeed;
+
+	/** Allocator, or NULL for the default allocation functions **/
+	const AlfAllocator* allocator;
+} AlfFilterDesc;
+
+// -------------------------------------------------------------------------- //
+
+/** \struct AlfFilter
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 23:20
+ * \brief Filter.
+ * \details
+ * Structure that represents an approximate set of keys, that answers whether a
+ * key may be in the set. A key that has been inserted is always reported, but
+ * a key that has not may also be reported with a small probability. This can
+ * reject most lookups of keys that are not in a much larger and slower data 
+ * structure, such as an index on disk.
+ * 
+ * Inserting more keys than the capacity raises the false positive rate of a 
+ * Bloom filter, while a cuckoo filter may become full and reject inserts.
+ */
+typedef struct tag_AlfFilter AlfFilter;
+
+// ========================================================================== //
+// Filter Functions
+// ========================================================================== //
+
+/** Create a filter from a descriptor.
+ * \brief Create filter.
+ * \param[in] desc Filter descriptor.
+ * \return Filter or NULL on failure.
+ */
+AlfFilter* alfCreateFilter(const AlfFilterDesc* desc);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a filter.
+ * \brief Destroy filter.
+ * \param[in] filter Filter to destroy.
+ */
+void alfDestroyFilter(AlfFilter* filter);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the hash of a key, as used by the functions of a filter that take
+ * hashes. The hash is never zero.
+ * \brief Returns hash of key.
+ * \param[in] filter Filter to hash key for.
+ * \param[in] key Key to hash.
+ * \return Hash.
+ */
+uint64_t alfFilterGetKeyHash(AlfFilter* filter, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a key into a filter. Inserting a key twice inserts it twice in a 
+ * cuckoo filter, where it must then also be removed twice.
+ * \brief Insert key into filter.
+ * \param[in] filter Filter to insert into.
+ * \param[in] key Key to insert.
+ * \return True if the key was inserted, or false if the filter is a cuckoo 
+ * filter that is full.
+ */
+AlfBool alfFilterInsert(AlfFilter* filter, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a key into a filter by its hash.
+ * \brief Insert hash into filter.
+ * \param[in] filter Filter to insert into.
+ * \param[in] hash Hash of key to insert.
+ * \return True if the key was inserted, or false if the filter is a cuckoo 
+ * filter that is full.
+ */
+AlfBool alfFilterInsertHash(AlfFilter* filter, uint64_t hash);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a key may be in a filter. False positives are possible but
+ * false negatives are not.
+ * \brief Returns whether filter may contain key.
+ * \param[in] filter Filter to query.
+ * \param[in] key Key to query for.
+ * \return False if the key is definitely not in the filter, otherwise true.
+ */
+AlfBool alfFilterMayContain(AlfFilter* filter, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a key may be in a filter by its hash.
+ * \brief Returns whether filter may contain hash.
+ * \param[in] filter Filter to query.
+ * \param[in] hash Hash of key to query for.
+ * \return False if the key is definitely not in the filter, otherwise true.
+ */
+AlfBool alfFilterMayContainHash(AlfFilter* filter, uint64_t hash);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove a key from a filter. Only cuckoo filters support removal, and only 
+ * keys that have been inserted may be removed, as removing another key with
+ * the same fingerprint would make the filter miss an inserted key.
+ * \brief Remove key from filter.
+ * \param[in] filter Filter to remove from.
+ * \param[in] key Key to remove.
+ * \return True if the key was removed, otherwise false.
+ */
+AlfBool alfFilterRemove(AlfFilter* filter, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove a key from a filter by its hash.
+ * \brief Remove hash from filter.
+ * \param[in] filter Filter to remove from.
+ * \param[in] hash Hash of key to remove.
+ * \return True if the key was removed, otherwise false.
+ */
+AlfBool alfFilterRemoveHash(AlfFilter* filter, uint64_t hash);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove all keys from a filter.
+ * \brief Clear filter.
+ * \param[in] filter Filter to clear.
+ */
+void alfFilterClear(AlfFilter* filter);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of keys that have been inserted into a filter and not 
+ * removed.
+ * \brief Returns filter size.
+ * \param[in] filter Filter to get size of.
+ * \return Number of keys.
+ */
+uint64_t alfFilterGetSize(AlfFilter* filter);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of keys that a filter was sized for.
+ * \brief Returns filter capacity.
+ * \param[in] filter Filter to get capacity of.
+ * \return Capacity.
+ */
+uint64_t alfFilterGetCapacity(AlfFilter* filter);
+
+// ========================================================================== //
+// HashTable Forward Declarations
+// ========================================================================== //
+
+typedef struct tag_AlfHashTable AlfHashTable;
+
+// ========================================================================== //
+// HashTable Callback Types
+// ========================================================================== //
+
+/** Prototype for a function that is used as a callback during hash table 
+ * iteration.
+ * \param table Hash table that is being iterated
+ * \param index Index, in iteration, of key-value pair. This does NOT correspond
+ * to any real index in the actual table implementation.
+ * \param key Key.
+ * \param value Value corresponding to key.
+ * \return True should be returned to continue iteration. If false is returned
+ * then the iteration stops and the iterate function in turn also returns false.
+ */
+typedef AlfBool(*PFN_AlfHashTableIterate)(
+	AlfHashTable* table,
+	uint32_t index,
+	const void* key, 
+	void* value);
+
+// -------------------------------------------------------------------------- //
+
+/** Prototype for a function that is used to combine the values of a key that
+ * is in both hash tables of a merge.
+ * \param value Value in the destination table, to update in place.
+ * \param otherValue Value in the source table.
+ */
+typedef void(*PFN_AlfHashTableCombine)(void* value, const void* otherValue);
+
+// ========================================================================== //
+// HashTable Enumerations
+// ========================================================================== //
+
+/** \enum AlfHashTableLayout
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 15:40
+ * \brief Hash table memory layout.
+ * \details
+ * Enumeration of the memory layouts that a hash table can use. The layout
+ * decides how the table probes for keys, while the keys and values are always
+ * stored in the bucket array.
+ */
+typedef enum AlfHashTableLayout
+{
+	/** Robin-hood hashing where each probe reads the cached hash stored in the
+	 * bucket itself. This is the default layout **/
+	ALF_HASH_TABLE_LAYOUT_ROBIN_HOOD = 0,
+	/** A separate array of 1-byte control tags, holding 7 bits of the hash for
+	 * each bucket, is probed 16 buckets at a time. A bucket is only read when
+	 * its tag matches. This favors tables where most lookups are misses **/
+	ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES
+} AlfHashTableLayout;
+
+// -------------------------------------------------------------------------- //
+
+/** \enum AlfHashTableKeyStorage
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 17:40
+ * \brief Hash table key storage.
+ * \details
+ * Enumeration of the ways that a hash table can store keys that are not stored
+ * inline in the buckets.
+ */
+typedef enum AlfHashTableKeyStorage
+{
+	/** Each key is copied with the key copy function and destroyed with the 
+	 * key destructor. This is the default storage **/
+	ALF_HASH_TABLE_KEY_STORAGE_COPY = 0,
+	/** Keys are null-terminated strings that are copied, together with their
+	 * length, into large chunks of memory owned by the table. The chunks are
+	 * compacted when enough keys have been removed, which moves the keys **/
+	ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA
+} AlfHashTableKeyStorage;
+
+// -------------------------------------------------------------------------- //
+
+/** \enum AlfHashTablePages
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 22:45
+ * \brief Hash table pages.
+ * \details
+ * Enumeration of the kinds of memory pages that a hash table can place its 
+ * bucket array and control bytes on.
+ */
+typedef enum AlfHashTablePages
+{
+	/** Arrays are allocated with ALF_COLLECTION_ALLOC. This is the default **/
+	ALF_HASH_TABLE_PAGES_DEFAULT = 0,
+	/** Arrays of at least 2 MB are mapped directly on huge pages, so that a 
+	 * probe of a very large table does not miss the TLB on every bucket. 
+	 * Explicit huge pages (MAP_HUGETLB or MEM_LARGE_PAGES) are used if the
+	 * system has them reserved, otherwise ordinary pages are mapped and, where
+	 * supported, advised to be backed by transparent huge pages **/
+	ALF_HASH_TABLE_PAGES_HUGE
+} AlfHashTablePages;
+
+// ========================================================================== //
+// HashTable Structures
+// ========================================================================== //
+
+/** \struct AlfHashTableDesc
+ * \author Filip Bj�rklund
+ * \date 09 januari 2019 - 17:43
+ * \brief Hash table descriptor.
+ * \details
+ * Structure that represents a descriptor for hash table creation.
+ *
+ * The layout may be left zero-initialized to use robin-hood hashing. Tables
+ * that use the control byte layout always have at least 16 buckets.
+ * 
+ * If the key size is zero then keys are stored by pointer. Each inserted key
+ * is then copied with the key copy function and later destroyed with the key
+ * destructor. Otherwise keys are fixed-size objects, such as integers or 
+ * UUIDs, that are stored by value inside the buckets. The copy function and 
+ * destructor are then not used, and the hash function and equality function 
+ * may be left NULL to hash and compare the bytes of the keys.
+ * 
+ * Keys that are stored by pointer may instead be stored in a string arena that
+ * is owned by the table, in which case the copy function and destructor are
+ * also not used.
+ * 
+ * Tables with billions of entries may place their buckets on huge pages, see
+ * AlfHashTablePages. Bucket and entry counts are 64-bit.
+ * 
+ * The table stores a 64-bit hash of each key, whose high bits are used as a
+ * fingerprint. The hash is taken from the 64-bit hash function if set, or 
+ * else from the 32-bit hash function. If neither is set then inline keys and
+ * string arena keys are hashed with alfHash64 and the hash seed. A random seed
+ * makes the table resistant to keys that are chosen to collide.
+ */
+typedef struct AlfHashTableDesc
+{
+	/** Initial bucket count **/
+	uint64_t bucketCount;
+
+	/** Size of value object in bytes **/
+	uint32_t valueSize;
+	/** Size of key in bytes for keys stored inline, or zero for keys that are
+	 * stored by pointer **/
+	uint32_t keySize;
+
+	/** Memory layout of the table **/
+	AlfHashTableLayout layout;
+	/** Storage of keys that are not stored inline **/
+	AlfHashTableKeyStorage keyStorage;
+	/** Pages that large bucket arrays are placed on **/
+	AlfHashTablePages pages;
+
+	/** Hash function  **/
+	PFN_AlfCollectionHash hashFunction;
+	/** 64-bit hash function. Used instead of the hash function if set **/
+	PFN_AlfCollectionHash64 hashFunction64;
+	/** Seed of the built-in hash, used when no hash function is set **/
+	uint64_t hashSeed;
 	/** Key equality function **/
 	PFN_AlfCollectionEqual keyEqual;
 	/** Key copy function **/
@@ -739,10 +1789,64 @@ typedef struct AlfHashTableDesc
 	PFN_AlfCollectionDestructor keyDestructor;
 	/** Value cleaner **/
 	PFN_AlfCollectionCleaner valueCleaner;
+
+	/** Allocator of the table, its buckets and its string arena, or NULL for
+	 * the default allocation functions. Keys that are copied by the key copy 
+	 * function and buckets on huge pages are not allocated with it **/
+	const AlfAllocator* allocator;
 } AlfHashTableDesc;
 
 // -------------------------------------------------------------------------- //
 
+/** Number of entries in the probe length histograms of hash table statistics.
+ * The last entry counts all probes of that length or longer **/
+#define ALF_HASH_TABLE_STATISTICS_PROBE_LENGTHS 16
+
+// -------------------------------------------------------------------------- //
+
+/** \struct AlfHashTableStatistics
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 19:05
+ * \brief Hash table statistics.
+ * \details
+ * Structure that represents statistics of a hash table, for finding hash
+ * functions and load factor settings that make the table slow.
+ *
+ * The probe length of a lookup is the number of buckets that are examined
+ * after the first one, or the number of groups for the control byte layout.
+ * Lookups, removals and alfHashTableFindOrInsert are recorded. The histograms
+ * and the resize counters are only gathered when the library is compiled with
+ * ALF_COLLECTION_STATISTICS defined, otherwise they are zero and the table does
+ * no extra work. The remaining statistics are computed from the buckets when
+ * they are retrieved.
+ */
+typedef struct AlfHashTableStatistics
+{
+	/** Number of lookups that found their key, by probe length **/
+	uint64_t hitProbeLengths[ALF_HASH_TABLE_STATISTICS_PROBE_LENGTHS];
+	/** Number of lookups that did not find their key, by probe length **/
+	uint64_t missProbeLengths[ALF_HASH_TABLE_STATISTICS_PROBE_LENGTHS];
+	/** Number of resizes, including rehashes at the same size **/
+	uint64_t resizeCount;
+	/** Time spent resizing and migrating buckets, in nanoseconds **/
+	uint64_t resizeNanoseconds;
+
+	/** Number of entries **/
+	uint64_t size;
+	/** Number of buckets, including old buckets of an incremental resize **/
+	uint64_t bucketCount;
+	/** Longest probe length of any entry **/
+	uint64_t maxDisplacement;
+	/** Number of deleted control bytes. Always zero for robin-hood tables,
+	 * which do not leave tombstones behind **/
+	uint64_t tombstoneCount;
+	/** Bytes allocated by the table for buckets, control bytes and keys in
+	 * the string arena. Keys copied by a key copy function are not included **/
+	uint64_t allocatedBytes;
+} AlfHashTableStatistics;
+
+// -------------------------------------------------------------------------- //
+
 /** \struct AlfHashTable
  * \author Filip Bj�rklund
  * \date 09 januari 2019 - 17:42
@@ -774,7 +1878,9 @@ AlfHashTable* alfCreateHashTable(const AlfHashTableDesc* desc);
 // -------------------------------------------------------------------------- //
 
 /** Create a hash table for use with string keys. This is supported for the 
- * reason that string keys are one of the most common.
+ * reason that string keys are one of the most common. The keys are stored in a
+ * string arena, therefore key pointers that are passed to an iteration callback
+ * are only valid until the next removal from the table.
  * \brief Create hash table for string keys.
  * \param[in] valueSize Size of values in bytes.
  * \param[in] valueCleaner Cleaner for values in table.
@@ -821,6 +1927,44 @@ void* alfHashTableGet(AlfHashTable* table, const void* key);
 
 // -------------------------------------------------------------------------- //
 
+/** Lookup the values of multiple keys at once. All keys are hashed and their
+ * buckets are prefetched before any of them are probed, which lets the memory
+ * accesses of different keys overlap. This is faster than calling 
+ * alfHashTableGet for each key when the table does not fit in cache.
+ * \brief Returns values for multiple keys from hash table.
+ * \param[in] table Hash table to get values from.
+ * \param[in] keys Keys to lookup values with.
+ * \param[in] count Number of keys.
+ * \param[out] valuesOut Array of 'count' pointers that is set to the value of
+ * each key, or NULL for keys that were not found.
+ * \return Number of keys that were found.
+ */
+uint32_t alfHashTableGetBatch(
+	AlfHashTable* table,
+	const void* const* keys,
+	uint32_t count,
+	void** valuesOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value that corresponds to a key, inserting the key with a 
+ * zero-initialized value if the table does not contain it. The key is only 
+ * probed for once, and the returned value can be updated in place. This is 
+ * useful for counting and aggregation.
+ * \note The returned pointer is only valid until the table is modified.
+ * \brief Find or insert value in hash table.
+ * \param[in] table Hash table to find or insert value in.
+ * \param[in] key Key to lookup value with.
+ * \param[out] insertedOut Set to whether the key was inserted. May be NULL.
+ * \return Value for the key or NULL if insertion failed.
+ */
+void* alfHashTableFindOrInsert(
+	AlfHashTable* table,
+	const void* key,
+	AlfBool* insertedOut);
+
+// -------------------------------------------------------------------------- //
+
 /** Remove a value that is stored with a specified key from a hash table.
  * \brief Remove value from hash table.
  * \param[in] table Hash table to remove value from.
@@ -847,7 +1991,8 @@ AlfBool alfHasKey(AlfHashTable* table, const void* key);
 
 // -------------------------------------------------------------------------- //
 	
-/** Resize a hash table to the specified size. 
+/** Resize a hash table to the specified size. If the new buckets cannot be 
+ * allocated then the table keeps its current buckets.
  * \note This will move all values from the old table, which can be a costly 
  * operation. Therefore call this as infrequently as possible, or make a large
  * upfront resize.
@@ -856,7 +2001,7 @@ AlfBool alfHasKey(AlfHashTable* table, const void* key);
  * \param[in] table Hash table to resize.
  * \param[in] size Size to resize to. Must be a power of two.
  */
-void alfHashTableResize(AlfHashTable* table, uint32_t size);
+void alfHashTableResize(AlfHashTable* table, uint64_t size);
 
 // -------------------------------------------------------------------------- //
 
@@ -874,6 +2019,29 @@ AlfBool alfHashTableIterate(
 
 // -------------------------------------------------------------------------- //
 
+/** Merge the entries of a source hash table into a destination table. The 
+ * cached hashes of the source buckets are reused, so no key is hashed again.
+ * Keys that are only in the source are copied to the destination, while the 
+ * values of keys that are in both are combined with the combine function. 
+ * This is useful for merging tables that were filled by different threads.
+ * \note Both tables must have the same key size, value size and hash function,
+ * including the hash seed. The source table is not modified.
+ * \note Values are copied as raw bytes, so values that own memory must not be
+ * cleaned by both tables.
+ * \brief Merge hash tables.
+ * \param[in] destination Hash table to merge into.
+ * \param[in] source Hash table to merge from.
+ * \param[in] combine Function that combines the values of keys that are in 
+ * both tables. NULL to replace the destination values with the source values.
+ * \return True if all entries were merged, otherwise false.
+ */
+AlfBool alfHashTableMerge(
+	AlfHashTable* destination,
+	AlfHashTable* source,
+	PFN_AlfHashTableCombine combine);
+
+// -------------------------------------------------------------------------- //
+
 /** Set the maximum load factor of a hash table. This value determines how 
  * filled the hash table will become before it's automatically resized. A value
  * of 1.0 means filled. Insertion an item into a fill table will always result 
@@ -886,6 +2054,81 @@ void alfHashTableSetMaxLoadFactor(AlfHashTable* table, float loadFactor);
 
 // -------------------------------------------------------------------------- //
 
+/** Set the minimum load factor of a hash table. When automatic shrinking is
+ * enabled the table is resized to half its bucket count when a removal leaves
+ * it less filled than this value. The value should be well below half of the
+ * maximum load factor, otherwise the table will grow again soon after.
+ * \brief Set minimum load factor of hash table.
+ * \param[in] table Hash table to set minimum load factor of.
+ * \param[in] loadFactor Load factor to set.
+ */
+void alfHashTableSetMinLoadFactor(AlfHashTable* table, float loadFactor);
+
+// -------------------------------------------------------------------------- //
+
+/** Set whether a hash table automatically shrinks when its load factor falls
+ * below the minimum load factor. A table never shrinks below the bucket count
+ * that it was created with. Automatic shrinking is disabled by default.
+ * \brief Set whether hash table shrinks automatically.
+ * \param[in] table Hash table to set automatic shrinking for.
+ * \param[in] enabled True to enable automatic shrinking.
+ */
+void alfHashTableSetAutomaticShrink(AlfHashTable* table, AlfBool enabled);
+
+// -------------------------------------------------------------------------- //
+
+/** Set whether a hash table resizes incrementally. When enabled, a resize keeps
+ * the old buckets next to the new ones, and each insertion and removal moves at
+ * most 'bucketsPerStep' old buckets. This bounds the time spent in any single 
+ * operation, while lookups search both bucket arrays until the resize is done.
+ * Allocating and clearing the new buckets is still done in a single operation.
+ * Shrinking, and rehashing to clear deleted control bytes, wait until the
+ * resize in progress has completed.
+ * \note Lookups never move buckets, so they remain safe to perform without
+ * exclusive access to the table.
+ * \note Explicit calls to alfHashTableResize always complete immediately.
+ * \brief Set incremental resizing of hash table.
+ * \param[in] table Hash table to set incremental resizing for.
+ * \param[in] bucketsPerStep Number of old buckets to move per operation. Zero
+ * disables incremental resizing and completes any resize in progress. Values 
+ * below 2 are raised to 2 so that a resize completes before the new buckets 
+ * fill up.
+ */
+void alfHashTableSetIncrementalResize(
+	AlfHashTable* table, 
+	uint32_t bucketsPerStep);
+
+// -------------------------------------------------------------------------- //
+
+/** Enable a filter of the keys in a hash table, that lets lookups of keys that
+ * are not in the table return after reading a single cache line of the filter
+ * instead of probing the buckets. This pays off for tables that are large and
+ * where most lookups miss. Any filter that is already enabled is replaced.
+ * 
+ * The filter is sized for the bucket count and is rebuilt with twice the 
+ * capacity when the table outgrows it. A Bloom filter cannot remove keys, so
+ * it is instead rebuilt when removed keys outnumber the keys in the table.
+ * A cuckoo filter only holds a few entries with the same hash. If the table
+ * has more than that, the filter is disabled instead of growing without end.
+ * \note Rebuilding the filter visits every bucket, also when the table resizes
+ * incrementally.
+ * \brief Enable filter of hash table.
+ * \param[in] table Hash table to enable filter for.
+ * \param[in] type Type of filter.
+ * \return True if the filter was enabled, otherwise false.
+ */
+AlfBool alfHashTableEnableFilter(AlfHashTable* table, AlfFilterType type);
+
+// -------------------------------------------------------------------------- //
+
+/** Disable the filter of a hash table, if any.
+ * \brief Disable filter of hash table.
+ * \param[in] table Hash table to disable filter for.
+ */
+void alfHashTableDisableFilter(AlfHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
 /** Returns the current load factor of a hash table. This represents how filled
  * the hash table is. 
  * \brief Returns hash table load factor.
@@ -904,6 +2147,1098 @@ float alfHashTableGetLoadFactor(AlfHashTable* table);
  */
 uint64_t alfHashTableGetSize(AlfHashTable* table);
 
+// -------------------------------------------------------------------------- //
+
+/** Retrieve the statistics of a hash table. The probe length histograms and
+ * resize counters are accumulated since the table was created or the
+ * statistics were last reset.
+ * \note Lookups update the counters without synchronization, so counts may be
+ * lost when lookups run concurrently.
+ * \brief Retrieve hash table statistics.
+ * \param[in] table Hash table to retrieve statistics of.
+ * \param[out] statisticsOut Statistics.
+ * \return True if the library gathers counters, otherwise false, in which case
+ * the histograms and resize counters are zero.
+ */
+AlfBool alfHashTableGetStatistics(
+	AlfHashTable* table,
+	AlfHashTableStatistics* statisticsOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Reset the probe length histograms and resize counters of a hash table.
+ * \brief Reset hash table statistics.
+ * \param[in] table Hash table to reset statistics of.
+ */
+void alfHashTableResetStatistics(AlfHashTable* table);
+
+// ========================================================================== //
+// HashTable Snapshot Functions
+// ========================================================================== //
+
+/** Save a snapshot of a hash table to a file. The bucket array is written as 
+ * is, while keys that are not inline are written to a separate section of the
+ * file and referenced by offset. The file can then be mapped back into memory
+ * with alfHashTableMap without rebuilding the table.
+ * \note Keys that are not inline are saved as null-terminated strings. Values
+ * are saved as raw bytes, so they must not contain pointers.
+ * \note The file uses the byte order and alignment of the platform that saved
+ * it, and can only be mapped on a matching platform.
+ * \brief Save hash table snapshot.
+ * \param[in] table Hash table to save. Any incremental resize in progress is
+ * completed first.
+ * \param[in] path Path of file to write.
+ * \return True if the snapshot was saved, otherwise false.
+ */
+AlfBool alfHashTableSave(AlfHashTable* table, const char* path);
+
+// -------------------------------------------------------------------------- //
+
+/** Map a hash table snapshot, that was saved with alfHashTableSave, into 
+ * memory. The file is not read or parsed, so mapping is immediate and pages 
+ * are loaded by the operating system as lookups touch them. The returned table
+ * is read-only, it must not be inserted into, removed from or resized. It is
+ * destroyed with alfDestroyHashTable, which unmaps the file.
+ * \note The descriptor only supplies the hash and key equality functions, and
+ * the key and value sizes that the snapshot is checked against. The functions
+ * must be the same as those of the saved table. The hash seed, bucket count
+ * and layout are read from the snapshot.
+ * \note The header is checked to describe sections that lie within the file.
+ * For keys that are not inline, the key offset of every occupied bucket is also
+ * checked once when mapping, which reads the whole bucket array. Values and
+ * hashes are not checked.
+ * \brief Map hash table snapshot.
+ * \param[in] path Path of snapshot file.
+ * \param[in] desc Descriptor of the saved table. NULL for a table with string 
+ * keys and the built-in hash, such as tables that are created with 
+ * alfCreateHashTableSimple.
+ * \return Mapped hash table or NULL if the file could not be mapped or does not
+ * match the descriptor.
+ */
+AlfHashTable* alfHashTableMap(const char* path, const AlfHashTableDesc* desc);
+
+// ========================================================================== //
+// FrozenHashTable Structures
+// ========================================================================== //
+
+/** \struct AlfFrozenHashTable
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 18:20
+ * \brief Frozen hash table.
+ * \details
+ * Structure that represents an immutable hash table that is created by 
+ * freezing a regular hash table. The entries are placed with a minimal perfect
+ * hash, so there is exactly one slot for each entry and a lookup reads a 
+ * single slot and compares a single key. The only exception is keys whose 
+ * 64-bit hashes collide, which are kept in a small overflow array.
+ * 
+ * Freezing is more expensive than building the table, therefore this is meant
+ * for data that is built once and then read many times. Tables with 2^31 or
+ * more entries cannot be frozen.
+ */
+typedef struct tag_AlfFrozenHashTable AlfFrozenHashTable;
+
+// ========================================================================== //
+// FrozenHashTable Functions
+// ========================================================================== //
+
+/** Freeze a hash table into an immutable frozen hash table. On success the 
+ * entries are moved to the frozen table, which then owns them, and the hash 
+ * table is destroyed. On failure the hash table is left unchanged.
+ * \brief Freeze hash table.
+ * \param[in] table Hash table to freeze.
+ * \return Frozen hash table or NULL on failure.
+ */
+AlfFrozenHashTable* alfHashTableFreeze(AlfHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a frozen hash table and all the entries in it.
+ * \brief Destroy frozen hash table.
+ * \param[in] table Frozen hash table to destroy.
+ */
+void alfDestroyFrozenHashTable(AlfFrozenHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value in a frozen hash table that corresponds to a specified 
+ * key. If no value exists with the key then the function returns NULL.
+ * \brief Returns value from frozen hash table.
+ * \param[in] table Frozen hash table to get value from.
+ * \param[in] key Key to lookup value with.
+ * \return Value that was found for the key or NULL if the key was not found.
+ */
+void* alfFrozenHashTableGet(AlfFrozenHashTable* table, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether or not a frozen hash table contains a value stored with the
+ * specified key.
+ * \brief Returns whether frozen hash table contains key.
+ * \param[in] table Frozen hash table to check if contains key.
+ * \param[in] key Key to check if table contains.
+ * \return True if the table contains the specified key otherwise false.
+ */
+AlfBool alfFrozenHashTableHasKey(AlfFrozenHashTable* table, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of entries in a frozen hash table.
+ * \brief Returns size of frozen hash table.
+ * \param[in] table Frozen hash table to get size of.
+ * \return Size of table.
+ */
+uint64_t alfFrozenHashTableGetSize(AlfFrozenHashTable* table);
+
+// ========================================================================== //
+// HashTable Parallel Functions
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Resize a hash table using multiple threads. The new buckets are divided into
+ * contiguous regions by bucket index, and each thread places the entries whose
+ * probe sequence starts in its regions. Entries that do not fit in their region
+ * are inserted on the calling thread once all regions have been filled. If the
+ * new buckets cannot be allocated then the table keeps its current buckets.
+ * \note This is only available when ALF_COLLECTION_USE_THREAD is defined. The
+ * table must not be used by other threads during the resize.
+ * \note alfThreadStartup must have been called before this function is used.
+ * \brief Resize hash table using multiple threads.
+ * \param[in] table Hash table to resize.
+ * \param[in] size Size to resize to. Must be a power of two.
+ * \param[in] threadCount Number of threads to use, or zero to use one thread 
+ * per hardware thread. Tables that are too small to divide are resized on the
+ * calling thread.
+ */
+void alfHashTableResizeParallel(
+	AlfHashTable* table, 
+	uint64_t size, 
+	uint32_t threadCount);
+
+// -------------------------------------------------------------------------- //
+
+/** Build a hash table from arrays of keys and values using multiple threads. 
+ * The keys are hashed and copied in parallel, and the entries are then placed
+ * in a bucket array that is sized for all of them, in the same way as by
+ * alfHashTableResizeParallel. This is much faster than inserting the entries 
+ * one at a time when building very large tables.
+ * \note This is only available when ALF_COLLECTION_USE_THREAD is defined. Like
+ * alfHashTableInsert the keys are not checked for duplicates, so each key must
+ * be unique.
+ * \note alfThreadStartup must have been called before this function is used.
+ * \brief Build hash table using multiple threads.
+ * \param[in] desc Hash table descriptor.
+ * \param[in] keys Array of keys.
+ * \param[in] values Array of values, with the same length as the keys.
+ * \param[in] count Number of keys and values.
+ * \param[in] threadCount Number of threads to use, or zero to use one thread 
+ * per hardware thread.
+ * \return Built hash table or NULL on failure.
+ */
+AlfHashTable* alfHashTableBuildParallel(
+	const AlfHashTableDesc* desc,
+	const void* const* keys,
+	const void* const* values,
+	uint64_t count,
+	uint32_t threadCount);
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// PartitionedHashTable Structures
+// ========================================================================== //
+
+/** \struct AlfPartitionedHashTable
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 20:30
+ * \brief Partitioned hash table.
+ * \details
+ * Structure that represents a hash table whose entries are divided between a
+ * number of partitions by a mix of all bits of their hash. Each partition is a
+ * regular hash table.
+ * 
+ * Tables that are created with the same descriptor and partition count place
+ * each key in the same partition. Such tables can be merged one partition at a
+ * time, with the partitions merged independently on different threads. This
+ * makes it possible to aggregate into one table per thread and then combine 
+ * the tables in parallel.
+ */
+typedef struct tag_AlfPartitionedHashTable AlfPartitionedHashTable;
+
+// ========================================================================== //
+// PartitionedHashTable Functions
+// ========================================================================== //
+
+/** Create a partitioned hash table from a hash table descriptor. The initial
+ * bucket count of the descriptor is divided between the partitions.
+ * \brief Create partitioned hash table.
+ * \param[in] desc Hash table descriptor.
+ * \param[in] partitionCount Number of partitions. Must be a power of two no 
+ * larger than 65536, or zero to use the default of 64 partitions.
+ * \return Partitioned hash table or NULL on failure.
+ */
+AlfPartitionedHashTable* alfCreatePartitionedHashTable(
+	const AlfHashTableDesc* desc,
+	uint32_t partitionCount);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a partitioned hash table.
+ * \brief Destroy partitioned hash table.
+ * \param[in] table Partitioned hash table to destroy.
+ */
+void alfDestroyPartitionedHashTable(AlfPartitionedHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a value into a partitioned hash table. The key is hashed once and 
+ * the hash is reused by the partition.
+ * \brief Insert value into partitioned hash table.
+ * \param[in] table Partitioned hash table to insert into.
+ * \param[in] key Key to insert value for.
+ * \param[in] value Value to insert.
+ * \return True if the value was inserted, otherwise false.
+ */
+AlfBool alfPartitionedHashTableInsert(
+	AlfPartitionedHashTable* table,
+	const void* key,
+	const void* value);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value that corresponds to a key in a partitioned hash table.
+ * \brief Returns value for key in partitioned hash table.
+ * \param[in] table Partitioned hash table to get value from.
+ * \param[in] key Key to get value for.
+ * \return Value or NULL if the key was not found.
+ */
+void* alfPartitionedHashTableGet(
+	AlfPartitionedHashTable* table, 
+	const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value that corresponds to a key in a partitioned hash table, 
+ * inserting the key with a zero-initialized value if the table does not
+ * contain it. This works like alfHashTableFindOrInsert.
+ * \brief Find or insert value in partitioned hash table.
+ * \param[in] table Partitioned hash table to find or insert in.
+ * \param[in] key Key to find or insert.
+ * \param[out] insertedOut Set to whether the key was inserted. May be NULL.
+ * \return Value or NULL if the key could not be inserted.
+ */
+void* alfPartitionedHashTableFindOrInsert(
+	AlfPartitionedHashTable* table,
+	const void* key,
+	AlfBool* insertedOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove the value for a key from a partitioned hash table.
+ * \brief Remove value from partitioned hash table.
+ * \param[in] table Partitioned hash table to remove from.
+ * \param[in] key Key to remove value for.
+ * \param[out] valueOut Buffer that the removed value is copied to. May be NULL.
+ * \return True if the key was found and removed, otherwise false.
+ */
+AlfBool alfPartitionedHashTableRemove(
+	AlfPartitionedHashTable* table,
+	const void* key,
+	void* valueOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of entries in a partitioned hash table.
+ * \brief Returns size of partitioned hash table.
+ * \param[in] table Partitioned hash table to get size of.
+ * \return Size of table.
+ */
+uint64_t alfPartitionedHashTableGetSize(AlfPartitionedHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of partitions of a partitioned hash table.
+ * \brief Returns partition count of partitioned hash table.
+ * \param[in] table Partitioned hash table to get partition count of.
+ * \return Partition count.
+ */
+uint32_t alfPartitionedHashTableGetPartitionCount(
+	AlfPartitionedHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the hash table of a partition. The table may be iterated and read,
+ * but keys must only be inserted through the partitioned table so that they
+ * end up in the right partition.
+ * \brief Returns partition of partitioned hash table.
+ * \param[in] table Partitioned hash table to get partition of.
+ * \param[in] index Index of partition.
+ * \return Hash table of partition.
+ */
+AlfHashTable* alfPartitionedHashTableGetPartition(
+	AlfPartitionedHashTable* table,
+	uint32_t index);
+
+// -------------------------------------------------------------------------- //
+
+/** Merge the entries of a source partitioned hash table into a destination
+ * table, one partition at a time, with alfHashTableMerge.
+ * \note Both tables must have the same partition count, and partitions that
+ * meet the requirements of alfHashTableMerge.
+ * \brief Merge partitioned hash tables.
+ * \param[in] destination Partitioned hash table to merge into.
+ * \param[in] source Partitioned hash table to merge from.
+ * \param[in] combine Function that combines the values of keys that are in 
+ * both tables. NULL to replace the destination values with the source values.
+ * \return True if all entries were merged, otherwise false.
+ */
+AlfBool alfPartitionedHashTableMerge(
+	AlfPartitionedHashTable* destination,
+	AlfPartitionedHashTable* source,
+	PFN_AlfHashTableCombine combine);
+
+// -------------------------------------------------------------------------- //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** Merge the entries of a source partitioned hash table into a destination
+ * table using multiple threads. Each partition is merged by a single thread,
+ * so no locks are needed.
+ * \note This is only available when ALF_COLLECTION_USE_THREAD is defined. The
+ * combine function is called from multiple threads, but never for the same
+ * key at the same time.
+ * \note alfThreadStartup must have been called before this function is used.
+ * \brief Merge partitioned hash tables using multiple threads.
+ * \param[in] destination Partitioned hash table to merge into.
+ * \param[in] source Partitioned hash table to merge from.
+ * \param[in] combine Function that combines the values of keys that are in 
+ * both tables. NULL to replace the destination values with the source values.
+ * \param[in] threadCount Number of threads to use, or zero to use one thread 
+ * per hardware thread.
+ * \return True if all entries were merged, otherwise false.
+ */
+AlfBool alfPartitionedHashTableMergeParallel(
+	AlfPartitionedHashTable* destination,
+	AlfPartitionedHashTable* source,
+	PFN_AlfHashTableCombine combine,
+	uint32_t threadCount);
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// BoundedCache Structures
+// ========================================================================== //
+
+/** \struct AlfBoundedCache
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 21:15
+ * \brief Bounded cache.
+ * \details
+ * Structure that represents a cache with a fixed capacity. When an insert 
+ * would exceed the capacity, entries are evicted with the CLOCK policy, which
+ * approximates least-recently-used eviction in constant time.
+ * 
+ * The entries are stored in a regular hash table, and the reference bit and 
+ * weight of each entry are stored in front of its value in the bucket. The 
+ * clock hand sweeps the bucket array itself, so there is no separate list of 
+ * entries and a lookup only touches the bucket of the key. Eviction takes 
+ * constant time on average and allocates no memory.
+ * 
+ * Each entry has a weight that is counted against the capacity. Entries that
+ * are inserted with alfBoundedCacheInsert have a weight of one, so that the 
+ * capacity is a number of entries. Entries can also be inserted with a weight
+ * such as their size in bytes, so that the capacity is a number of bytes.
+ */
+typedef struct tag_AlfBoundedCache AlfBoundedCache;
+
+// -------------------------------------------------------------------------- //
+
+/** \struct AlfBoundedCacheStatistics
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 21:15
+ * \brief Bounded cache statistics.
+ * \details
+ * Structure that represents the counters of a bounded cache, which are kept
+ * since creation or since the counters were last reset.
+ */
+typedef struct AlfBoundedCacheStatistics
+{
+	/** Number of lookups that found the key **/
+	uint64_t hitCount;
+	/** Number of lookups that did not find the key **/
+	uint64_t missCount;
+	/** Number of entries that were inserted **/
+	uint64_t insertCount;
+	/** Number of entries that were evicted to make room for other entries **/
+	uint64_t evictionCount;
+	/** Number of entries in the cache **/
+	uint64_t size;
+	/** Sum of the weights of the entries in the cache **/
+	uint64_t weight;
+} AlfBoundedCacheStatistics;
+
+// ========================================================================== //
+// BoundedCache Functions
+// ========================================================================== //
+
+/** Create a bounded cache from a hash table descriptor. The value cleaner of 
+ * the descriptor is called for values that are evicted, replaced or still in
+ * the cache when it is destroyed.
+ * \note The bucket count of the descriptor should fit the expected number of
+ * entries, as the table otherwise grows while the cache fills up.
+ * \brief Create bounded cache.
+ * \param[in] desc Hash table descriptor.
+ * \param[in] capacity Maximum sum of the weights of the entries.
+ * \return Bounded cache or NULL on failure.
+ */
+AlfBoundedCache* alfCreateBoundedCache(
+	const AlfHashTableDesc* desc, 
+	uint64_t capacity);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a bounded cache.
+ * \brief Destroy bounded cache.
+ * \param[in] cache Bounded cache to destroy.
+ */
+void alfDestroyBoundedCache(AlfBoundedCache* cache);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a value with a weight of one into a bounded cache. Entries are 
+ * evicted until the value fits, and any value that the key already has is 
+ * replaced.
+ * \brief Insert value into bounded cache.
+ * \param[in] cache Bounded cache to insert into.
+ * \param[in] key Key to insert value for.
+ * \param[in] value Value to insert.
+ * \return True if the value was inserted, otherwise false.
+ */
+AlfBool alfBoundedCacheInsert(
+	AlfBoundedCache* cache,
+	const void* key,
+	const void* value);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a value with the specified weight into a bounded cache. Entries are
+ * evicted until the value fits, and any value that the key already has is 
+ * replaced.
+ * \brief Insert weighted value into bounded cache.
+ * \param[in] cache Bounded cache to insert into.
+ * \param[in] key Key to insert value for.
+ * \param[in] value Value to insert.
+ * \param[in] weight Weight of the entry, such as its size in bytes.
+ * \return True if the value was inserted, otherwise false. Values with a 
+ * weight that exceeds the capacity are never inserted.
+ */
+AlfBool alfBoundedCacheInsertWeighted(
+	AlfBoundedCache* cache,
+	const void* key,
+	const void* value,
+	uint32_t weight);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value that corresponds to a key in a bounded cache, and marks
+ * the entry as recently used. 
+ * \note The returned pointer is only valid until the cache is modified.
+ * \brief Returns value for key in bounded cache.
+ * \param[in] cache Bounded cache to get value from.
+ * \param[in] key Key to get value for.
+ * \return Value or NULL if the key was not found.
+ */
+void* alfBoundedCacheGet(AlfBoundedCache* cache, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove the value for a key from a bounded cache. The value is not cleaned
+ * when it is copied to the output buffer.
+ * \brief Remove value from bounded cache.
+ * \param[in] cache Bounded cache to remove from.
+ * \param[in] key Key to remove value for.
+ * \param[out] valueOut Buffer that the removed value is copied to. May be NULL.
+ * \return True if the key was found and removed, otherwise false.
+ */
+AlfBool alfBoundedCacheRemove(
+	AlfBoundedCache* cache,
+	const void* key,
+	void* valueOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of entries in a bounded cache.
+ * \brief Returns size of bounded cache.
+ * \param[in] cache Bounded cache to get size of.
+ * \return Size of cache.
+ */
+uint64_t alfBoundedCacheGetSize(AlfBoundedCache* cache);
+
+// -------------------------------------------------------------------------- //
+
+/** Retrieve the counters of a bounded cache.
+ * \brief Returns bounded cache statistics.
+ * \param[in] cache Bounded cache to get statistics of.
+ * \param[out] statisticsOut Statistics of the cache.
+ */
+void alfBoundedCacheGetStatistics(
+	AlfBoundedCache* cache, 
+	AlfBoundedCacheStatistics* statisticsOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Reset the hit, miss, insert and eviction counters of a bounded cache.
+ * \brief Reset bounded cache statistics.
+ * \param[in] cache Bounded cache to reset statistics of.
+ */
+void alfBoundedCacheResetStatistics(AlfBoundedCache* cache);
+
+// ========================================================================== //
+// OrderedHashTable Structures
+// ========================================================================== //
+
+/** \struct AlfOrderedHashTable
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 22:10
+ * \brief Ordered hash table.
+ * \details
+ * Structure that represents a hash table that remembers the order in which 
+ * keys were inserted. The entries are stored densely in insertion order, and
+ * a separate index array of 32-bit entry indices is probed to find them. The
+ * index array is much smaller than a bucket array, and is more likely to stay
+ * in cache.
+ * 
+ * Iteration visits the entries sequentially in insertion order, and never
+ * scans empty buckets. Removed entries keep their place until most entries 
+ * have been removed, at which point the entries are compacted and the arrays
+ * are shrunk, so iteration always takes time proportional to the size.
+ * 
+ * The table is created from a regular hash table descriptor. The layout is 
+ * ignored, and the bucket count is the initial entry capacity. Unlike regular
+ * hash tables the entry count is limited to 32 bits.
+ */
+typedef struct tag_AlfOrderedHashTable AlfOrderedHashTable;
+
+// -------------------------------------------------------------------------- //
+
+/** Prototype for a function that is used as a callback during ordered hash 
+ * table iteration.
+ * \param table Ordered hash table that is being iterated
+ * \param index Index, in insertion order, of the key-value pair.
+ * \param key Key.
+ * \param value Value corresponding to key.
+ * \return True should be returned to continue iteration. If false is returned
+ * then the iteration stops and the iterate function in turn also returns false.
+ */
+typedef AlfBool(*PFN_AlfOrderedHashTableIterate)(
+	AlfOrderedHashTable* table,
+	uint32_t index,
+	const void* key, 
+	void* value);
+
+// ========================================================================== //
+// OrderedHashTable Functions
+// ========================================================================== //
+
+/** Create an ordered hash table from a hash table descriptor.
+ * \brief Create ordered hash table.
+ * \param[in] desc Hash table descriptor.
+ * \return Ordered hash table or NULL on failure.
+ */
+AlfOrderedHashTable* alfCreateOrderedHashTable(const AlfHashTableDesc* desc);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy an ordered hash table.
+ * \brief Destroy ordered hash table.
+ * \param[in] table Ordered hash table to destroy.
+ */
+void alfDestroyOrderedHashTable(AlfOrderedHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a value into an ordered hash table. A new key is placed last in the
+ * order, while the value of a key that is already in the table is replaced 
+ * and the key keeps its place.
+ * \brief Insert value into ordered hash table.
+ * \param[in] table Ordered hash table to insert into.
+ * \param[in] key Key to insert value for.
+ * \param[in] value Value to insert.
+ * \return True if the value was inserted, otherwise false.
+ */
+AlfBool alfOrderedHashTableInsert(
+	AlfOrderedHashTable* table,
+	const void* key,
+	const void* value);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value that corresponds to a key in an ordered hash table.
+ * \note The returned pointer is only valid until the table is modified.
+ * \brief Returns value for key in ordered hash table.
+ * \param[in] table Ordered hash table to get value from.
+ * \param[in] key Key to get value for.
+ * \return Value or NULL if the key was not found.
+ */
+void* alfOrderedHashTableGet(AlfOrderedHashTable* table, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value that corresponds to a key in an ordered hash table, 
+ * inserting the key last in the order with a zero-initialized value if the 
+ * table does not contain it.
+ * \note The returned pointer is only valid until the table is modified.
+ * \brief Find or insert value in ordered hash table.
+ * \param[in] table Ordered hash table to find or insert in.
+ * \param[in] key Key to find or insert.
+ * \param[out] insertedOut Set to whether the key was inserted. May be NULL.
+ * \return Value or NULL if the key could not be inserted.
+ */
+void* alfOrderedHashTableFindOrInsert(
+	AlfOrderedHashTable* table,
+	const void* key,
+	AlfBool* insertedOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove the value for a key from an ordered hash table. The order of the 
+ * remaining keys is not changed.
+ * \brief Remove value from ordered hash table.
+ * \param[in] table Ordered hash table to remove from.
+ * \param[in] key Key to remove value for.
+ * \param[out] valueOut Buffer that the removed value is copied to. May be NULL.
+ * \return True if the key was found and removed, otherwise false.
+ */
+AlfBool alfOrderedHashTableRemove(
+	AlfOrderedHashTable* table,
+	const void* key,
+	void* valueOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether an ordered hash table contains a key.
+ * \brief Returns whether ordered hash table has key.
+ * \param[in] table Ordered hash table to check.
+ * \param[in] key Key to check for.
+ * \return True if the table contains the key, otherwise false.
+ */
+AlfBool alfOrderedHashTableHasKey(AlfOrderedHashTable* table, const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of entries in an ordered hash table.
+ * \brief Returns size of ordered hash table.
+ * \param[in] table Ordered hash table to get size of.
+ * \return Size of table.
+ */
+uint64_t alfOrderedHashTableGetSize(AlfOrderedHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Iterate an ordered hash table in insertion order and call the specified 
+ * callback for each key-value pair in the table.
+ * \brief Iterate ordered hash table entries.
+ * \param[in] table Ordered hash table to iterate.
+ * \param[in] iterateFunction Function to call for each entry during iteration.
+ * \return True if the iteration completed otherwise false. The iteration stops
+ * if the iterator function for an object returned false.
+ */
+AlfBool alfOrderedHashTableIterate(
+	AlfOrderedHashTable* table,
+	PFN_AlfOrderedHashTableIterate iterateFunction);
+
+// ========================================================================== //
+// ConcurrentHashTable Structures
+// ========================================================================== //
+
+#if defined(ALF_COLLECTION_USE_THREAD)
+
+/** \struct AlfConcurrentHashTable
+ * \author Filip Björklund
+ * \date 16 oktober 2026 - 17:05
+ * \brief Concurrent hash table.
+ * \details
+ * Structure that represents a hash table that can be used from multiple 
+ * threads at the same time. The entries are divided between a number of shards
+ * by their hash. Each shard is a regular hash table that is protected by its 
+ * own read-write lock, and the locks of different shards are kept on separate
+ * cache lines. Operations on different shards therefore do not contend. 
+ * Lookups in the same shard can run at the same time, but they still contend
+ * with each other, as taking the read lock writes to the shared lock word.
+ * 
+ * The table is created from the same descriptor as a regular hash table, with
+ * the same callbacks. Values are copied out of the table on lookup, as any 
+ * pointer into a shard could be invalidated by another thread.
+ * 
+ * \note This is only available when ALF_COLLECTION_USE_THREAD is defined, in
+ * which case the thread library (alf_thread) must also be part of the project.
+ */
+typedef struct tag_AlfConcurrentHashTable AlfConcurrentHashTable;
+
+// ========================================================================== //
+// ConcurrentHashTable Functions
+// ========================================================================== //
+
+/** Create a concurrent hash table from a hash table descriptor. The initial
+ * bucket count of the descriptor is divided between the shards.
+ * \brief Create concurrent hash table.
+ * \param[in] desc Hash table descriptor.
+ * \param[in] shardCount Number of shards. Must be a power of two, or zero to 
+ * use four shards per hardware thread.
+ * \return Created hash table or NULL on failure.
+ */
+AlfConcurrentHashTable* alfCreateConcurrentHashTable(
+	const AlfHashTableDesc* desc,
+	uint32_t shardCount);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a concurrent hash table and all the remaining entries in it. No 
+ * other thread may use the table during or after this call.
+ * \brief Destroy concurrent hash table.
+ * \param[in] table Hash table to destroy.
+ */
+void alfDestroyConcurrentHashTable(AlfConcurrentHashTable* table);
+
+// -------------------------------------------------------------------------- //
+
+/** Insert a value into a concurrent hash table with the specified key.
+ * \brief Insert value into concurrent hash table.
+ * \param[in] table Hash table to insert into.
+ * \param[in] key Key to insert value with.
+ * \param[in] value Value to insert.
+ * \return True if insertion succeeded, otherwise false.
+ */
+AlfBool alfConcurrentHashTableInsert(
+	AlfConcurrentHashTable* table,
+	const void* key,
+	const void* value);
+
+// -------------------------------------------------------------------------- //
+
+/** Lookup the value that corresponds to a key in a concurrent hash table and 
+ * copy it to the output buffer.
+ * \brief Get value from concurrent hash table.
+ * \param[in] table Hash table to get value from.
+ * \param[in] key Key to lookup value with.
+ * \param[in,out] valueOut Buffer that the value is copied to if the key was 
+ * found. May be NULL.
+ * \return True if the key was found otherwise false.
+ */
+AlfBool alfConcurrentHashTableGet(
+	AlfConcurrentHashTable* table,
+	const void* key,
+	void* valueOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Remove a value that is stored with a specified key from a concurrent hash
+ * table.
+ * \brief Remove value from concurrent hash table.
+ * \param[in] table Hash table to remove value from.
+ * \param[in] key Key to lookup the value to remove.
+ * \param[in,out] valueOut Removed value, this is only valid if the function
+ * also returns true. May be NULL.
+ * \return True if the value could be removed otherwise false.
+ */
+AlfBool alfConcurrentHashTableRemove(
+	AlfConcurrentHashTable* table,
+	const void* key,
+	void* valueOut);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether or not a concurrent hash table contains a value stored with
+ * the specified key.
+ * \brief Returns whether concurrent hash table contains key.
+ * \param[in] table Hash table to check if contains key.
+ * \param[in] key Key to check if table contains.
+ * \return True if the hash table contains the specified key otherwise false.
+ */
+AlfBool alfConcurrentHashTableHasKey(
+	AlfConcurrentHashTable* table,
+	const void* key);
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of entries in a concurrent hash table. The shards are 
+ * counted one at a time, so the result may already be outdated if other 
+ * threads are modifying the table.
+ * \brief Returns size of concurrent hash table.
+ * \param[in] table Hash table to get size of.
+ * \return Size of hash table.
+ */
+uint64_t alfConcurrentHashTableGetSize(AlfConcurrentHashTable* table);
+
+#endif // defined(ALF_COLLECTION_USE_THREAD)
+
+// ========================================================================== //
+// Typed HashTable Functions
+// ========================================================================== //
+
+/** Hash a 64-bit integer key for a typed hash table. All bits of the key 
+ * affect the low bits of the hash, that select the bucket.
+ * \brief Hash integer key.
+ * \param[in] key Key to hash.
+ * \return Hash of key.
+ */
+static inline uint64_t alfHashInteger(uint64_t key)
+{
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ull;
+	key ^= key >> 33;
+	return key;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Compare two keys of a typed hash table with the equality operator **/
+#define ALF_HASH_TABLE_EQUAL(key0, key1) ((key0) == (key1))
+
+// -------------------------------------------------------------------------- //
+
+/** Define a hash table for a specific key and value type. The table uses the 
+ * same robin-hood hashing as AlfHashTable, but the key and value are stored 
+ * in a typed bucket structure and the hash and equality functions are called
+ * directly. The compiler can therefore inline them and copy keys and values 
+ * with their known size, which makes the table considerably faster for small
+ * keys and values such as integers.
+ * 
+ * For a table named 'Name' this defines the types 'Name' and 'NameBucket', and
+ * the functions alfCreateName, alfDestroyName, alfNameInsert, alfNameGet, 
+ * alfNameFindOrInsert, alfNameRemove, alfNameHasKey, alfNameResize and 
+ * alfNameGetSize, which behave like their AlfHashTable counterparts.
+ * \note Unlike alfHashTableInsert, which adds a duplicate entry for a key that
+ * is already in the table, alfNameInsert replaces the value of the existing
+ * entry. alfNameResize must be given a power of two that is larger than the
+ * number of entries.
+ * \note Keys and values are copied by assignment and never destroyed, so they
+ * should be plain data. The table grows at a load factor of 0.8 and does not 
+ * shrink automatically.
+ * \brief Define typed hash table.
+ * \param Name Name of the table type.
+ * \param KeyType Type of keys.
+ * \param ValueType Type of values.
+ * \param hashFunction Function or function-like macro that returns the 64-bit
+ * hash of a key, for example alfHashInteger.
+ * \param equalFunction Function or function-like macro that returns whether two
+ * keys are equal, for example ALF_HASH_TABLE_EQUAL.
+ */
+#define ALF_HASH_TABLE_DEFINE( \
+	Name, KeyType, ValueType, hashFunction, equalFunction) \
+	typedef struct Name##Bucket \
+	{ \
+		uint64_t hash; \
+		KeyType key; \
+		ValueType value; \
+	} Name##Bucket; \
+\
+	typedef struct Name \
+	{ \
+		Name##Bucket* buckets; \
+		uint32_t bucketCount; \
+		uint32_t size; \
+	} Name; \
+\
+	static inline uint64_t alf##Name##GetKeyHash(KeyType key) \
+	{ \
+		const uint64_t keyHash = (uint64_t)(hashFunction(key)); \
+		return keyHash ? keyHash : 1; \
+	} \
+\
+	static inline uint32_t alf##Name##FindIndex( \
+		const Name* table, \
+		KeyType key, \
+		uint64_t keyHash) \
+	{ \
+		const uint32_t mask = table->bucketCount - 1; \
+		uint32_t index = (uint32_t)keyHash & mask; \
+		for (uint32_t distance = 0;; distance++) \
+		{ \
+			const Name##Bucket* bucket = &table->buckets[index]; \
+			if (bucket->hash == 0 || \
+				((index - (uint32_t)bucket->hash) & mask) < distance) \
+			{ \
+				return UINT32_MAX; \
+			} \
+			if (bucket->hash == keyHash && equalFunction(bucket->key, key)) \
+			{ \
+				return index; \
+			} \
+			index = (index + 1) & mask; \
+		} \
+	} \
+\
+	static inline uint32_t alf##Name##InsertBucket( \
+		Name* table, \
+		Name##Bucket entry) \
+	{ \
+		const uint32_t mask = table->bucketCount - 1; \
+		uint32_t index = (uint32_t)entry.hash & mask; \
+		uint32_t insertedIndex = UINT32_MAX; \
+		for (uint32_t distance = 0;; distance++) \
+		{ \
+			Name##Bucket* bucket = &table->buckets[index]; \
+			if (bucket->hash == 0) \
+			{ \
+				*bucket = entry; \
+				return insertedIndex == UINT32_MAX ? index : insertedIndex; \
+			} \
+			const uint32_t bucketDistance = \
+				(index - (uint32_t)bucket->hash) & mask; \
+			if (bucketDistance < distance) \
+			{ \
+				const Name##Bucket swapped = *bucket; \
+				*bucket = entry; \
+				entry = swapped; \
+				distance = bucketDistance; \
+				if (insertedIndex == UINT32_MAX) { insertedIndex = index; } \
+			} \
+			index = (index + 1) & mask; \
+		} \
+	} \
+\
+	static inline AlfBool alf##Name##Resize(Name* table, uint32_t size) \
+	{ \
+		ALF_COLLECTION_ASSERT( \
+			size != 0 && (size & (size - 1)) == 0 && size > table->size, \
+			"Hash table can only be resized to power of two sizes larger " \
+			"than the number of entries" \
+		); \
+		Name##Bucket* buckets = (Name##Bucket*)ALF_COLLECTION_ALLOC( \
+			sizeof(Name##Bucket) * size); \
+		if (!buckets) { return ALF_FALSE; } \
+		for (uint32_t i = 0; i < size; i++) { buckets[i].hash = 0; } \
+		Name##Bucket* oldBuckets = table->buckets; \
+		const uint32_t oldBucketCount = table->bucketCount; \
+		table->buckets = buckets; \
+		table->bucketCount = size; \
+		for (uint32_t i = 0; i < oldBucketCount; i++) \
+		{ \
+			if (oldBuckets[i].hash != 0) \
+			{ \
+				alf##Name##InsertBucket(table, oldBuckets[i]); \
+			} \
+		} \
+		ALF_COLLECTION_FREE(oldBuckets); \
+		return ALF_TRUE; \
+	} \
+\
+	static inline AlfBool alf##Name##Reserve(Name* table) \
+	{ \
+		if ((uint64_t)(table->size + 1) * 5 > \
+			(uint64_t)table->bucketCount * 4) \
+		{ \
+			return alf##Name##Resize(table, table->bucketCount << 1); \
+		} \
+		return ALF_TRUE; \
+	} \
+\
+	static inline Name* alfCreate##Name(uint32_t bucketCount) \
+	{ \
+		Name* table = (Name*)ALF_COLLECTION_ALLOC(sizeof(Name)); \
+		if (!table) { return NULL; } \
+		table->buckets = NULL; \
+		table->bucketCount = 0; \
+		table->size = 0; \
+		if (!alf##Name##Resize(table, bucketCount ? bucketCount : 1)) \
+		{ \
+			ALF_COLLECTION_FREE(table); \
+			return NULL; \
+		} \
+		return table; \
+	} \
+\
+	static inline void alfDestroy##Name(Name* table) \
+	{ \
+		ALF_COLLECTION_FREE(table->buckets); \
+		ALF_COLLECTION_FREE(table); \
+	} \
+\
+	static inline AlfBool alf##Name##Insert( \
+		Name* table, \
+		KeyType key, \
+		ValueType value) \
+	{ \
+		const uint64_t keyHash = alf##Name##GetKeyHash(key); \
+		const uint32_t index = alf##Name##FindIndex(table, key, keyHash); \
+		if (index != UINT32_MAX) \
+		{ \
+			table->buckets[index].value = value; \
+			return ALF_TRUE; \
+		} \
+		if (!alf##Name##Reserve(table)) { return ALF_FALSE; } \
+		Name##Bucket entry; \
+		entry.hash = keyHash; \
+		entry.key = key; \
+		entry.value = value; \
+		alf##Name##InsertBucket(table, entry); \
+		table->size++; \
+		return ALF_TRUE; \
+	} \
+\
+	static inline ValueType* alf##Name##Get(Name* table, KeyType key) \
+	{ \
+		const uint32_t index = \
+			alf##Name##FindIndex(table, key, alf##Name##GetKeyHash(key)); \
+		return index == UINT32_MAX ? NULL : &table->buckets[index].value; \
+	} \
+\
+	static inline ValueType* alf##Name##FindOrInsert( \
+		Name* table, \
+		KeyType key, \
+		AlfBool* insertedOut) \
+	{ \
+		const uint64_t keyHash = alf##Name##GetKeyHash(key); \
+		uint32_t index = alf##Name##FindIndex(table, key, keyHash); \
+		if (insertedOut) { *insertedOut = index == UINT32_MAX; } \
+		if (index != UINT32_MAX) { return &table->buckets[index].value; } \
+		if (!alf##Name##Reserve(table)) { return NULL; } \
+		Name##Bucket entry; \
+		memset(&entry, 0, sizeof(Name##Bucket)); \
+		entry.hash = keyHash; \
+		entry.key = key; \
+		index = alf##Name##InsertBucket(table, entry); \
+		table->size++; \
+		return &table->buckets[index].value; \
+	} \
+\
+	static inline AlfBool alf##Name##Remove( \
+		Name* table, \
+		KeyType key, \
+		ValueType* valueOut) \
+	{ \
+		uint32_t index = \
+			alf##Name##FindIndex(table, key, alf##Name##GetKeyHash(key)); \
+		if (index == UINT32_MAX) { return ALF_FALSE; } \
+		if (valueOut) { *valueOut = table->buckets[index].value; } \
+		const uint32_t mask = table->bucketCount - 1; \
+		uint32_t next = (index + 1) & mask; \
+		while (table->buckets[next].hash != 0 && \
+			((next - (uint32_t)table->buckets[next].hash) & mask) != 0) \
+		{ \
+			table->buckets[index] = table->buckets[next]; \
+			index = next; \
+			next = (next + 1) & mask; \
+		} \
+		table->buckets[index].hash = 0; \
+		table->size--; \
+		return ALF_TRUE; \
+	} \
+\
+	static inline AlfBool alf##Name##HasKey(Name* table, KeyType key) \
+	{ \
+		return alf##Name##Get(table, key) != NULL; \
+	} \
+\
+	static inline uint64_t alf##Name##GetSize(const Name* table) \
+	{ \
+		return table->size; \
+	}
+
 // ========================================================================== //
 // End of Header
 // ========================================================================== //
@@ -20,6 +20,11 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+// Feature macros must be defined before any standard header is included
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "alf_thread.h"
 
 // ========================================================================== //
@@ -39,7 +44,6 @@
 #elif defined(__linux__)
 #define ALF_THREAD_TARGET_LINUX
 #define ALF_THREAD_PTHREAD
-#define _GNU_SOURCE
 #include <semaphore.h>
 #include <zconf.h>
 #include <errno.h>
@@ -59,7 +63,6 @@ UNSUPPORTED_PLATFORM
 
 // Pthread header
 #if defined(ALF_THREAD_PTHREAD)
-#define _GNU_SOURCE
 #include <signal.h>
 #include <pthread.h>
 #endif
@@ -354,6 +357,20 @@ _alfMillisecondsToTimespec(uint32_t ms, struct timespec* time)
 
 // -------------------------------------------------------------------------- //
 
+/** Set the name of the calling thread. Linux takes the thread as argument
+ * while Apple platforms only allow naming the calling thread **/
+static void
+alfPthreadSetName(const char* name)
+{
+#if defined(ALF_THREAD_TARGET_APPLE)
+  pthread_setname_np(name);
+#else
+  pthread_setname_np(pthread_self(), name);
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
 static void*
 _alfPthreadThreadStart(void* argument)
 {
@@ -853,10 +870,10 @@ alfSetThreadName(const char* name)
     // TODO(Filip Bj�rklund): Don't cut UTF-8 codepoints in half!
 
     // Set the thread name
-    pthread_setname_np(temp_name);
+    alfPthreadSetName(temp_name);
   } else {
     // Set the thread name
-    pthread_setname_np(name);
+    alfPthreadSetName(name);
   }
 #endif
 
@@ -1291,20 +1308,14 @@ alfNotifyAllConditionVariables(AlfConditionVariable* conditionVariable)
 AlfReadWriteLock*
 alfCreateReadWriteLock()
 {
-#if defined(ALF_THREAD_TARGET_WINDOWS)
-  SRWLOCK handle;
-  InitializeSRWLock(&handle);
-#elif defined(ALF_THREAD_PTHREAD)
-  pthread_rwlock_t handle;
-  int32_t result = pthread_rwlock_init(&handle, NULL);
-  if (result != 0) {
+  void* memory = ALF_THREAD_ALLOC(sizeof(AlfReadWriteLock));
+  if (!memory) {
     return NULL;
   }
-#endif
-
-  AlfReadWriteLock* lock =
-    (AlfReadWriteLock*)ALF_THREAD_ALLOC(sizeof(AlfReadWriteLock));
-  lock->handle = handle;
+  AlfReadWriteLock* lock = alfInitReadWriteLock(memory);
+  if (!lock) {
+    ALF_THREAD_FREE(memory);
+  }
   return lock;
 }
 
@@ -1316,7 +1327,40 @@ alfDestroyReadWriteLock(AlfReadWriteLock* lock)
   if (!lock) {
     return;
   }
+  alfDeinitReadWriteLock(lock);
+  ALF_THREAD_FREE(lock);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t
+alfGetReadWriteLockSize()
+{
+  return sizeof(AlfReadWriteLock);
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfReadWriteLock*
+alfInitReadWriteLock(void* memory)
+{
+  AlfReadWriteLock* lock = (AlfReadWriteLock*)memory;
+#if defined(ALF_THREAD_TARGET_WINDOWS)
+  InitializeSRWLock(&lock->handle);
+#elif defined(ALF_THREAD_PTHREAD)
+  int32_t result = pthread_rwlock_init(&lock->handle, NULL);
+  if (result != 0) {
+    return NULL;
+  }
+#endif
+  return lock;
+}
+
+// -------------------------------------------------------------------------- //
 
+void
+alfDeinitReadWriteLock(AlfReadWriteLock* lock)
+{
 #if defined(ALF_THREAD_PTHREAD)
   int32_t result = pthread_rwlock_destroy(&lock->handle);
 
@@ -1326,10 +1370,9 @@ alfDestroyReadWriteLock(AlfReadWriteLock* lock)
   ALF_THREAD_ASSERT(result != EBUSY,
                     "Read-write lock cannot be destroyed while still in use");
   ALF_THREAD_ASSERT(result == 0, "Failed to destroy read-write lock");
-
+#else
+  (void)lock;
 #endif
-
-  ALF_THREAD_FREE(lock);
 }
 
 // -------------------------------------------------------------------------- //
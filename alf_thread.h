@@ -622,6 +622,40 @@ void alfDestroyReadWriteLock(AlfReadWriteLock* lock);
 
 // -------------------------------------------------------------------------- //
 
+/** Returns the size of the memory that a read-write lock needs when it is
+ * created in place with alfInitReadWriteLock.
+ * \brief Returns size of read-write lock.
+ * \return Size of read-write lock in bytes.
+ */
+uint64_t alfGetReadWriteLockSize(void);
+
+// -------------------------------------------------------------------------- //
+
+/** Create a read-write lock in unlocked state, in memory that is owned by the
+ * caller. This lets the caller decide where the lock is placed, for example 
+ * to keep locks that are used by different threads on separate cache lines.
+ * \note The lock must be destroyed with alfDeinitReadWriteLock, after which 
+ * the caller frees the memory.
+ * \brief Create read-write lock in place.
+ * \param memory Memory of at least alfGetReadWriteLockSize bytes, aligned to 
+ * at least the size of a pointer.
+ * \return Created lock, which is located at the memory, or NULL on failure.
+ */
+AlfReadWriteLock* alfInitReadWriteLock(void* memory);
+
+// -------------------------------------------------------------------------- //
+
+/** Destroy a read-write lock that was created with alfInitReadWriteLock. The
+ * memory of the lock is not freed.
+ * \note The user is responsible for making sure that the lock is not acquired
+ * by any threads when being destroyed.
+ * \brief Destroy read-write lock in place.
+ * \param lock Read-write lock to destroy.
+ */
+void alfDeinitReadWriteLock(AlfReadWriteLock* lock);
+
+// -------------------------------------------------------------------------- //
+
 /** Acquire a read-write lock in read mode. This mode allows other threads to
  * acquire the same lock in read mode. However if a thread tries to acquire the
  * lock in write mode it will block until all writers release the lock. 
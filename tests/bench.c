@@ -0,0 +1,679 @@
+// MIT License
+//
+// Copyright (c) 2018-2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// ========================================================================== //
+// Header Includes
+// ========================================================================== //
+
+// Standard headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Platform headers
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+// Alf headers
+#include "alf_collection.h"
+#include "alf_thread.h"
+
+// ========================================================================== //
+// Benchmark Parameters
+// ========================================================================== //
+
+/** Number of keys in the benchmarked tables **/
+#define BENCH_KEY_COUNT (1u << 16)
+
+/** Number of lookups that each thread performs **/
+#define BENCH_LOOKUP_COUNT (1u << 21)
+
+/** Maximum number of threads to benchmark with **/
+#define BENCH_MAX_THREAD_COUNT 64
+
+// ========================================================================== //
+// Utility Functions
+// ========================================================================== //
+
+/** Returns a timestamp in seconds **/
+double
+BenchTime()
+{
+#if defined(_WIN32)
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+void*
+BenchCopyString(const void* string)
+{
+  const size_t size = strlen((const char*)string) + 1;
+  char* output = (char*)malloc(size);
+  if (output) {
+    memcpy(output, string, size);
+  }
+  return output;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t
+BenchHashString(const void* string)
+{
+  const char* str = (const char*)string;
+  uint32_t hash = 0x811c9dc5ul;
+  while (*str) {
+    hash = (hash ^ (uint8_t)*str++) * 16777619ul;
+  }
+  return hash;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool
+BenchEqualString(const void* string0, const void* string1)
+{
+  return strcmp((const char*)string0, (const char*)string1) == 0;
+}
+
+// ========================================================================== //
+// Hash Benchmark
+// ========================================================================== //
+
+/** FNV-1a hash of a block of memory, as used before the built-in hash **/
+uint32_t
+BenchHashFNV(const void* data, uint64_t size)
+{
+  const uint8_t* bytes = (const uint8_t*)data;
+  uint32_t hash = 0x811c9dc5ul;
+  for (uint64_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619ul;
+  }
+  return hash;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Compare the throughput of FNV-1a with the built-in hash for short and long
+ * keys. Consecutive keys are taken from a buffer at different offsets **/
+void
+BenchHash()
+{
+  static uint8_t buffer[4096 + 64];
+  for (uint32_t i = 0; i < sizeof(buffer); i++) {
+    buffer[i] = (uint8_t)(i * 131u + 7u);
+  }
+
+  printf("Hash throughput\n");
+  printf("%8s %16s %16s\n", "size", "FNV-1a (GB/s)", "alfHash64 (GB/s)");
+  const uint32_t sizes[] = { 4, 8, 16, 32, 64, 256, 1024, 4096 };
+  for (uint32_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+    const uint32_t size = sizes[n];
+    const uint32_t count = (1u << 26) / size;
+    uint64_t sink = 0;
+
+    double start = BenchTime();
+    for (uint32_t i = 0; i < count; i++) {
+      sink += BenchHashFNV(buffer + (i & 63), size);
+    }
+    const double fnv = BenchTime() - start;
+
+    start = BenchTime();
+    for (uint32_t i = 0; i < count; i++) {
+      sink += alfHash64(buffer + (i & 63), size, 0);
+    }
+    const double hash = BenchTime() - start;
+
+    const double bytes = (double)count * size * 1e-9;
+    printf("%8u %16.2f %16.2f%s\n",
+           size,
+           bytes / fnv,
+           bytes / hash,
+           sink == 0 ? " " : "");
+  }
+  printf("\n");
+}
+
+// ========================================================================== //
+// Batch Benchmark
+// ========================================================================== //
+
+/** Number of keys in the table of the batch benchmark. The table should be 
+ * larger than the last level cache **/
+#define BENCH_BATCH_KEY_COUNT (1u << 21)
+
+/** Number of keys that are looked up together **/
+#define BENCH_BATCH_SIZE 128
+
+// -------------------------------------------------------------------------- //
+
+/** Compare lookups of random keys one at a time with batched lookups, in a 
+ * table with inline 64-bit keys **/
+void
+BenchBatch()
+{
+  // Setup table
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint64_t);
+  desc.keySize = sizeof(uint64_t);
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  for (uint64_t i = 0; i < BENCH_BATCH_KEY_COUNT; i++) {
+    alfHashTableInsert(table, &i, &i);
+  }
+
+  // Random keys to lookup
+  const uint32_t lookupCount = 1u << 22;
+  uint64_t* keys = (uint64_t*)malloc(sizeof(uint64_t) * lookupCount);
+  const void** keyPointers =
+    (const void**)malloc(sizeof(void*) * lookupCount);
+  uint32_t state = 1;
+  for (uint32_t i = 0; i < lookupCount; i++) {
+    state = state * 1664525u + 1013904223u;
+    keys[i] = state % BENCH_BATCH_KEY_COUNT;
+    keyPointers[i] = &keys[i];
+  }
+
+  // Single lookups
+  uint64_t sink = 0;
+  double start = BenchTime();
+  for (uint32_t i = 0; i < lookupCount; i++) {
+    sink += *(uint64_t*)alfHashTableGet(table, keyPointers[i]);
+  }
+  const double single = BenchTime() - start;
+
+  // Batched lookups
+  void* values[BENCH_BATCH_SIZE];
+  start = BenchTime();
+  for (uint32_t i = 0; i < lookupCount; i += BENCH_BATCH_SIZE) {
+    alfHashTableGetBatch(table, keyPointers + i, BENCH_BATCH_SIZE, values);
+    for (uint32_t j = 0; j < BENCH_BATCH_SIZE; j++) {
+      sink -= *(uint64_t*)values[j];
+    }
+  }
+  const double batch = BenchTime() - start;
+
+  printf("Batch lookup: %u keys, batches of %u\n",
+         BENCH_BATCH_KEY_COUNT,
+         BENCH_BATCH_SIZE);
+  printf("%20s %20s\n", "single (Mops/s)", "batch (Mops/s)");
+  printf("%20.2f %20.2f%s\n\n",
+         lookupCount / single * 1e-6,
+         lookupCount / batch * 1e-6,
+         sink != 0 ? " (mismatch)" : "");
+
+  // Cleanup
+  free(keyPointers);
+  free(keys);
+  alfDestroyHashTable(table);
+}
+
+// ========================================================================== //
+// Typed Benchmark
+// ========================================================================== //
+
+/** Typed hash table from integer keys to integer values **/
+ALF_HASH_TABLE_DEFINE(BenchIntegerTable,
+                      uint64_t,
+                      uint64_t,
+                      alfHashInteger,
+                      ALF_HASH_TABLE_EQUAL)
+
+// -------------------------------------------------------------------------- //
+
+/** Number of keys in the typed benchmark **/
+#define BENCH_TYPED_KEY_COUNT (1u << 20)
+
+// -------------------------------------------------------------------------- //
+
+/** Compare inserting and looking up integer keys in a hash table with inline
+ * keys and in a typed hash table **/
+void
+BenchTyped()
+{
+  // Random keys to insert and lookup
+  uint64_t* keys = (uint64_t*)malloc(sizeof(uint64_t) * BENCH_TYPED_KEY_COUNT);
+  uint64_t state = 1;
+  for (uint32_t i = 0; i < BENCH_TYPED_KEY_COUNT; i++) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    keys[i] = state;
+  }
+
+  // Hash table with inline keys
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint64_t);
+  desc.keySize = sizeof(uint64_t);
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  double start = BenchTime();
+  for (uint64_t i = 0; i < BENCH_TYPED_KEY_COUNT; i++) {
+    alfHashTableInsert(table, &keys[i], &i);
+  }
+  const double insert = BenchTime() - start;
+  uint64_t sink = 0;
+  start = BenchTime();
+  for (uint32_t n = 0; n < 4; n++) {
+    for (uint32_t i = 0; i < BENCH_TYPED_KEY_COUNT; i++) {
+      sink += *(uint64_t*)alfHashTableGet(table, &keys[i]);
+    }
+  }
+  const double get = BenchTime() - start;
+
+  // Typed hash table
+  BenchIntegerTable* typedTable = alfCreateBenchIntegerTable(16);
+  start = BenchTime();
+  for (uint64_t i = 0; i < BENCH_TYPED_KEY_COUNT; i++) {
+    alfBenchIntegerTableInsert(typedTable, keys[i], i);
+  }
+  const double typedInsert = BenchTime() - start;
+  start = BenchTime();
+  for (uint32_t n = 0; n < 4; n++) {
+    for (uint32_t i = 0; i < BENCH_TYPED_KEY_COUNT; i++) {
+      sink -= *alfBenchIntegerTableGet(typedTable, keys[i]);
+    }
+  }
+  const double typedGet = BenchTime() - start;
+
+  printf("Typed: %u uint64 keys\n", BENCH_TYPED_KEY_COUNT);
+  printf("%12s %20s %20s\n", "", "insert (Mops/s)", "get (Mops/s)");
+  printf("%12s %20.2f %20.2f\n",
+         "untyped",
+         BENCH_TYPED_KEY_COUNT / insert * 1e-6,
+         4.0 * BENCH_TYPED_KEY_COUNT / get * 1e-6);
+  printf("%12s %20.2f %20.2f%s\n\n",
+         "typed",
+         BENCH_TYPED_KEY_COUNT / typedInsert * 1e-6,
+         4.0 * BENCH_TYPED_KEY_COUNT / typedGet * 1e-6,
+         sink != 0 ? " (mismatch)" : "");
+
+  // Cleanup
+  alfDestroyBenchIntegerTable(typedTable);
+  alfDestroyHashTable(table);
+  free(keys);
+}
+
+// ========================================================================== //
+// Parallel Build Benchmark
+// ========================================================================== //
+
+/** Number of keys in the parallel build benchmark **/
+#define BENCH_BUILD_KEY_COUNT (1u << 22)
+
+// -------------------------------------------------------------------------- //
+
+/** Compare building a large hash table by inserting one key at a time and by
+ * building it in parallel with different thread counts **/
+void
+BenchBuild()
+{
+  // Random keys and their values
+  uint64_t* keys = (uint64_t*)malloc(sizeof(uint64_t) * BENCH_BUILD_KEY_COUNT);
+  const void** keyPointers =
+    (const void**)malloc(sizeof(void*) * BENCH_BUILD_KEY_COUNT);
+  uint64_t state = 1;
+  for (uint32_t i = 0; i < BENCH_BUILD_KEY_COUNT; i++) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    keys[i] = state;
+    keyPointers[i] = &keys[i];
+  }
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint64_t);
+  desc.keySize = sizeof(uint64_t);
+
+  // Insert one key at a time
+  double start = BenchTime();
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  for (uint32_t i = 0; i < BENCH_BUILD_KEY_COUNT; i++) {
+    alfHashTableInsert(table, &keys[i], &keys[i]);
+  }
+  const double insert = BenchTime() - start;
+  alfDestroyHashTable(table);
+
+  printf("Parallel build: %u uint64 keys\n", BENCH_BUILD_KEY_COUNT);
+  printf("%12s %20s\n", "threads", "build (Mops/s)");
+  printf("%12s %20.2f\n", "insert", BENCH_BUILD_KEY_COUNT / insert * 1e-6);
+
+  // Build in parallel
+  const uint32_t threadCounts[] = { 2, 4, 8, alfGetHardwareThreadCount() };
+  for (uint32_t i = 0; i < sizeof(threadCounts) / sizeof(uint32_t); i++) {
+    start = BenchTime();
+    table = alfHashTableBuildParallel(
+      &desc, keyPointers, keyPointers, BENCH_BUILD_KEY_COUNT, threadCounts[i]);
+    const double build = BenchTime() - start;
+    const AlfBool valid = alfHashTableGetSize(table) == BENCH_BUILD_KEY_COUNT &&
+                          *(uint64_t*)alfHashTableGet(table, &keys[0]) == keys[0];
+    printf("%12u %20.2f%s\n",
+           threadCounts[i],
+           BENCH_BUILD_KEY_COUNT / build * 1e-6,
+           valid ? "" : " (mismatch)");
+    alfDestroyHashTable(table);
+  }
+  printf("\n");
+
+  // Cleanup
+  free(keyPointers);
+  free(keys);
+}
+
+// ========================================================================== //
+// Sort Benchmark
+// ========================================================================== //
+
+/** Number of objects in the sort benchmark **/
+#define BENCH_SORT_OBJECT_COUNT (1u << 22)
+
+// -------------------------------------------------------------------------- //
+
+/** Compare two objects by their first 32-bit integer **/
+int32_t
+BenchCompareUint32(const void* object0, const void* object1)
+{
+  uint32_t key0, key1;
+  memcpy(&key0, object0, sizeof(uint32_t));
+  memcpy(&key1, object1, sizeof(uint32_t));
+  return key0 < key1 ? -1 : key0 > key1;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Create an array-list of objects with a random 32-bit key and an index **/
+AlfArrayList*
+BenchCreateSortList()
+{
+  AlfArrayList* list =
+    alfCreateArrayListForObjectSize(sizeof(uint32_t) * 2, NULL);
+  uint32_t state = 1;
+  for (uint32_t i = 0; i < BENCH_SORT_OBJECT_COUNT; i++) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t object[2] = { state, i };
+    alfArrayListAdd(list, object);
+  }
+  return list;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Compare sorting an array-list on one thread with sorting it in parallel 
+ * with different thread counts **/
+void
+BenchSort()
+{
+  AlfArrayList* list = BenchCreateSortList();
+  double start = BenchTime();
+  alfArrayListSort(list, BenchCompareUint32);
+  const double sequential = BenchTime() - start;
+  alfDestroyArrayList(list);
+
+  printf("Sort: %u 8-byte objects\n", BENCH_SORT_OBJECT_COUNT);
+  printf("%12s %20s %20s\n", "threads", "sort (Mops/s)", "stable (Mops/s)");
+  printf(
+    "%12s %20.2f\n", "sequential", BENCH_SORT_OBJECT_COUNT / sequential * 1e-6);
+  const uint32_t threadCounts[] = { 2, 4, 8, alfGetHardwareThreadCount() };
+  for (uint32_t i = 0; i < sizeof(threadCounts) / sizeof(uint32_t); i++) {
+    list = BenchCreateSortList();
+    start = BenchTime();
+    alfArrayListSortParallel(list, BenchCompareUint32, threadCounts[i]);
+    const double sort = BenchTime() - start;
+    alfDestroyArrayList(list);
+
+    list = BenchCreateSortList();
+    start = BenchTime();
+    alfArrayListSortParallelStable(list, BenchCompareUint32, threadCounts[i]);
+    const double stable = BenchTime() - start;
+    alfDestroyArrayList(list);
+
+    printf("%12u %20.2f %20.2f\n",
+           threadCounts[i],
+           BENCH_SORT_OBJECT_COUNT / sort * 1e-6,
+           BENCH_SORT_OBJECT_COUNT / stable * 1e-6);
+  }
+  printf("\n");
+}
+
+// ========================================================================== //
+// Search Benchmark
+// ========================================================================== //
+
+/** Number of objects in the sorted list of the search benchmark **/
+#define BENCH_SEARCH_OBJECT_COUNT (1u << 22)
+
+/** Number of searches in the search benchmark **/
+#define BENCH_SEARCH_COUNT (1u << 22)
+
+// -------------------------------------------------------------------------- //
+
+/** Compare a binary search of a sorted array-list with a search of an 
+ * Eytzinger array of the same objects, for random keys **/
+void
+BenchSearch()
+{
+  AlfArrayList* list =
+    alfCreateArrayListForObjectSize(sizeof(uint32_t), NULL);
+  alfArrayListReserve(list, BENCH_SEARCH_OBJECT_COUNT);
+  for (uint32_t i = 0; i < BENCH_SEARCH_OBJECT_COUNT; i++) {
+    const uint32_t key = i * 2;
+    alfArrayListAdd(list, &key);
+  }
+  AlfEytzingerArray* array = alfCreateEytzingerArray(list);
+
+  uint64_t sink = 0;
+  uint32_t state = 1;
+  double start = BenchTime();
+  for (uint32_t i = 0; i < BENCH_SEARCH_COUNT; i++) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t key = state % (BENCH_SEARCH_OBJECT_COUNT * 2);
+    sink += alfArrayListLowerBound(list, &key, BenchCompareUint32);
+  }
+  const double binary = BenchTime() - start;
+
+  state = 1;
+  start = BenchTime();
+  for (uint32_t i = 0; i < BENCH_SEARCH_COUNT; i++) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t key = state % (BENCH_SEARCH_OBJECT_COUNT * 2);
+    sink -= alfEytzingerArrayLowerBound(array, &key, BenchCompareUint32);
+  }
+  const double eytzinger = BenchTime() - start;
+
+  printf("Search: %u uint32 keys\n", BENCH_SEARCH_OBJECT_COUNT);
+  printf("%20s %20s\n", "binary (Mops/s)", "Eytzinger (Mops/s)");
+  printf("%20.2f %20.2f%s\n\n",
+         BENCH_SEARCH_COUNT / binary * 1e-6,
+         BENCH_SEARCH_COUNT / eytzinger * 1e-6,
+         sink != 0 ? " (mismatch)" : "");
+
+  // Cleanup
+  alfDestroyEytzingerArray(array);
+  alfDestroyArrayList(list);
+}
+
+// ========================================================================== //
+// Contention Benchmark
+// ========================================================================== //
+
+/** Keys that are inserted into the benchmarked tables **/
+static char benchKeys[BENCH_KEY_COUNT][16];
+
+/** Argument to each lookup thread **/
+typedef struct LookupArgument
+{
+  AlfHashTable* table;
+  AlfReadWriteLock* lock;
+  AlfConcurrentHashTable* concurrentTable;
+  uint32_t seed;
+  uint32_t sum;
+} LookupArgument;
+
+// -------------------------------------------------------------------------- //
+
+/** Lookup random keys in a hash table protected by a single lock **/
+uint32_t
+LookupLocked(void* argument)
+{
+  LookupArgument* arg = (LookupArgument*)argument;
+  uint32_t state = arg->seed;
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < BENCH_LOOKUP_COUNT; i++) {
+    state = state * 1664525u + 1013904223u;
+    alfAcquireReadLock(arg->lock);
+    const uint32_t* value =
+      alfHashTableGet(arg->table, benchKeys[(state >> 8) % BENCH_KEY_COUNT]);
+    sum += value ? *value : 0;
+    alfReleaseReadLock(arg->lock);
+  }
+  arg->sum = sum;
+  return 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Lookup random keys in a concurrent hash table **/
+uint32_t
+LookupConcurrent(void* argument)
+{
+  LookupArgument* arg = (LookupArgument*)argument;
+  uint32_t state = arg->seed;
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < BENCH_LOOKUP_COUNT; i++) {
+    state = state * 1664525u + 1013904223u;
+    uint32_t value = 0;
+    alfConcurrentHashTableGet(arg->concurrentTable,
+                              benchKeys[(state >> 8) % BENCH_KEY_COUNT],
+                              &value);
+    sum += value;
+  }
+  arg->sum = sum;
+  return 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Run a lookup function on a number of threads and return lookups/second **/
+double
+RunLookupThreads(PFN_AlfThreadFunction function,
+                 LookupArgument* argument,
+                 uint32_t threadCount)
+{
+  LookupArgument arguments[BENCH_MAX_THREAD_COUNT];
+  AlfThread* threads[BENCH_MAX_THREAD_COUNT];
+  const double start = BenchTime();
+  for (uint32_t i = 0; i < threadCount; i++) {
+    arguments[i] = *argument;
+    arguments[i].seed = i * 2654435769u + 1;
+    threads[i] = alfCreateThread(function, &arguments[i]);
+  }
+  for (uint32_t i = 0; i < threadCount; i++) {
+    alfJoinThread(threads[i]);
+  }
+  const double elapsed = BenchTime() - start;
+  return (double)threadCount * BENCH_LOOKUP_COUNT / elapsed;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Compare lookups in a single read-write locked hash table with lookups in a
+ * concurrent hash table, for an increasing number of threads **/
+void
+BenchContention()
+{
+  // Setup tables
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.hashFunction = BenchHashString;
+  desc.keyEqual = BenchEqualString;
+  desc.keyCopy = BenchCopyString;
+  desc.keyDestructor = free;
+  LookupArgument argument = { 0 };
+  argument.table = alfCreateHashTable(&desc);
+  argument.lock = alfCreateReadWriteLock();
+  argument.concurrentTable = alfCreateConcurrentHashTable(&desc, 0);
+  for (uint32_t i = 0; i < BENCH_KEY_COUNT; i++) {
+    sprintf(benchKeys[i], "key%u", i);
+    alfHashTableInsert(argument.table, benchKeys[i], &i);
+    alfConcurrentHashTableInsert(argument.concurrentTable, benchKeys[i], &i);
+  }
+
+  // Run with 1, 2, 4, ... threads up to the hardware thread count
+  uint32_t maxThreadCount = alfGetHardwareThreadCount();
+  if (maxThreadCount > BENCH_MAX_THREAD_COUNT) {
+    maxThreadCount = BENCH_MAX_THREAD_COUNT;
+  }
+  printf("Contention: %u keys, %u lookups per thread\n",
+         BENCH_KEY_COUNT,
+         BENCH_LOOKUP_COUNT);
+  printf("%8s %20s %20s\n", "threads", "locked (Mops/s)", "concurrent (Mops/s)");
+  for (uint32_t threadCount = 1;; threadCount <<= 1) {
+    if (threadCount > maxThreadCount) {
+      threadCount = maxThreadCount;
+    }
+    const double locked =
+      RunLookupThreads(LookupLocked, &argument, threadCount);
+    const double concurrent =
+      RunLookupThreads(LookupConcurrent, &argument, threadCount);
+    printf("%8u %20.2f %20.2f\n",
+           threadCount,
+           locked * 1e-6,
+           concurrent * 1e-6);
+    if (threadCount == maxThreadCount) {
+      break;
+    }
+  }
+
+  // Cleanup
+  alfDestroyConcurrentHashTable(argument.concurrentTable);
+  alfDestroyReadWriteLock(argument.lock);
+  alfDestroyHashTable(argument.table);
+}
+
+// ========================================================================== //
+// Main Function
+// ========================================================================== //
+
+int
+main()
+{
+  alfThreadStartup();
+  BenchHash();
+  BenchBatch();
+  BenchTyped();
+  BenchBuild();
+  BenchSort();
+  BenchSearch();
+  BenchContention();
+  alfThreadShutdown();
+  return 0;
+}
@@ -25,6 +25,8 @@
 // ========================================================================== //
 
 // Standard headers
+#include <stddef.h>
+#include <stdio.h>
 #include <string.h>
 
 // Alf headers
@@ -98,6 +100,231 @@ CopyString(const char* string)
   return output;
 }
 
+// -------------------------------------------------------------------------- //
+
+void*
+CopyStringKey(const void* string)
+{
+  return CopyString((const char*)string);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t
+HashString(const void* string)
+{
+  const char* str = (const char*)string;
+  uint32_t hash = 0x811c9dc5ul;
+  while (*str) {
+    hash = (hash ^ (uint8_t)*str++) * 16777619ul;
+  }
+  return hash;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool
+EqualString(const void* string0, const void* string1)
+{
+  return strcmp((const char*)string0, (const char*)string1) == 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Number of threads and keys per thread in the concurrent hash table test **/
+#define CONCURRENT_THREAD_COUNT 4
+#define CONCURRENT_KEY_COUNT 1000
+
+/** Keys used in the concurrent hash table test **/
+static char concurrentKeys[CONCURRENT_THREAD_COUNT * CONCURRENT_KEY_COUNT][16];
+
+/** Argument to the threads in the concurrent hash table test **/
+typedef struct ConcurrentArgument
+{
+  AlfConcurrentHashTable* table;
+  uint32_t thread;
+} ConcurrentArgument;
+
+// -------------------------------------------------------------------------- //
+
+uint32_t
+ConcurrentInsertRemove(void* argument)
+{
+  // Each thread inserts its own keys, then removes every other one
+  ConcurrentArgument* arg = (ConcurrentArgument*)argument;
+  const uint32_t first = arg->thread * CONCURRENT_KEY_COUNT;
+  uint32_t failures = 0;
+  for (uint32_t i = first; i < first + CONCURRENT_KEY_COUNT; i++) {
+    failures += !alfConcurrentHashTableInsert(arg->table, concurrentKeys[i], &i);
+  }
+  for (uint32_t i = first; i < first + CONCURRENT_KEY_COUNT; i += 2) {
+    failures += !alfConcurrentHashTableRemove(arg->table, concurrentKeys[i], NULL);
+  }
+  return failures;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Number of lookups that each thread performs in the concurrent get test **/
+#define CONCURRENT_GET_COUNT 20000
+
+/** Argument to the threads in the concurrent get test **/
+typedef struct ConcurrentGetArgument
+{
+  AlfHashTable* table;
+  AlfConcurrentHashTable* concurrentTable;
+} ConcurrentGetArgument;
+
+// -------------------------------------------------------------------------- //
+
+uint32_t
+ConcurrentGet(void* argument)
+{
+  // Lookup the same keys as the other threads, in both tables
+  ConcurrentGetArgument* arg = (ConcurrentGetArgument*)argument;
+  uint32_t failures = 0;
+  for (uint32_t i = 0; i < CONCURRENT_GET_COUNT; i++) {
+    const uint32_t key = i % CONCURRENT_KEY_COUNT;
+    const uint32_t* value = alfHashTableGet(arg->table, &key);
+    uint32_t concurrentValue = 0;
+    failures += !value || *value != key;
+    failures += !alfConcurrentHashTableGet(
+                  arg->concurrentTable, &key, &concurrentValue) ||
+                concurrentValue != key;
+  }
+  return failures;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t
+HashStringLength(const void* string)
+{
+  return (uint32_t)strlen((const char*)string);
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t
+HashUint32Identity64(const void* key)
+{
+  return *(const uint32_t*)key;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint64_t
+HashUint64Low4Bits(const void* key)
+{
+  return (*(const uint64_t*)key & 0xF) + 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+CombineSum(void* value, const void* otherValue)
+{
+  *(uint32_t*)value += *(const uint32_t*)otherValue;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t cleanedValueCount = 0;
+
+void
+CountCleanedValue(const void* value)
+{
+  cleanedValueCount++;
+}
+
+// -------------------------------------------------------------------------- //
+
+uint32_t orderedKeys[128];
+uint32_t orderedKeyCount = 0;
+
+AlfBool
+CollectOrderedKey(AlfOrderedHashTable* table,
+                  uint32_t index,
+                  const void* key,
+                  void* value)
+{
+  orderedKeys[orderedKeyCount++] = *(const uint32_t*)key;
+  return orderedKeyCount < 128;
+}
+
+// -------------------------------------------------------------------------- //
+
+int
+CompareUint32Key(const void* object0, const void* object1)
+{
+  uint32_t key0, key1;
+  memcpy(&key0, object0, sizeof(uint32_t));
+  memcpy(&key1, object1, sizeof(uint32_t));
+  return key0 < key1 ? -1 : key0 > key1;
+}
+
+// -------------------------------------------------------------------------- //
+
+AlfBool
+IsOddUint32(const void* object, void* user)
+{
+  uint32_t value;
+  memcpy(&value, object, sizeof(uint32_t));
+  return value % 2 == 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+void*
+AllocLimited(void* user, uint64_t size)
+{
+  uint32_t* allocationsLeft = (uint32_t*)user;
+  if (*allocationsLeft == 0) {
+    return NULL;
+  }
+  (*allocationsLeft)--;
+  return malloc((size_t)size);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+FreeLimited(void* user, void* memory, uint64_t size)
+{
+  free(memory);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Copy the first 'length' bytes of a file to another file **/
+AlfBool
+CopyFilePrefix(const char* from, const char* to, long length)
+{
+  FILE* source = fopen(from, "rb");
+  FILE* target = fopen(to, "wb");
+  AlfBool success = source && target;
+  for (long i = 0; i < length && success; i++) {
+    const int c = fgetc(source);
+    success = c != EOF && fputc(c, target) != EOF;
+  }
+  if (source) {
+    fclose(source);
+  }
+  if (target) {
+    fclose(target);
+  }
+  return success;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Typed hash table from integer keys to integer values **/
+ALF_HASH_TABLE_DEFINE(IntegerTable,
+                      uint64_t,
+                      uint64_t,
+                      alfHashInteger,
+                      ALF_HASH_TABLE_EQUAL)
+
 // ========================================================================== //
 // Main Function
 // ========================================================================== //
@@ -105,7 +332,9 @@ CopyString(const char* string)
 int
 main()
 {
+  alfThreadStartup();
   const AlfTestInt r = alfTestRun();
+  alfThreadShutdown();
   return r;
 }
 
@@ -414,4 +643,1565 @@ ALF_TEST("Remove", "[Hash Table]")
 
   // Destroy table
   alfDestroyHashTable(table);
-}
\ No newline at end of file
+}
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Control Bytes", "[Hash Table]")
+{
+  // Create table with the control byte layout
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 4;
+  desc.valueSize = sizeof(uint32_t);
+  desc.layout = ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES;
+  desc.hashFunction = HashString;
+  desc.keyEqual = EqualString;
+  desc.keyCopy = CopyStringKey;
+  desc.keyDestructor = free;
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == fruitNamesCount);
+
+  // Remove values on even indices
+  for (uint32_t i = 0; i < fruitNamesCount; i += 2) {
+    ALF_CHECK_TRUE(alfHashTableRemove(table, fruitNames[i], NULL));
+  }
+
+  // Check that only values on odd indices remain
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    uint32_t* value = alfHashTableGet(table, fruitNames[i]);
+    if (i % 2 == 0) {
+      ALF_CHECK_NULL(value, "Removed value should not be retrievable");
+    } else {
+      ALF_CHECK_TRUE(value && *value == numbers0through79[i]);
+    }
+  }
+  ALF_CHECK_FALSE(alfHasKey(table, "Not a fruit"));
+
+  // Reinsert to reuse deleted buckets
+  for (uint32_t i = 0; i < fruitNamesCount; i += 2) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    uint32_t* value = alfHashTableGet(table, fruitNames[i]);
+    ALF_CHECK_TRUE(value && *value == numbers0through79[i]);
+  }
+
+  // Destroy table
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Automatic Shrink", "[Hash Table]")
+{
+  // Insert values to grow the table past its initial bucket count
+  AlfHashTable* table = alfCreateHashTableSimple(sizeof(uint32_t), NULL);
+  alfHashTableSetAutomaticShrink(table, ALF_TRUE);
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+
+  // Remove all but four values, the table may not shrink below the initial
+  // bucket count of 32
+  for (uint32_t i = 4; i < fruitNamesCount; i++) {
+    ALF_CHECK_TRUE(alfHashTableRemove(table, fruitNames[i], NULL));
+  }
+  ALF_CHECK_TRUE(alfHashTableGetLoadFactor(table) == 4.0f / 32.0f);
+
+  // Check that remaining values survived the shifting and shrinking
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    uint32_t* value = alfHashTableGet(table, fruitNames[i]);
+    if (i < 4) {
+      ALF_CHECK_TRUE(value && *value == numbers0through79[i]);
+    } else {
+      ALF_CHECK_NULL(value);
+    }
+  }
+
+  // Destroy table
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Incremental Resize", "[Hash Table]")
+{
+  // Insert values while checking that earlier values remain retrievable during
+  // the incremental resizes
+  AlfHashTable* table = alfCreateHashTableSimple(sizeof(uint32_t), NULL);
+  alfHashTableSetIncrementalResize(table, 2);
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+    for (uint32_t j = 0; j <= i; j++) {
+      uint32_t* value = alfHashTableGet(table, fruitNames[j]);
+      found = found && value && *value == numbers0through79[j];
+    }
+  }
+  ALF_CHECK_TRUE(found, "Values must be retrievable while resizing");
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == fruitNamesCount);
+
+  // Remove values on even indices
+  for (uint32_t i = 0; i < fruitNamesCount; i += 2) {
+    ALF_CHECK_TRUE(alfHashTableRemove(table, fruitNames[i], NULL));
+  }
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    ALF_CHECK_TRUE(alfHasKey(table, fruitNames[i]) == (i % 2 != 0));
+  }
+
+  // Destroy table
+  alfDestroyHashTable(table);
+
+  // Grow a table with automatic shrinking, then remove keys until it would
+  // shrink before the incremental resize completes
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 1024;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  table = alfCreateHashTable(&desc);
+  alfHashTableSetIncrementalResize(table, 2);
+  alfHashTableSetAutomaticShrink(table, ALF_TRUE);
+  alfHashTableSetMinLoadFactor(table, 0.35f);
+  uint32_t count = 0;
+  AlfHashTableStatistics statistics;
+  do {
+    alfHashTableInsert(table, &count, &count);
+    count++;
+    alfHashTableGetStatistics(table, &statistics);
+  } while (statistics.bucketCount == 1024);
+  AlfBool removed = ALF_TRUE;
+  for (uint32_t i = 0; i < count / 4; i++) {
+    removed = removed && alfHashTableRemove(table, &i, NULL);
+  }
+  ALF_CHECK_TRUE(removed);
+  ALF_CHECK_TRUE(alfHashTableGetLoadFactor(table) < 0.35f);
+  alfHashTableGetStatistics(table, &statistics);
+  ALF_CHECK_TRUE(statistics.bucketCount == 1024 + 2048,
+                 "Shrink must wait for the incremental resize to complete");
+  found = ALF_TRUE;
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t* value = alfHashTableGet(table, &i);
+    found = found && (i < count / 4 ? !value : value && *value == i);
+  }
+  ALF_CHECK_TRUE(found, "Values must be retrievable while shrink is deferred");
+
+  // Shrink once the resize has completed
+  for (uint32_t i = count / 4; i < count / 4 + 512; i++) {
+    removed = removed && alfHashTableRemove(table, &i, NULL);
+  }
+  ALF_CHECK_TRUE(removed);
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == count - count / 4 - 512);
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) / alfHashTableGetLoadFactor(table) <
+                 2048.0f);
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Inline Keys", "[Hash Table]")
+{
+  // Create table with integer keys stored in the buckets
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(const char*);
+  desc.keySize = sizeof(uint32_t);
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  ALF_CHECK_NOT_NULL(table);
+
+  // Insert fruits using their indices as keys. The keys are copied, so they
+  // can be modified afterwards
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    uint32_t key = i;
+    alfHashTableInsert(table, &key, &fruitNames[i]);
+    key = UINT32_MAX;
+  }
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == fruitNamesCount);
+
+  // Lookup and remove values
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    const char** value = alfHashTableGet(table, &numbers0through79[i]);
+    found = found && value && strcmp(*value, fruitNames[i]) == 0;
+  }
+  ALF_CHECK_TRUE(found, "Values must be retrievable with inline keys");
+  const char* removed = NULL;
+  ALF_CHECK_TRUE(alfHashTableRemove(table, &numbers0through79[3], &removed));
+  ALF_CHECK_STR_EQ(removed, fruitNames[3]);
+  ALF_CHECK_FALSE(alfHasKey(table, &numbers0through79[3]));
+  ALF_CHECK_TRUE(alfHasKey(table, &numbers0through79[4]));
+
+  // Destroy table
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("String Key Arena", "[Hash Table]")
+{
+  // Insert enough keys that the arena is compacted when most are removed
+  AlfHashTable* table = alfCreateHashTableSimple(sizeof(uint32_t), NULL);
+  const uint32_t count = 20000;
+  char key[32];
+  for (uint32_t i = 0; i < count; i++) {
+    sprintf(key, "arena key %u", i);
+    alfHashTableInsert(table, key, &i);
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    if (i % 8 != 0) {
+      sprintf(key, "arena key %u", i);
+      alfHashTableRemove(table, key, NULL);
+    }
+  }
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == count / 8);
+
+  // Check that the remaining keys survived compaction
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < count; i++) {
+    sprintf(key, "arena key %u", i);
+    uint32_t* value = alfHashTableGet(table, key);
+    found = found && (i % 8 == 0 ? value && *value == i : value == NULL);
+  }
+  ALF_CHECK_TRUE(found, "Remaining keys must be found after compaction");
+
+  // Destroy table
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Hash Functions", "[Hash Table]")
+{
+  // Hashes must be deterministic and depend on the seed
+  const char* text = "The quick brown fox jumps over the lazy dog";
+  const uint64_t length = strlen(text);
+  ALF_CHECK_TRUE(alfHash64(text, length, 0) == alfHash64(text, length, 0));
+  ALF_CHECK_TRUE(alfHash64(text, length, 0) != alfHash64(text, length, 1));
+  ALF_CHECK_TRUE(alfHashString64(text) == alfHash64(text, length, 0));
+  ALF_CHECK_TRUE(alfHashString(text) == alfHash32(text, length, 0));
+
+  // Every prefix length, through all the size classes, must hash differently
+  AlfBool unique = ALF_TRUE;
+  for (uint64_t i = 0; i <= length; i++) {
+    for (uint64_t j = 0; j < i; j++) {
+      unique = unique && alfHash64(text, i, 0) != alfHash64(text, j, 0);
+    }
+  }
+  ALF_CHECK_TRUE(unique, "Prefixes of different length must not collide");
+
+  // Table with 64-bit hash function
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.hashFunction64 = alfHashString64;
+  desc.keyEqual = EqualString;
+  desc.keyCopy = CopyStringKey;
+  desc.keyDestructor = free;
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    uint32_t* value = alfHashTableGet(table, fruitNames[i]);
+    found = found && value && *value == numbers0through79[i];
+  }
+  ALF_CHECK_TRUE(found, "Values must be retrievable with 64-bit hashes");
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Get Batch", "[Hash Table]")
+{
+  // Insert fruits on even indices
+  AlfHashTable* table = alfCreateHashTableSimple(sizeof(uint32_t), NULL);
+  for (uint32_t i = 0; i < fruitNamesCount; i += 2) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+
+  // Lookup all fruits in one batch
+  void* values[80];
+  const uint32_t found = alfHashTableGetBatch(
+    table, (const void* const*)fruitNames, fruitNamesCount, values);
+  ALF_CHECK_TRUE(found == fruitNamesCount / 2);
+  AlfBool matches = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    matches = matches && values[i] == alfHashTableGet(table, fruitNames[i]);
+  }
+  ALF_CHECK_TRUE(matches, "Batch must return the same values as single get");
+
+  // Destroy table
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Find Or Insert", "[Hash Table]")
+{
+  // Count the first letters of all fruits
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(char);
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  uint32_t insertCount = 0;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    AlfBool inserted;
+    uint32_t* count = alfHashTableFindOrInsert(table, fruitNames[i], &inserted);
+    ALF_CHECK_TRUE(count && (*count == 0) == inserted);
+    insertCount += inserted;
+    (*count)++;
+  }
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == insertCount);
+
+  // Check counts
+  uint32_t* count = alfHashTableGet(table, "B");
+  ALF_CHECK_TRUE(count && *count == 7);
+  count = alfHashTableGet(table, "P");
+  ALF_CHECK_TRUE(count && *count == 13);
+  ALF_CHECK_NULL(alfHashTableGet(table, "Z"));
+
+  // Destroy table
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Freeze", "[Hash Table]")
+{
+  // Freeze table with inline keys
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  const uint32_t count = 10000;
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t key = i * 7;
+    alfHashTableInsert(table, &key, &i);
+  }
+  AlfFrozenHashTable* frozen = alfHashTableFreeze(table);
+  ALF_CHECK_NOT_NULL(frozen);
+  ALF_CHECK_TRUE(alfFrozenHashTableGetSize(frozen) == count);
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < count * 7; i++) {
+    const uint32_t* value = alfFrozenHashTableGet(frozen, &i);
+    found = found && (i % 7 == 0 ? value && *value == i / 7 : value == NULL);
+  }
+  ALF_CHECK_TRUE(found, "Frozen table must contain exactly the keys");
+  alfDestroyFrozenHashTable(frozen);
+
+  // Freeze table where keys of equal length have colliding hashes
+  desc.keySize = 0;
+  desc.hashFunction = HashStringLength;
+  desc.keyEqual = EqualString;
+  desc.keyCopy = CopyStringKey;
+  desc.keyDestructor = free;
+  table = alfCreateHashTable(&desc);
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+  frozen = alfHashTableFreeze(table);
+  ALF_CHECK_NOT_NULL(frozen);
+  found = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    const uint32_t* value = alfFrozenHashTableGet(frozen, fruitNames[i]);
+    found = found && value && *value == numbers0through79[i];
+  }
+  ALF_CHECK_TRUE(found, "Colliding keys must be found in frozen table");
+  ALF_CHECK_FALSE(alfFrozenHashTableHasKey(frozen, "Tomato"));
+  alfDestroyFrozenHashTable(frozen);
+
+  // Freeze table whose hash function only sets the low bits of the hash
+  AlfHashTableDesc identityDesc = { 0 };
+  identityDesc.bucketCount = 16;
+  identityDesc.valueSize = sizeof(uint32_t);
+  identityDesc.keySize = sizeof(uint32_t);
+  identityDesc.hashFunction64 = HashUint32Identity64;
+  table = alfCreateHashTable(&identityDesc);
+  for (uint32_t i = 1; i <= count; i++) {
+    alfHashTableInsert(table, &i, &i);
+  }
+  frozen = alfHashTableFreeze(table);
+  ALF_CHECK_NOT_NULL(frozen);
+  found = ALF_TRUE;
+  for (uint32_t i = 1; i <= count; i++) {
+    const uint32_t* value = alfFrozenHashTableGet(frozen, &i);
+    found = found && value && *value == i;
+  }
+  ALF_CHECK_TRUE(found, "Keys with low-entropy hashes must be found");
+  alfDestroyFrozenHashTable(frozen);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Snapshot", "[Hash Table]")
+{
+  // Save and map table with inline keys and control bytes
+  const char* path = "alf_hash_table_snapshot.bin";
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  desc.layout = ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES;
+  desc.hashSeed = 1234;
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  const uint32_t count = 10000;
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t key = i * 3;
+    alfHashTableInsert(table, &key, &i);
+  }
+  ALF_CHECK_TRUE(alfHashTableSave(table, path));
+  alfDestroyHashTable(table);
+  table = alfHashTableMap(path, &desc);
+  ALF_CHECK_NOT_NULL(table);
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == count);
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < count * 3; i++) {
+    const uint32_t* value = alfHashTableGet(table, &i);
+    found = found && (i % 3 == 0 ? value && *value == i / 3 : value == NULL);
+  }
+  ALF_CHECK_TRUE(found, "Mapped table must contain exactly the keys");
+  alfDestroyHashTable(table);
+
+  // Snapshot must match the descriptor
+  desc.valueSize = sizeof(uint64_t);
+  ALF_CHECK_NULL(alfHashTableMap(path, &desc));
+  ALF_CHECK_NULL(alfHashTableMap("alf_missing_snapshot.bin", NULL));
+
+  // Save and map table with string keys
+  table = alfCreateHashTableSimple(sizeof(uint32_t), NULL);
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+  alfHashTableRemove(table, "Apple", NULL);
+  ALF_CHECK_TRUE(alfHashTableSave(table, path));
+  alfDestroyHashTable(table);
+  table = alfHashTableMap(path, NULL);
+  ALF_CHECK_NOT_NULL(table);
+  found = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    const uint32_t* value = alfHashTableGet(table, fruitNames[i]);
+    found = found && (strcmp(fruitNames[i], "Apple") == 0
+                        ? value == NULL
+                        : value && *value == numbers0through79[i]);
+  }
+  ALF_CHECK_TRUE(found, "Mapped table must contain string keys");
+  ALF_CHECK_FALSE(alfHasKey(table, "Tomato"));
+  alfDestroyHashTable(table);
+
+  // Truncated snapshots must be rejected, also when only keys are cut off
+  const char* truncatedPath = "alf_hash_table_snapshot_truncated.bin";
+  FILE* file = fopen(path, "rb");
+  fseek(file, 0, SEEK_END);
+  const long fileSize = ftell(file);
+  fclose(file);
+  ALF_CHECK_TRUE(CopyFilePrefix(path, truncatedPath, fileSize - 1));
+  ALF_CHECK_NULL(alfHashTableMap(truncatedPath, NULL));
+  ALF_CHECK_TRUE(CopyFilePrefix(path, truncatedPath, fileSize / 2));
+  ALF_CHECK_NULL(alfHashTableMap(truncatedPath, NULL));
+  ALF_CHECK_TRUE(CopyFilePrefix(path, truncatedPath, 16));
+  ALF_CHECK_NULL(alfHashTableMap(truncatedPath, NULL));
+  remove(truncatedPath);
+  remove(path);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Statistics", "[Hash Table]")
+{
+  // Lookup keys that are in the table and keys that are not
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  const uint32_t count = 1000;
+  for (uint32_t i = 0; i < count; i++) {
+    alfHashTableInsert(table, &i, &i);
+  }
+  for (uint32_t i = 0; i < count * 2; i++) {
+    alfHashTableGet(table, &i);
+  }
+
+  // Histograms and resize counters are only gathered when compiled in
+  AlfHashTableStatistics statistics;
+  const AlfBool gathered = alfHashTableGetStatistics(table, &statistics);
+  uint64_t hits = 0, misses = 0;
+  for (uint32_t i = 0; i < ALF_HASH_TABLE_STATISTICS_PROBE_LENGTHS; i++) {
+    hits += statistics.hitProbeLengths[i];
+    misses += statistics.missProbeLengths[i];
+  }
+  ALF_CHECK_TRUE(gathered ? hits == count && misses == count : hits == 0);
+  ALF_CHECK_TRUE(gathered ? statistics.resizeCount > 0 : misses == 0);
+  ALF_CHECK_TRUE(statistics.size == count);
+  ALF_CHECK_TRUE(statistics.bucketCount >= count);
+  ALF_CHECK_TRUE(statistics.allocatedBytes >= statistics.bucketCount * 16);
+  ALF_CHECK_TRUE(statistics.tombstoneCount == 0);
+  alfHashTableResetStatistics(table);
+  alfHashTableGetStatistics(table, &statistics);
+  ALF_CHECK_TRUE(statistics.hitProbeLengths[0] == 0);
+  alfDestroyHashTable(table);
+
+  // Keys of equal length collide and are displaced
+  desc.keySize = 0;
+  desc.hashFunction = HashStringLength;
+  desc.keyEqual = EqualString;
+  desc.keyCopy = CopyStringKey;
+  desc.keyDestructor = free;
+  table = alfCreateHashTable(&desc);
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+  alfHashTableGetStatistics(table, &statistics);
+  ALF_CHECK_TRUE(statistics.maxDisplacement > 0);
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Typed", "[Hash Table]")
+{
+  // Insert and get
+  IntegerTable* table = alfCreateIntegerTable(16);
+  ALF_CHECK_NOT_NULL(table);
+  const uint64_t count = 10000;
+  for (uint64_t i = 0; i < count; i++) {
+    alfIntegerTableInsert(table, i * 5, i);
+  }
+  ALF_CHECK_TRUE(alfIntegerTableGetSize(table) == count);
+  AlfBool found = ALF_TRUE;
+  for (uint64_t i = 0; i < count * 5; i++) {
+    const uint64_t* value = alfIntegerTableGet(table, i);
+    found = found && (i % 5 == 0 ? value && *value == i / 5 : value == NULL);
+  }
+  ALF_CHECK_TRUE(found, "Typed table must contain exactly the keys");
+
+  // Replace and find or insert
+  alfIntegerTableInsert(table, 5, 100);
+  ALF_CHECK_TRUE(*alfIntegerTableGet(table, 5) == 100);
+  AlfBool inserted;
+  uint64_t* value = alfIntegerTableFindOrInsert(table, 7, &inserted);
+  ALF_CHECK_TRUE(inserted && *value == 0);
+  *value = 70;
+  value = alfIntegerTableFindOrInsert(table, 7, &inserted);
+  ALF_CHECK_TRUE(!inserted && *value == 70);
+
+  // Remove every other key
+  uint64_t removed = 0;
+  ALF_CHECK_TRUE(alfIntegerTableRemove(table, 5, &removed));
+  ALF_CHECK_TRUE(removed == 100);
+  ALF_CHECK_FALSE(alfIntegerTableRemove(table, 5, NULL));
+  for (uint64_t i = 0; i < count; i += 2) {
+    alfIntegerTableRemove(table, i * 5, NULL);
+  }
+  found = ALF_TRUE;
+  for (uint64_t i = 0; i < count; i++) {
+    const AlfBool remains = i % 2 == 1 && i != 1;
+    found = found && alfIntegerTableHasKey(table, i * 5) == remains;
+  }
+  ALF_CHECK_TRUE(found, "Removed keys must not remain in typed table");
+  ALF_CHECK_TRUE(alfIntegerTableHasKey(table, 7));
+  alfDestroyIntegerTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Parallel Build", "[Hash Table]")
+{
+  // Keys and values for parallel build
+  const uint32_t count = 100000;
+  uint32_t* numbers = malloc(sizeof(uint32_t) * count * 2);
+  char(*names)[16] = malloc(sizeof(*names) * count);
+  const void** keys = malloc(sizeof(void*) * count);
+  const void** values = malloc(sizeof(void*) * count);
+  for (uint32_t i = 0; i < count; i++) {
+    numbers[i] = i * 7;
+    numbers[count + i] = i;
+    keys[i] = &numbers[i];
+    values[i] = &numbers[count + i];
+  }
+
+  // Build, grow and shrink tables with inline keys in both layouts
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  for (uint32_t layout = 0; layout < 2; layout++) {
+    desc.layout = layout ? ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES
+                         : ALF_HASH_TABLE_LAYOUT_ROBIN_HOOD;
+    AlfHashTable* table = alfHashTableBuildParallel(&desc, keys, values, count, 4);
+    ALF_CHECK_NOT_NULL(table);
+    ALF_CHECK_TRUE(alfHashTableGetSize(table) == count);
+    alfHashTableResizeParallel(table, 1 << 20, 0);
+    alfHashTableResizeParallel(table, 1 << 17, 3);
+    for (uint32_t i = 0; i < count; i += 2) {
+      alfHashTableRemove(table, keys[i], NULL);
+    }
+    AlfBool found = ALF_TRUE;
+    for (uint32_t i = 0; i < count * 7; i++) {
+      const uint32_t* value = alfHashTableGet(table, &i);
+      const AlfBool remains = i % 7 == 0 && (i / 7) % 2 == 1;
+      found = found && (remains ? value && *value == i / 7 : value == NULL);
+    }
+    ALF_CHECK_TRUE(found, "Parallel built table must contain exactly the keys");
+    alfDestroyHashTable(table);
+  }
+
+  // Build table with string keys in the string arena
+  for (uint32_t i = 0; i < count; i++) {
+    snprintf(names[i], sizeof(names[i]), "Name %u", i);
+    keys[i] = names[i];
+  }
+  desc = (AlfHashTableDesc){ 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keyEqual = EqualString;
+  desc.keyStorage = ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA;
+  AlfHashTable* table = alfHashTableBuildParallel(&desc, keys, values, count, 0);
+  ALF_CHECK_NOT_NULL(table);
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < count; i++) {
+    const uint32_t* value = alfHashTableGet(table, names[i]);
+    found = found && value && *value == i;
+  }
+  ALF_CHECK_TRUE(found, "String keys must be found in parallel built table");
+  ALF_CHECK_FALSE(alfHasKey(table, "Name"));
+  ALF_CHECK_TRUE(alfHashTableInsert(table, "Name", &count));
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == count + 1);
+  alfDestroyHashTable(table);
+
+  free(values);
+  free(keys);
+  free(names);
+  free(numbers);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Merge", "[Hash Table]")
+{
+  // Merge tables with string keys, where some keys are in both
+  AlfHashTable* table = alfCreateHashTableSimple(sizeof(uint32_t), NULL);
+  AlfHashTable* other = alfCreateHashTableSimple(sizeof(uint32_t), NULL);
+  const uint32_t one = 1;
+  uint64_t size = 0;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    if (i % 3 != 0) {
+      alfHashTableInsert(table, fruitNames[i], &one);
+    }
+    if (i % 2 == 0) {
+      alfHashTableInsert(other, fruitNames[i], &numbers0through79[i]);
+    }
+    size += i % 3 != 0 || i % 2 == 0;
+  }
+  ALF_CHECK_TRUE(alfHashTableMerge(table, other, CombineSum));
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    const uint32_t* value = alfHashTableGet(table, fruitNames[i]);
+    const uint32_t expected = (i % 3 != 0 ? 1 : 0) +
+                              (i % 2 == 0 ? numbers0through79[i] : 0);
+    found = found && (i % 3 != 0 || i % 2 == 0 ? value && *value == expected
+                                               : value == NULL);
+  }
+  ALF_CHECK_TRUE(found, "Merged values must be combined");
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == size);
+  alfDestroyHashTable(other);
+  ALF_CHECK_TRUE(*(uint32_t*)alfHashTableGet(table, fruitNames[0]) == 0);
+  alfDestroyHashTable(table);
+
+  // Count keys in one partitioned table per worker, then merge them
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  desc.layout = ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES;
+  AlfPartitionedHashTable* workers[4];
+  for (uint32_t w = 0; w < 4; w++) {
+    workers[w] = alfCreatePartitionedHashTable(&desc, 8);
+    ALF_CHECK_NOT_NULL(workers[w]);
+    for (uint32_t i = 0; i < 20000; i++) {
+      const uint32_t key = (i * 7 + w * 5000) % 30000;
+      (*(uint32_t*)alfPartitionedHashTableFindOrInsert(workers[w], &key, NULL))++;
+    }
+  }
+  ALF_CHECK_TRUE(alfPartitionedHashTableGetPartitionCount(workers[0]) == 8);
+  ALF_CHECK_TRUE(alfPartitionedHashTableMerge(workers[0], workers[1], CombineSum));
+  ALF_CHECK_TRUE(
+    alfPartitionedHashTableMergeParallel(workers[0], workers[2], CombineSum, 3));
+  ALF_CHECK_TRUE(
+    alfPartitionedHashTableMergeParallel(workers[0], workers[3], CombineSum, 0));
+  uint32_t counts[30000] = { 0 };
+  for (uint32_t w = 0; w < 4; w++) {
+    for (uint32_t i = 0; i < 20000; i++) {
+      counts[(i * 7 + w * 5000) % 30000]++;
+    }
+  }
+  found = ALF_TRUE;
+  size = 0;
+  for (uint32_t key = 0; key < 30000; key++) {
+    const uint32_t* value = alfPartitionedHashTableGet(workers[0], &key);
+    found = found && (counts[key] ? value && *value == counts[key] : !value);
+    size += counts[key] != 0;
+  }
+  ALF_CHECK_TRUE(found, "Merged partitioned table must contain the counts");
+  ALF_CHECK_TRUE(alfPartitionedHashTableGetSize(workers[0]) == size);
+  for (uint32_t i = 0; i < 8; i++) {
+    AlfHashTable* partition = alfPartitionedHashTableGetPartition(workers[0], i);
+    found = found && alfHashTableGetSize(partition) > 0;
+  }
+  ALF_CHECK_TRUE(found, "Keys must be spread over all partitions");
+
+  // Keys whose hashes only use the low bits must also be spread
+  AlfHashTableDesc identityDesc = desc;
+  identityDesc.hashFunction64 = HashUint32Identity64;
+  AlfPartitionedHashTable* identity =
+    alfCreatePartitionedHashTable(&identityDesc, 8);
+  for (uint32_t i = 1; i <= 1000; i++) {
+    alfPartitionedHashTableInsert(identity, &i, &i);
+  }
+  found = ALF_TRUE;
+  for (uint32_t i = 0; i < 8; i++) {
+    AlfHashTable* partition = alfPartitionedHashTableGetPartition(identity, i);
+    found = found && alfHashTableGetSize(partition) > 0;
+  }
+  ALF_CHECK_TRUE(found, "Low-entropy hashes must be spread over partitions");
+  alfDestroyPartitionedHashTable(identity);
+  const uint32_t key = 0;
+  ALF_CHECK_TRUE(alfPartitionedHashTableRemove(workers[0], &key, NULL));
+  ALF_CHECK_NULL(alfPartitionedHashTableGet(workers[0], &key));
+  for (uint32_t w = 0; w < 4; w++) {
+    alfDestroyPartitionedHashTable(workers[w]);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Bounded Cache", "[Hash Table]")
+{
+  // Cache with a capacity of 100 entries
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 128;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  desc.valueCleaner = CountCleanedValue;
+  AlfBoundedCache* cache = alfCreateBoundedCache(&desc, 100);
+  ALF_CHECK_NOT_NULL(cache);
+  cleanedValueCount = 0;
+
+  // Keys that are used often must survive eviction
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < 1000; i++) {
+    found = found && alfBoundedCacheInsert(cache, &i, &i);
+    for (uint32_t key = 0; key < 10; key++) {
+      alfBoundedCacheGet(cache, &key);
+    }
+  }
+  ALF_CHECK_TRUE(found, "Values must be inserted into cache");
+  ALF_CHECK_TRUE(alfBoundedCacheGetSize(cache) == 100);
+  for (uint32_t key = 0; key < 10; key++) {
+    const uint32_t* value = alfBoundedCacheGet(cache, &key);
+    found = found && value && *value == key;
+  }
+  ALF_CHECK_TRUE(found, "Recently used keys must not be evicted");
+  const uint32_t last = 999;
+  ALF_CHECK_NOT_NULL(alfBoundedCacheGet(cache, &last));
+  ALF_CHECK_TRUE(cleanedValueCount == 900);
+
+  // Statistics
+  AlfBoundedCacheStatistics statistics;
+  alfBoundedCacheGetStatistics(cache, &statistics);
+  ALF_CHECK_TRUE(statistics.insertCount == 1000);
+  ALF_CHECK_TRUE(statistics.evictionCount == 900);
+  ALF_CHECK_TRUE(statistics.hitCount + statistics.missCount == 10011);
+  ALF_CHECK_TRUE(statistics.size == 100 && statistics.weight == 100);
+  alfBoundedCacheResetStatistics(cache);
+  const uint32_t missing = 5000;
+  ALF_CHECK_NULL(alfBoundedCacheGet(cache, &missing));
+  alfBoundedCacheGetStatistics(cache, &statistics);
+  ALF_CHECK_TRUE(statistics.missCount == 1 && statistics.hitCount == 0);
+
+  // Replace and remove
+  const uint32_t key = 3, value = 30;
+  ALF_CHECK_TRUE(alfBoundedCacheInsert(cache, &key, &value));
+  ALF_CHECK_TRUE(*(uint32_t*)alfBoundedCacheGet(cache, &key) == 30);
+  ALF_CHECK_TRUE(alfBoundedCacheGetSize(cache) == 100);
+  uint32_t removed = 0;
+  ALF_CHECK_TRUE(alfBoundedCacheRemove(cache, &key, &removed));
+  ALF_CHECK_TRUE(removed == 30);
+  ALF_CHECK_FALSE(alfBoundedCacheRemove(cache, &key, NULL));
+  cleanedValueCount = 0;
+  alfDestroyBoundedCache(cache);
+  ALF_CHECK_TRUE(cleanedValueCount == 99);
+
+  // Cache with a capacity in bytes
+  cache = alfCreateBoundedCache(&desc, 1000);
+  for (uint32_t i = 0; i < 500; i++) {
+    found = found && alfBoundedCacheInsertWeighted(cache, &i, &i, 10 + i % 50);
+    alfBoundedCacheGetStatistics(cache, &statistics);
+    found = found && statistics.weight <= 1000;
+  }
+  ALF_CHECK_TRUE(found, "Weight of cache must not exceed capacity");
+  ALF_CHECK_FALSE(alfBoundedCacheInsertWeighted(cache, &missing, &missing, 1001));
+  alfDestroyBoundedCache(cache);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Ordered", "[Hash Table]")
+{
+  // Insert keys in an order that is unrelated to their hashes
+  AlfHashTableDesc desc = { 0 };
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  AlfOrderedHashTable* table = alfCreateOrderedHashTable(&desc);
+  ALF_CHECK_NOT_NULL(table);
+  AlfBool all = ALF_TRUE;
+  for (uint32_t i = 0; i < 100; i++) {
+    const uint32_t key = (i * 37) % 101;
+    all = all && alfOrderedHashTableInsert(table, &key, &i);
+  }
+
+  // Remove, replace and reinsert
+  for (uint32_t i = 0; i < 100; i += 3) {
+    const uint32_t key = (i * 37) % 101;
+    all = all && alfOrderedHashTableRemove(table, &key, NULL);
+  }
+  ALF_CHECK_TRUE(all, "Keys must be inserted and removed");
+  const uint32_t first = 0, value = 1000;
+  const uint32_t second = 37;
+  ALF_CHECK_TRUE(alfOrderedHashTableInsert(table, &second, &value));
+  ALF_CHECK_TRUE(alfOrderedHashTableInsert(table, &first, &value));
+  ALF_CHECK_TRUE(alfOrderedHashTableGetSize(table) == 67);
+
+  // Iteration must follow insertion order
+  orderedKeyCount = 0;
+  ALF_CHECK_TRUE(alfOrderedHashTableIterate(table, CollectOrderedKey));
+  AlfBool ordered = orderedKeyCount == 67;
+  uint32_t n = 0;
+  for (uint32_t i = 1; i < 100 && ordered; i++) {
+    if (i % 3 != 0) {
+      ordered = orderedKeys[n++] == (i * 37) % 101;
+    }
+  }
+  ordered = ordered && orderedKeys[66] == first;
+  ALF_CHECK_TRUE(ordered, "Ordered table must iterate in insertion order");
+  ALF_CHECK_TRUE(*(uint32_t*)alfOrderedHashTableGet(table, &second) == 1000);
+
+  // Removing most keys compacts the entries
+  for (uint32_t key = 0; key < 200; key++) {
+    if (key != 2 && key != 5) {
+      alfOrderedHashTableRemove(table, &key, NULL);
+    }
+  }
+  AlfBool inserted;
+  const uint32_t third = 500;
+  uint32_t* found = alfOrderedHashTableFindOrInsert(table, &third, &inserted);
+  ALF_CHECK_TRUE(inserted && *found == 0);
+  orderedKeyCount = 0;
+  alfOrderedHashTableIterate(table, CollectOrderedKey);
+  ALF_CHECK_TRUE(orderedKeyCount == 3 && orderedKeys[2] == third);
+  ALF_CHECK_FALSE(alfOrderedHashTableHasKey(table, &first));
+  ALF_CHECK_TRUE(alfOrderedHashTableHasKey(table, &third));
+  alfDestroyOrderedHashTable(table);
+
+  // String keys in the string arena
+  desc = (AlfHashTableDesc){ 0 };
+  desc.valueSize = sizeof(uint32_t);
+  desc.keyEqual = EqualString;
+  desc.keyStorage = ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA;
+  table = alfCreateOrderedHashTable(&desc);
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    alfOrderedHashTableInsert(table, fruitNames[i], &numbers0through79[i]);
+  }
+  all = ALF_TRUE;
+  for (uint32_t i = 0; i < fruitNamesCount; i++) {
+    const uint32_t* fruit = alfOrderedHashTableGet(table, fruitNames[i]);
+    all = all && fruit && *fruit == numbers0through79[i];
+  }
+  ALF_CHECK_TRUE(all, "String keys must be found in ordered table");
+  alfDestroyOrderedHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Filter", "[Hash Table]")
+{
+  // Inserted keys are always found and few other keys are
+  AlfFilterDesc filterDesc = { 0 };
+  filterDesc.capacity = 10000;
+  filterDesc.keySize = sizeof(uint64_t);
+  for (uint32_t n = 0; n < 2; n++) {
+    filterDesc.type =
+      n == 0 ? ALF_FILTER_TYPE_BLOCKED_BLOOM : ALF_FILTER_TYPE_CUCKOO;
+    AlfFilter* filter = alfCreateFilter(&filterDesc);
+    AlfBool found = ALF_TRUE;
+    for (uint64_t i = 0; i < filterDesc.capacity; i++) {
+      found = found && alfFilterInsert(filter, &i);
+    }
+    for (uint64_t i = 0; i < filterDesc.capacity; i++) {
+      found = found && alfFilterMayContain(filter, &i);
+    }
+    ALF_CHECK_TRUE(found, "Filter must contain all inserted keys");
+    uint32_t falsePositives = 0;
+    for (uint64_t i = filterDesc.capacity; i < filterDesc.capacity * 11; i++) {
+      falsePositives += alfFilterMayContain(filter, &i);
+    }
+    ALF_CHECK_TRUE(falsePositives < (n == 0 ? 2000u : 100u));
+
+    // Only cuckoo filters remove keys
+    const uint64_t key = 0;
+    ALF_CHECK_TRUE(alfFilterRemove(filter, &key) == (n == 1));
+    ALF_CHECK_TRUE(alfFilterGetSize(filter) == filterDesc.capacity - n);
+    alfDestroyFilter(filter);
+  }
+
+  // Tables with filters find the same keys through growth and removal
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint64_t);
+  desc.keySize = sizeof(uint64_t);
+  const uint64_t count = 5000;
+  for (uint32_t n = 0; n < 2; n++) {
+    AlfHashTable* table = alfCreateHashTable(&desc);
+    ALF_CHECK_TRUE(alfHashTableEnableFilter(
+      table, n == 0 ? ALF_FILTER_TYPE_BLOCKED_BLOOM : ALF_FILTER_TYPE_CUCKOO));
+    for (uint64_t i = 0; i < count; i++) {
+      alfHashTableInsert(table, &i, &i);
+    }
+    for (uint64_t i = 0; i < count; i += 2) {
+      alfHashTableRemove(table, &i, NULL);
+    }
+    AlfBool found = ALF_TRUE;
+    for (uint64_t i = 0; i < count * 2; i++) {
+      const uint64_t* value = alfHashTableGet(table, &i);
+      found = found && (i < count && i % 2 ? value && *value == i : !value);
+    }
+    ALF_CHECK_TRUE(found, "Filtered table must find exactly its keys");
+
+    // Keys that the filter rejects are inserted by find-or-insert
+    found = ALF_TRUE;
+    for (uint64_t i = 0; i < count; i++) {
+      AlfBool inserted;
+      alfHashTableFindOrInsert(table, &i, &inserted);
+      found = found && inserted == (i % 2 == 0);
+    }
+    ALF_CHECK_TRUE(found, "Find-or-insert must only insert missing keys");
+    ALF_CHECK_TRUE(alfHashTableGetSize(table) == count);
+    alfHashTableDisableFilter(table);
+    ALF_CHECK_TRUE(alfHasKey(table, &count) == ALF_FALSE);
+    alfDestroyHashTable(table);
+  }
+
+  // A cuckoo filter cannot hold many entries with the same hash, the table 
+  // then drops the filter instead of growing it
+  desc.hashFunction64 = HashUint64Low4Bits;
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  alfHashTableEnableFilter(table, ALF_FILTER_TYPE_CUCKOO);
+  for (uint64_t i = 0; i < 2000; i++) {
+    alfHashTableInsert(table, &i, &i);
+  }
+  AlfBool found = ALF_TRUE;
+  for (uint64_t i = 0; i < 2000; i++) {
+    const uint64_t* value = alfHashTableGet(table, &i);
+    found = found && value && *value == i;
+  }
+  ALF_CHECK_TRUE(found, "Entries with equal hashes must be found");
+  ALF_CHECK_TRUE(alfHashTableGetSize(table) == 2000);
+  alfDestroyHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Huge Pages", "[Hash Table]")
+{
+  // Grow past the huge page size, through both layouts and an incremental
+  // resize, so that mapped buckets are freed by each path
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint64_t);
+  desc.keySize = sizeof(uint64_t);
+  desc.pages = ALF_HASH_TABLE_PAGES_HUGE;
+  const uint64_t count = 200000;
+  for (uint32_t n = 0; n < 2; n++) {
+    desc.layout = n == 0 ? ALF_HASH_TABLE_LAYOUT_ROBIN_HOOD
+                         : ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES;
+    AlfHashTable* table = alfCreateHashTable(&desc);
+    alfHashTableSetIncrementalResize(table, n == 0 ? 0 : 64);
+    for (uint64_t i = 0; i < count; i++) {
+      alfHashTableInsert(table, &i, &i);
+    }
+    AlfBool found = ALF_TRUE;
+    for (uint64_t i = 0; i < count; i += 2) {
+      uint64_t* value = alfHashTableGet(table, &i);
+      found = found && value && *value == i;
+      found = found && alfHashTableRemove(table, &i, NULL);
+    }
+    ALF_CHECK_TRUE(found, "Huge page table must contain all keys");
+    ALF_CHECK_TRUE(alfHashTableGetSize(table) == count / 2);
+
+    // Resize with mapped buckets on both sides
+    alfHashTableResize(table, 1u << 19);
+    alfHashTableResize(table, 1u << 18);
+    found = ALF_TRUE;
+    for (uint64_t i = 1; i < count; i += 2) {
+      found = found && alfHasKey(table, &i);
+    }
+    ALF_CHECK_TRUE(found, "Resized huge page table must contain all keys");
+    alfDestroyHashTable(table);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Allocator", "[Hash Table]")
+{
+  // Count the memory of collections, which must all be returned
+  AlfCountingAllocator* counting = alfCreateCountingAllocator(NULL);
+  AlfAllocator countingAllocator = alfCountingAllocatorGetAllocator(counting);
+  AlfArrayListDesc listDesc = { 0 };
+  listDesc.objectSize = sizeof(uint32_t);
+  listDesc.capacity = 1;
+  listDesc.allocator = &countingAllocator;
+  AlfArrayList* list = alfCreateArrayList(&listDesc);
+  AlfStackDesc stackDesc = { 0 };
+  stackDesc.objectSize = sizeof(uint32_t);
+  stackDesc.capacity = 1;
+  stackDesc.allocator = &countingAllocator;
+  AlfStack* stack = alfCreateStack(&stackDesc);
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < 1000; i++) {
+    alfArrayListAdd(list, &i);
+    found = found && alfStackPush(stack, &i);
+  }
+  alfArrayListShrinkToFit(list);
+  found = found && alfStackResize(stack, 10);
+  for (uint32_t i = 0; i < 1000; i++) {
+    found = found && *(uint32_t*)alfArrayListGet(list, i) == i;
+  }
+  for (uint32_t i = 10; i > 0; i--) {
+    uint32_t value;
+    found = found && alfStackPop(stack, &value) && value == i - 1;
+  }
+  ALF_CHECK_TRUE(found, "Lists must keep their objects when reallocated");
+  alfDestroyArrayList(list);
+  alfDestroyStack(stack);
+
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keyEqual = EqualString;
+  desc.keyStorage = ALF_HASH_TABLE_KEY_STORAGE_STRING_ARENA;
+  desc.allocator = &countingAllocator;
+  AlfHashTable* table = alfCreateHashTable(&desc);
+  alfHashTableEnableFilter(table, ALF_FILTER_TYPE_BLOCKED_BLOOM);
+  char key[32];
+  for (uint32_t i = 0; i < 1000; i++) {
+    sprintf(key, "key%u", i);
+    alfHashTableInsert(table, key, &i);
+  }
+  AlfAllocatorStatistics statistics;
+  alfCountingAllocatorGetStatistics(counting, &statistics);
+  ALF_CHECK_TRUE(statistics.currentBytes > 0);
+  alfDestroyFrozenHashTable(alfHashTableFreeze(table));
+  alfCountingAllocatorGetStatistics(counting, &statistics);
+  ALF_CHECK_TRUE(statistics.reallocationCount > 0);
+  ALF_CHECK_TRUE(statistics.allocationCount == statistics.freeCount);
+  ALF_CHECK_TRUE(statistics.currentBytes == 0, "All memory must be freed");
+
+  // Lists that are allocated last in an arena grow without moving
+  AlfArenaAllocator* arena = alfCreateArenaAllocator(&countingAllocator, 0);
+  AlfAllocator arenaAllocator = alfArenaAllocatorGetAllocator(arena);
+  listDesc.allocator = &arenaAllocator;
+  list = alfCreateArrayList(&listDesc);
+  uint32_t value = 0;
+  alfArrayListAdd(list, &value);
+  const uint8_t* data = alfArrayListGetData(list);
+  for (value = 1; value < 1000; value++) {
+    alfArrayListAdd(list, &value);
+  }
+  ALF_CHECK_TRUE(alfArrayListGetData(list) == data);
+  alfDestroyArrayList(list);
+  alfDestroyArenaAllocator(arena);
+
+  // Small lists are allocated from one block of a pool
+  AlfPoolAllocator* pool = alfCreatePoolAllocator(&countingAllocator, 128, 0);
+  AlfAllocator poolAllocator = alfPoolAllocatorGetAllocator(pool);
+  AlfListDesc pointerListDesc = { 0 };
+  pointerListDesc.capacity = 4;
+  pointerListDesc.allocator = &poolAllocator;
+  AlfList* lists[16];
+  for (uint32_t i = 0; i < 16; i++) {
+    lists[i] = alfCreateList(&pointerListDesc);
+    alfListAdd(lists[i], lists);
+  }
+  for (uint32_t i = 0; i < 16; i++) {
+    alfDestroyList(lists[i]);
+  }
+  alfCountingAllocatorGetStatistics(counting, &statistics);
+  const uint64_t allocationCount = statistics.allocationCount;
+  for (uint32_t i = 0; i < 16; i++) {
+    lists[i] = alfCreateList(&pointerListDesc);
+  }
+  for (uint32_t i = 0; i < 16; i++) {
+    alfDestroyList(lists[i]);
+  }
+  alfCountingAllocatorGetStatistics(counting, &statistics);
+  ALF_CHECK_TRUE(statistics.allocationCount == allocationCount);
+  alfDestroyPoolAllocator(pool);
+  alfCountingAllocatorGetStatistics(counting, &statistics);
+  ALF_CHECK_TRUE(statistics.currentBytes == 0, "All memory must be freed");
+  alfDestroyCountingAllocator(counting);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Allocation Failure", "[Hash Table]")
+{
+  // Tables are not created without buckets
+  uint32_t allocationsLeft = 1;
+  AlfAllocator allocator = { AllocLimited, NULL, FreeLimited, &allocationsLeft };
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  desc.allocator = &allocator;
+  ALF_CHECK_NULL(alfCreateHashTable(&desc));
+
+  // Tables that cannot grow keep their buckets and entries
+  for (uint32_t n = 0; n < 2; n++) {
+    desc.layout = n == 0 ? ALF_HASH_TABLE_LAYOUT_ROBIN_HOOD
+                         : ALF_HASH_TABLE_LAYOUT_CONTROL_BYTES;
+    allocationsLeft = 3;
+    AlfHashTable* table = alfCreateHashTable(&desc);
+    ALF_CHECK_NOT_NULL(table);
+    allocationsLeft = 0;
+    uint32_t inserted = 0;
+    for (uint32_t i = 0; i < 100; i++) {
+      inserted += alfHashTableInsert(table, &i, &i);
+    }
+    alfHashTableResize(table, 64);
+    ALF_CHECK_TRUE(inserted > 0 && inserted < 16);
+    ALF_CHECK_TRUE(alfHashTableGetSize(table) == inserted);
+    AlfBool found = ALF_TRUE;
+    for (uint32_t i = 0; i < inserted; i++) {
+      const uint32_t* value = alfHashTableGet(table, &i);
+      found = found && value && *value == i;
+    }
+    ALF_CHECK_TRUE(found, "Entries must be kept when the table cannot grow");
+    alfDestroyHashTable(table);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Sort", "[Array List]")
+{
+  // Sort objects of each specialized swap size and of other sizes, with input
+  // patterns that make a quicksort with a fixed pivot quadratic. Objects start
+  // with their key and repeat its low byte, to check that they move intact
+  const uint32_t objectSizes[] = { 4, 8, 12, 16, 32, 100 };
+  const uint32_t count = 20000;
+  for (uint32_t n = 0; n < 6; n++) {
+    AlfBool sorted = ALF_TRUE;
+    for (uint32_t pattern = 0; pattern < 6; pattern++) {
+      AlfArrayList* list =
+        alfCreateArrayListForObjectSize(objectSizes[n], NULL);
+      uint8_t object[100];
+      uint32_t state = 1;
+      uint64_t sum = 0;
+      for (uint32_t i = 0; i < count; i++) {
+        state = state * 1664525u + 1013904223u;
+        const uint32_t key = pattern == 0   ? state >> 8
+                             : pattern == 1 ? i
+                             : pattern == 2 ? count - i
+                             : pattern == 3 ? 7
+                             : pattern == 4 ? i % 64
+                                            : (i < count / 2 ? i : count - i);
+        memset(object, (uint8_t)key, sizeof(object));
+        memcpy(object, &key, sizeof(uint32_t));
+        alfArrayListAdd(list, object);
+        sum += key;
+      }
+      alfArrayListSort(list, CompareUint32Key);
+      for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* sortedObject = alfArrayListGet(list, i);
+        uint32_t key;
+        memcpy(&key, sortedObject, sizeof(uint32_t));
+        sorted = sorted && (i == 0 || CompareUint32Key(
+                                        sortedObject - objectSizes[n],
+                                        sortedObject) <= 0);
+        sorted = sorted && (objectSizes[n] == sizeof(uint32_t) ||
+                            sortedObject[objectSizes[n] - 1] == (uint8_t)key);
+        sum -= key;
+      }
+      sorted = sorted && sum == 0;
+      alfDestroyArrayList(list);
+    }
+    ALF_CHECK_TRUE(sorted, "Array-list must be sorted with intact objects");
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Radix Sort", "[Array List]")
+{
+  // Objects hold their insertion index followed by a key. Each case sorts by a
+  // different key type and width, and checks the order of the keys and that
+  // objects with equal keys keep their insertion order
+  typedef struct RadixObject
+  {
+    uint32_t index;
+    uint32_t pad;
+    union
+    {
+      uint16_t u16;
+      uint32_t u32;
+      int64_t s64;
+      float f32;
+      double f64;
+    } key;
+  } RadixObject;
+  const uint32_t count = 5000;
+  for (uint32_t type = 0; type < 6; type++) {
+    AlfArrayList* list = alfCreateArrayListForObjectSize(sizeof(RadixObject),
+                                                         NULL);
+    uint64_t state = 1;
+    for (uint32_t i = 0; i < count; i++) {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      const uint32_t random = (uint32_t)(state >> 33);
+      RadixObject object = { 0 };
+      object.index = i;
+      if (type == 0) {
+        object.key.u16 = (uint16_t)random;
+      } else if (type == 1) {
+        object.key.s64 = (int64_t)(state ^ (state >> 29)) >> (random % 60);
+      } else if (type == 2) {
+        object.key.f32 = ((float)(random % 2000) - 1000.0f) / 8.0f;
+      } else if (type == 3) {
+        object.key.f64 = ((double)random - 1073741824.0) * 1e-3;
+      } else if (type == 4) {
+        object.key.u32 = 0xAB00CD00u | (random & 0xFF);
+      } else {
+        object.key.u32 = 42;
+      }
+      alfArrayListAdd(list, &object);
+    }
+
+    const uint32_t widths[] = { 2, 8, 4, 8, 4, 4 };
+    const AlfArrayListKeyType types[] = {
+      ALF_ARRAY_LIST_KEY_TYPE_UNSIGNED, ALF_ARRAY_LIST_KEY_TYPE_SIGNED,
+      ALF_ARRAY_LIST_KEY_TYPE_FLOAT,    ALF_ARRAY_LIST_KEY_TYPE_FLOAT,
+      ALF_ARRAY_LIST_KEY_TYPE_UNSIGNED, ALF_ARRAY_LIST_KEY_TYPE_UNSIGNED
+    };
+    ALF_CHECK_TRUE(alfArrayListRadixSort(
+      list, offsetof(RadixObject, key), widths[type], types[type]));
+
+    AlfBool sorted = ALF_TRUE;
+    uint64_t indexSum = 0;
+    for (uint32_t i = 1; i < count; i++) {
+      const RadixObject* a = alfArrayListGet(list, i - 1);
+      const RadixObject* b = alfArrayListGet(list, i);
+      const int order =
+        type == 0   ? (a->key.u16 > b->key.u16) - (a->key.u16 < b->key.u16)
+        : type == 1 ? (a->key.s64 > b->key.s64) - (a->key.s64 < b->key.s64)
+        : type == 2 ? (a->key.f32 > b->key.f32) - (a->key.f32 < b->key.f32)
+        : type == 3 ? (a->key.f64 > b->key.f64) - (a->key.f64 < b->key.f64)
+                    : (a->key.u32 > b->key.u32) - (a->key.u32 < b->key.u32);
+      sorted = sorted && (order < 0 || (order == 0 && a->index < b->index));
+      indexSum += b->index;
+    }
+    indexSum += ((RadixObject*)alfArrayListGet(list, 0))->index;
+    ALF_CHECK_TRUE(sorted, "Array-list must be stably sorted by the key");
+    ALF_CHECK_TRUE(indexSum == (uint64_t)count * (count - 1) / 2);
+    alfDestroyArrayList(list);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Parallel Sort", "[Array List]")
+{
+  // Objects hold a key with many duplicates followed by their insertion index.
+  // Sort with an odd and an even number of threads, with the hardware thread
+  // count and with a list that is too small to divide
+  const uint32_t counts[] = { 100000, 100000, 100000, 1000 };
+  const uint32_t threadCounts[] = { 3, 4, 0, 4 };
+  for (uint32_t n = 0; n < 4; n++) {
+    for (uint32_t stable = 0; stable < 2; stable++) {
+      AlfArrayList* list =
+        alfCreateArrayListForObjectSize(sizeof(uint32_t) * 2, NULL);
+      uint32_t state = 1;
+      for (uint32_t i = 0; i < counts[n]; i++) {
+        state = state * 1664525u + 1013904223u;
+        const uint32_t object[2] = { (state >> 8) % 1000, i };
+        alfArrayListAdd(list, object);
+      }
+      if (stable) {
+        ALF_CHECK_TRUE(alfArrayListSortParallelStable(
+          list, CompareUint32Key, threadCounts[n]));
+      } else {
+        alfArrayListSortParallel(list, CompareUint32Key, threadCounts[n]);
+      }
+
+      AlfBool sorted = ALF_TRUE;
+      uint64_t indexSum = ((uint32_t*)alfArrayListGet(list, 0))[1];
+      for (uint32_t i = 1; i < counts[n]; i++) {
+        const uint32_t* a = alfArrayListGet(list, i - 1);
+        const uint32_t* b = alfArrayListGet(list, i);
+        sorted = sorted && a[0] <= b[0];
+        sorted = sorted && (!stable || a[0] < b[0] || a[1] < b[1]);
+        indexSum += b[1];
+      }
+      ALF_CHECK_TRUE(sorted, "Array-list must be sorted");
+      ALF_CHECK_TRUE(indexSum == (uint64_t)counts[n] * (counts[n] - 1) / 2);
+      alfDestroyArrayList(list);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Sorted", "[Array List]")
+{
+  // Build a sorted list with runs of equal keys by inserting in random order
+  AlfArrayList* list = alfCreateArrayListForObjectSize(sizeof(uint32_t), NULL);
+  uint32_t state = 1;
+  AlfBool inserted = ALF_TRUE;
+  for (uint32_t i = 0; i < 3000; i++) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t key = ((state >> 8) % 1000) * 2;
+    const uint64_t index = alfArrayListInsertSorted(list, &key, CompareUint32Key);
+    inserted = inserted && *(uint32_t*)alfArrayListGet(list, index) == key;
+  }
+  ALF_CHECK_TRUE(inserted, "Sorted insert must return index of object");
+  AlfBool sorted = ALF_TRUE;
+  for (uint32_t i = 1; i < alfGetArrayListSize(list); i++) {
+    sorted = sorted && *(uint32_t*)alfArrayListGet(list, i - 1) <=
+                         *(uint32_t*)alfArrayListGet(list, i);
+  }
+  ALF_CHECK_TRUE(sorted, "Sorted insert must keep array-list sorted");
+
+  // Compare searches with a linear scan, for present and missing keys
+  AlfEytzingerArray* array = alfCreateEytzingerArray(list);
+  ALF_CHECK_NOT_NULL(array);
+  AlfBool matching = ALF_TRUE;
+  for (uint32_t key = 0; key <= 2002; key++) {
+    uint64_t lower = 0;
+    while (lower < alfGetArrayListSize(list) &&
+           *(uint32_t*)alfArrayListGet(list, lower) < key) {
+      lower++;
+    }
+    uint64_t upper = lower;
+    while (upper < alfGetArrayListSize(list) &&
+           *(uint32_t*)alfArrayListGet(list, upper) == key) {
+      upper++;
+    }
+    uint64_t index = UINT64_MAX;
+    uint64_t eytzingerIndex = UINT64_MAX;
+    const AlfBool found =
+      alfArrayListBinarySearch(list, &key, CompareUint32Key, &index);
+    const AlfBool eytzingerFound =
+      alfEytzingerArrayFind(array, &key, CompareUint32Key, &eytzingerIndex);
+    matching = matching &&
+               alfArrayListLowerBound(list, &key, CompareUint32Key) == lower &&
+               alfArrayListUpperBound(list, &key, CompareUint32Key) == upper &&
+               alfEytzingerArrayLowerBound(array, &key, CompareUint32Key) ==
+                 lower &&
+               found == (upper > lower) && index == lower &&
+               eytzingerFound == found &&
+               (!found || eytzingerIndex == lower);
+  }
+  ALF_CHECK_TRUE(matching, "Searches must match a linear scan");
+  alfDestroyEytzingerArray(array);
+
+  // Merge lists of odd keys, one of them empty, with the list of even keys
+  AlfArrayList* lists[4];
+  lists[0] = list;
+  for (uint32_t i = 1; i < 4; i++) {
+    lists[i] = alfCreateArrayListForObjectSize(sizeof(uint32_t), NULL);
+    for (uint32_t key = i; i < 3 && key < 2000; key += 4) {
+      alfArrayListAdd(lists[i], &key);
+    }
+  }
+  AlfArrayList* merged =
+    alfCreateArrayListForObjectSize(sizeof(uint32_t), NULL);
+  ALF_CHECK_TRUE(alfArrayListMergeSorted(
+    merged, (const AlfArrayList* const*)lists, 4, CompareUint32Key));
+  ALF_CHECK_TRUE(alfGetArrayListSize(merged) == 3000 + 1000);
+  sorted = ALF_TRUE;
+  for (uint32_t i = 1; i < alfGetArrayListSize(merged); i++) {
+    sorted = sorted && *(uint32_t*)alfArrayListGet(merged, i - 1) <=
+                         *(uint32_t*)alfArrayListGet(merged, i);
+  }
+  ALF_CHECK_TRUE(sorted, "Merged array-list must be sorted");
+  alfDestroyArrayList(merged);
+  for (uint32_t i = 0; i < 4; i++) {
+    alfDestroyArrayList(lists[i]);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Range", "[Array List]")
+{
+  // Insert ranges at the end, the start and the middle, and past the end
+  AlfArrayList* list = alfCreateArrayListForObjectSize(sizeof(uint32_t), NULL);
+  const uint32_t objects[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+  alfArrayListAddRange(list, objects + 8, 4);
+  alfArrayListInsertRange(list, objects, 2, 0);
+  alfArrayListInsertRange(list, objects + 2, 6, 2);
+  alfArrayListInsertRange(list, objects, 0, 3);
+  ALF_CHECK_TRUE(alfGetArrayListSize(list) == 12);
+  ALF_CHECK_MEM_EQ(alfArrayListGetData(list), objects, sizeof(objects));
+
+  // Remove a range, and a range that extends past the end
+  uint32_t removed[3];
+  alfArrayListRemoveRange(list, 2, 3, removed);
+  ALF_CHECK_MEM_EQ(removed, objects + 2, sizeof(removed));
+  alfArrayListRemoveRange(list, 7, 100, NULL);
+  const uint32_t remaining[] = { 0, 1, 5, 6, 7, 8, 9 };
+  ALF_CHECK_TRUE(alfGetArrayListSize(list) == 7);
+  ALF_CHECK_MEM_EQ(alfArrayListGetData(list), remaining, sizeof(remaining));
+
+  // Remove odd objects
+  ALF_CHECK_TRUE(alfArrayListRemoveIf(list, IsOddUint32, NULL) == 4);
+  const uint32_t even[] = { 0, 6, 8 };
+  ALF_CHECK_TRUE(alfGetArrayListSize(list) == 3);
+  ALF_CHECK_MEM_EQ(alfArrayListGetData(list), even, sizeof(even));
+
+  // Insert one object at the end, which used to add it twice
+  alfArrayListInsert(list, objects + 1, 3);
+  ALF_CHECK_TRUE(alfGetArrayListSize(list) == 4);
+  alfDestroyArrayList(list);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Range", "[List]")
+{
+  // Insert ranges of pointers into a list and remove them again
+  AlfList* list = alfCreateListSimple();
+  uint32_t values[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  void* objects[8];
+  for (uint32_t i = 0; i < 8; i++) {
+    objects[i] = &values[i];
+  }
+  alfListAddRange(list, objects + 4, 4);
+  alfListInsertRange(list, objects, 4, 0);
+  ALF_CHECK_TRUE(alfGetListSize(list) == 8);
+  ALF_CHECK_MEM_EQ(alfGetListData(list), objects, sizeof(objects));
+
+  void* removed[2];
+  alfListRemoveRange(list, 1, 2, removed);
+  ALF_CHECK_TRUE(removed[0] == objects[1] && removed[1] == objects[2]);
+  ALF_CHECK_TRUE(alfListRemoveIf(list, IsOddUint32, NULL) == 3);
+  ALF_CHECK_TRUE(alfGetListSize(list) == 3);
+  ALF_CHECK_TRUE(alfListGet(list, 0) == objects[0]);
+  ALF_CHECK_TRUE(alfListGet(list, 1) == objects[4]);
+  ALF_CHECK_TRUE(alfListGet(list, 2) == objects[6]);
+
+  alfListInsert(list, objects[7], 3);
+  ALF_CHECK_TRUE(alfGetListSize(list) == 4);
+  alfDestroyList(list);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Concurrent", "[Hash Table]")
+{
+  // Create table
+  AlfHashTableDesc desc = { 0 };
+  desc.valueSize = sizeof(uint32_t);
+  desc.hashFunction = HashString;
+  desc.keyEqual = EqualString;
+  desc.keyCopy = CopyStringKey;
+  desc.keyDestructor = free;
+  AlfConcurrentHashTable* table = alfCreateConcurrentHashTable(&desc, 0);
+  ALF_CHECK_NOT_NULL(table);
+
+  // Insert and remove from multiple threads at the same time
+  for (uint32_t i = 0; i < CONCURRENT_THREAD_COUNT * CONCURRENT_KEY_COUNT; i++) {
+    sprintf(concurrentKeys[i], "key%u", i);
+  }
+  ConcurrentArgument arguments[CONCURRENT_THREAD_COUNT];
+  AlfThread* threads[CONCURRENT_THREAD_COUNT];
+  for (uint32_t i = 0; i < CONCURRENT_THREAD_COUNT; i++) {
+    arguments[i].table = table;
+    arguments[i].thread = i;
+    threads[i] = alfCreateThread(ConcurrentInsertRemove, &arguments[i]);
+  }
+  uint32_t failures = 0;
+  for (uint32_t i = 0; i < CONCURRENT_THREAD_COUNT; i++) {
+    failures += alfJoinThread(threads[i]);
+  }
+  ALF_CHECK_TRUE(failures == 0);
+
+  // Check that odd keys remain with their values
+  ALF_CHECK_TRUE(alfConcurrentHashTableGetSize(table) ==
+                 CONCURRENT_THREAD_COUNT * CONCURRENT_KEY_COUNT / 2);
+  AlfBool found = ALF_TRUE;
+  for (uint32_t i = 0; i < CONCURRENT_THREAD_COUNT * CONCURRENT_KEY_COUNT; i++) {
+    uint32_t value = 0;
+    const AlfBool hasKey =
+      alfConcurrentHashTableGet(table, concurrentKeys[i], &value);
+    found = found && hasKey == (i % 2 != 0) && (!hasKey || value == i);
+  }
+  ALF_CHECK_TRUE(found, "Odd keys must remain after concurrent removal");
+
+  // Destroy table
+  alfDestroyConcurrentHashTable(table);
+}
+
+// -------------------------------------------------------------------------- //
+
+ALF_TEST("Concurrent Get", "[Hash Table]")
+{
+  // Create a table and a concurrent table with a single shard, so that all
+  // threads lookup in the same shard under its read lock
+  AlfHashTableDesc desc = { 0 };
+  desc.bucketCount = 16;
+  desc.valueSize = sizeof(uint32_t);
+  desc.keySize = sizeof(uint32_t);
+  ConcurrentGetArgument argument;
+  argument.table = alfCreateHashTable(&desc);
+  argument.concurrentTable = alfCreateConcurrentHashTable(&desc, 1);
+  for (uint32_t i = 0; i < CONCURRENT_KEY_COUNT; i++) {
+    alfHashTableInsert(argument.table, &i, &i);
+    alfConcurrentHashTableInsert(argument.concurrentTable, &i, &i);
+  }
+  alfHashTableResetStatistics(argument.table);
+
+  // Lookup from multiple threads at the same time
+  AlfThread* threads[CONCURRENT_THREAD_COUNT];
+  for (uint32_t i = 0; i < CONCURRENT_THREAD_COUNT; i++) {
+    threads[i] = alfCreateThread(ConcurrentGet, &argument);
+  }
+  uint32_t failures = 0;
+  for (uint32_t i = 0; i < CONCURRENT_THREAD_COUNT; i++) {
+    failures += alfJoinThread(threads[i]);
+  }
+  ALF_CHECK_TRUE(failures == 0);
+
+  // When statistics are compiled in, no recorded lookup may be lost
+  AlfHashTableStatistics statistics;
+  const AlfBool gathered =
+    alfHashTableGetStatistics(argument.table, &statistics);
+  uint64_t hits = 0;
+  for (uint32_t i = 0; i < ALF_HASH_TABLE_STATISTICS_PROBE_LENGTHS; i++) {
+    hits += statistics.hitProbeLengths[i];
+  }
+  ALF_CHECK_TRUE(hits == (gathered ? (uint64_t)CONCURRENT_THREAD_COUNT *
+                                       CONCURRENT_GET_COUNT
+                                   : 0));
+
+  // Destroy tables
+  alfDestroyConcurrentHashTable(argument.concurrentTable);
+  alfDestroyHashTable(argument.table);
+}